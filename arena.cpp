@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------
+// arena.cpp
+// Simple class arena
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// arena class:  memory handed out from large blocks, freed all at once
+//
+// Assumptions:
+//   -- objects made with make are trivially destructible
+//   -- an arena is used by one thread at a time
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include "arena.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class arena
+Arena::Arena(size_t size)
+    : blockSize(size), current(0), at(NULL), end(NULL), used(0) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class arena
+Arena::~Arena() {
+    release();
+} // end of Destructor
+
+//------------------------------ allocate -----------------------------------
+// allocate
+// the given number of bytes, aligned to the given power of two
+void* Arena::allocate(size_t bytes, size_t align) {
+    uintptr_t p = ((uintptr_t)at + align - 1) & ~(uintptr_t)(align - 1);
+    if (at == NULL || p + bytes > (uintptr_t)end) {
+        nextBlock(bytes + align);
+        p = ((uintptr_t)at + align - 1) & ~(uintptr_t)(align - 1);
+    }
+    at = (char*)(p + bytes);
+    return (void*)p;
+} // end of allocate
+
+//------------------------------- reset -------------------------------------
+// reset
+// frees everything allocated, keeping the blocks for reuse
+void Arena::reset() {
+    current = 0;
+    used = 0;
+    if (blocks.empty()) {
+        at = end = NULL;
+    }
+    else {
+        at = blocks[0].data;
+        end = at + blocks[0].size;
+    }
+} // end of reset
+
+//------------------------------ release ------------------------------------
+// release
+// frees everything allocated and gives back the blocks
+void Arena::release() {
+    for (size_t k = 0; k < blocks.size(); k++) {
+        delete[] blocks[k].data;
+    }
+    blocks.clear();
+    reset();
+} // end of release
+
+//----------------------------- nextBlock -----------------------------------
+// nextBlock
+// moves to a block with room for the given bytes, making one if needed
+// a block kept from before a reset is used if it is big enough; a
+// request larger than a block gets a block of its own
+void Arena::nextBlock(size_t bytes) {
+    size_t next = at == NULL ? current : current + 1;
+    if (at != NULL) used += blocks[current].size;
+    if (next >= blocks.size() || blocks[next].size < bytes) {
+        Block block;
+        block.size = max(blockSize, bytes);
+        block.data = new char[block.size];
+        blocks.insert(blocks.begin() + min(next, blocks.size()), block);
+    }
+    current = next;
+    at = blocks[current].data;
+    end = at + blocks[current].size;
+} // end of nextBlock
+
+//------------------------------ accessors ----------------------------------
+size_t Arena::getUsed() const {
+    return at == NULL ? 0 : used + (at - blocks[current].data);
+}
+
+size_t Arena::getCapacity() const {
+    size_t total = 0;
+    for (size_t k = 0; k < blocks.size(); k++) total += blocks[k].size;
+    return total;
+}
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------
+// arena.h
+// Simple class arena
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// arena class:  memory handed out from large blocks, freed all at once
+//
+// allocate moves a pointer through the current block and takes the next
+// block when it is full, so an allocation is a few instructions and never
+// a call to malloc once the blocks exist.  Nothing is freed on its own:
+// reset makes every block free again in O(1), keeping them for the next
+// allocations, and release gives the blocks back.  Objects made in an
+// arena are never destroyed, so they must not own memory of their own.
+//
+// Assumptions:
+//   -- objects made with make are trivially destructible
+//   -- an arena is used by one thread at a time
+//---------------------------------------------------------------------------
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <new>
+#include <vector>
+using namespace std;
+
+
+class Arena {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class arena
+// the size in bytes of each block
+    explicit Arena(size_t = 64 << 10);
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class arena
+// gives back every block
+    ~Arena();
+
+//------------------------------ allocate -----------------------------------
+// allocate
+// the given number of bytes, aligned to the given power of two
+    void* allocate(size_t, size_t = sizeof(void*));
+
+//-------------------------------- make -------------------------------------
+// make
+// a value-initialized object of type T in the arena
+    template <class T>
+    T* make() {
+        return new (allocate(sizeof(T), alignof(T))) T();
+    }
+
+//------------------------------- reset -------------------------------------
+// reset
+// frees everything allocated, keeping the blocks for reuse
+    void reset();
+
+//------------------------------ release ------------------------------------
+// release
+// frees everything allocated and gives back the blocks
+    void release();
+
+//------------------------------ accessors ----------------------------------
+// getUsed:     the bytes allocated since the last reset, with padding
+// getCapacity: the bytes of all the blocks held
+    size_t getUsed() const;
+    size_t getCapacity() const;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    size_t blockSize;                  // the size of a normal block
+    vector<Block> blocks;              // every block held
+    size_t current;                    // the block being allocated from
+    char* at;                          // the next free byte in it
+    char* end;                         // the end of it
+    size_t used;                       // bytes in the blocks before current
+
+//----------------------------- nextBlock -----------------------------------
+// nextBlock
+// moves to a block with room for the given bytes, making one if needed
+    void nextBlock(size_t);
+
+    // not copyable, it owns the blocks
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+};
+#endif
@@ -0,0 +1,457 @@
+//---------------------------------------------------------------------------
+// graphbench.cpp
+// Benchmarks of graphl and graphm
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Google Benchmark suite for the functions of GraphL and GraphM:
+//   GraphL: buildGraph, displayGraph, depthFirstSearch, makeEmpty
+//   GraphM: buildGraph, findShortestPath, display, displayAll
+// each run on R-MAT, grid and Erdos-Renyi graphs made by GraphGen with a
+// fixed seed, so every run measures the same inputs.  GraphL is run on
+// 25 to 16384 nodes and GraphM on 25 to 100, the most it can hold, with
+// about 8 and 4 edges per node.  The display functions write to a stream that
+// throws the output away, so the time is that of formatting it.
+//
+// The GraphCSR benchmarks run BreadthFirst (one thread), DepthFirst and
+// Dijkstra on larger graphs, first in the numbers GraphGen gives and then
+// in each order of Reorder, from the same node, the one with the most
+// edges out.  Each run reports the avg_gap of its numbering and, where
+// the kernel lets a process count them, the cache_misses of one
+// iteration, so one order can be put next to another.  The graphs and
+// their orders are made the first time they are asked for, outside the
+// timing; BM_Reorder_findOrder times the orders themselves.
+//
+// The results are printed as JSON; any --benchmark_format or
+// --benchmark_out given on the command line is used instead, e.g.
+//   graphbench --benchmark_out=results.json --benchmark_out_format=json
+// The graphbench target of CMakeLists.txt builds it when Google Benchmark
+// is installed:
+//   cmake -S . -B build -DNODEDATA_DIR=<dir of nodedata.h>
+//   cmake --build build --target graphbench
+//---------------------------------------------------------------------------
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "breadthfirst.h"
+#include "depthfirst.h"
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "graphl.h"
+#include "graphm.h"
+#include "reorder.h"
+
+namespace {
+
+enum Kind { RMAT, GRID, ERDOS_RENYI };
+
+const unsigned long long SEED = 1;       // seed of every generated graph
+
+// a stream buffer that takes any output and keeps none of it
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+// sends cout to a NullBuffer while it exists
+class NullOutput {
+public:
+    NullOutput() : saved(cout.rdbuf(&buffer)) {}
+    ~NullOutput() { cout.rdbuf(saved); }
+private:
+    NullBuffer buffer;
+    streambuf* saved;
+};
+
+// counts the cache misses of this thread between start and stop, by a
+// hardware counter of the kernel; isOpen is false where there is none
+class CacheMisses {
+public:
+    CacheMisses() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~CacheMisses() {
+#ifdef __linux__
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+    bool isOpen() const { return fd >= 0; }
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    void stop() {
+#ifdef __linux__
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+    }
+    long long count() const {
+        long long n = 0;
+#ifdef __linux__
+        if (fd >= 0 && read(fd, &n, sizeof(n)) != sizeof(n)) n = 0;
+#endif
+        return n;
+    }
+private:
+    int fd;                            // the counter, -1 if none
+};
+
+//------------------------------ dataFile -----------------------------------
+// dataFile
+// the text of a generated data file, made the first time it is asked for
+// a grid has the largest square number of nodes not above the given one
+const string& dataFile(Kind kind, int nodes, int perNode, bool weighted) {
+    static map<vector<int>, string> files;
+    vector<int> key = { kind, nodes, perNode, weighted };
+    map<vector<int>, string>::iterator found = files.find(key);
+    if (found != files.end()) return found->second;
+
+    GraphGen gen(SEED);
+    if (kind == RMAT) {
+        gen.rmat(nodes, (long long)nodes * perNode);
+    }
+    else if (kind == GRID) {
+        int side = 1;
+        while ((side + 1) * (side + 1) <= nodes) side++;
+        gen.grid(side, side);
+    }
+    else {
+        gen.erdosRenyi(nodes, (long long)nodes * perNode);
+    }
+    ostringstream out;
+    gen.write(out, weighted);
+    return files[key] = out.str();
+}
+
+//------------------------------ describe -----------------------------------
+// describe
+// labels the run with the kind of graph and counts nodes and edges
+void describe(benchmark::State& state, const string& text) {
+    static const char* names[] = { "rmat", "grid", "erdos-renyi" };
+    state.SetLabel(names[state.range(0)]);
+    istringstream in(text);
+    int nodes = 0;
+    in >> nodes;
+    long long edges = 0;
+    for (size_t i = 0; i < text.size(); i++) edges += text[i] == '\n';
+    state.counters["nodes"] = nodes;
+    state.counters["edges"] = (double)(edges - nodes - 2);
+}
+
+const string& listFile(const benchmark::State& state) {
+    return dataFile((Kind)state.range(0), (int)state.range(1), 8, false);
+}
+
+const string& matrixFile(const benchmark::State& state) {
+    return dataFile((Kind)state.range(0), (int)state.range(1), 4, true);
+}
+
+//------------------------------- GraphL ------------------------------------
+
+void BM_GraphL_buildGraph(benchmark::State& state) {
+    const string& text = listFile(state);
+    istringstream in(text);
+    GraphL graph;
+    for (auto _ : state) {
+        in.clear();
+        in.seekg(0);
+        graph.buildGraph(in);
+    }
+    describe(state, text);
+    state.SetBytesProcessed(state.iterations() * (long long)text.size());
+}
+
+void BM_GraphL_displayGraph(benchmark::State& state) {
+    istringstream in(listFile(state));
+    GraphL graph;
+    graph.buildGraph(in);
+    NullOutput quiet;
+    for (auto _ : state) {
+        graph.displayGraph();
+    }
+    describe(state, listFile(state));
+}
+
+void BM_GraphL_depthFirstSearch(benchmark::State& state) {
+    istringstream in(listFile(state));
+    GraphL graph;
+    graph.buildGraph(in);
+    NullOutput quiet;
+    for (auto _ : state) {
+        graph.depthFirstSearch();
+    }
+    describe(state, listFile(state));
+}
+
+void BM_GraphL_makeEmpty(benchmark::State& state) {
+    istringstream in(listFile(state));
+    GraphL graph;
+    for (auto _ : state) {
+        state.PauseTiming();
+        in.clear();
+        in.seekg(0);
+        graph.buildGraph(in);
+        state.ResumeTiming();
+        graph.makeEmpty();
+    }
+    describe(state, listFile(state));
+}
+
+//------------------------------- GraphM ------------------------------------
+
+void BM_GraphM_buildGraph(benchmark::State& state) {
+    const string& text = matrixFile(state);
+    istringstream in(text);
+    unique_ptr<GraphM> graph(new GraphM);
+    for (auto _ : state) {
+        in.clear();
+        in.seekg(0);
+        graph->buildGraph(in);
+    }
+    describe(state, text);
+    state.SetBytesProcessed(state.iterations() * (long long)text.size());
+}
+
+void BM_GraphM_findShortestPath(benchmark::State& state) {
+    istringstream in(matrixFile(state));
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    for (auto _ : state) {
+        graph->findShortestPath();
+    }
+    describe(state, matrixFile(state));
+}
+
+void BM_GraphM_display(benchmark::State& state) {
+    istringstream in(matrixFile(state));
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    graph->findShortestPath();
+    int nodes = (int)state.range(1);
+    NullOutput quiet;
+    for (auto _ : state) {
+        // every pair of nodes, as the labs display a few of them
+        for (int i = 1; i <= nodes; i++) {
+            for (int j = 1; j <= nodes; j++) graph->display(i, j);
+        }
+    }
+    describe(state, matrixFile(state));
+}
+
+void BM_GraphM_displayAll(benchmark::State& state) {
+    istringstream in(matrixFile(state));
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    graph->findShortestPath();
+    NullOutput quiet;
+    for (auto _ : state) {
+        graph->displayAll();
+    }
+    describe(state, matrixFile(state));
+}
+
+//------------------------------ GraphCSR -----------------------------------
+
+// a generated graph in one order, with the node to search from
+struct Ordered {
+    GraphCSR graph;
+    int source;
+    double gap;
+};
+
+//----------------------------- orderedGraph --------------------------------
+// orderedGraph
+// the weighted graph of the given kind and number of nodes, numbered by
+// the given Reorder method, made the first time it is asked for; the
+// source is the old node with the most edges out, in the new numbers
+const Ordered& orderedGraph(Kind kind, int nodes, Reorder::Method method) {
+    static map<vector<int>, unique_ptr<GraphCSR> > plain;
+    static map<vector<int>, unique_ptr<Ordered> > graphs;
+    vector<int> key = { kind, nodes, method };
+    map<vector<int>, unique_ptr<Ordered> >::iterator found = graphs.find(key);
+    if (found != graphs.end()) return *found->second;
+
+    unique_ptr<GraphCSR>& original = plain[{ kind, nodes }];
+    if (!original) {
+        GraphGen gen(SEED);
+        if (kind == RMAT) {
+            gen.rmat(nodes, (long long)nodes * 8);
+        }
+        else if (kind == GRID) {
+            int side = 1;
+            while ((side + 1) * (side + 1) <= nodes) side++;
+            gen.grid(side, side);
+        }
+        else {
+            gen.erdosRenyi(nodes, (long long)nodes * 8);
+        }
+        original.reset(new GraphCSR);
+        original->assign(gen.getSize(), gen.getFrom(), gen.getTo(),
+                         gen.getWeight());
+    }
+    int source = 1;
+    for (int v = 2; v <= original->getSize(); v++) {
+        if (original->degree(v) > original->degree(source)) source = v;
+    }
+
+    Reorder reorder(*original);
+    reorder.findOrder(method);
+    unique_ptr<Ordered>& ordered = graphs[key];
+    ordered.reset(new Ordered);
+    reorder.apply(ordered->graph);
+    ordered->source = reorder.toNew(source);
+    ordered->gap = Reorder::averageGap(ordered->graph);
+    return *ordered;
+}
+
+const Ordered& orderedGraph(const benchmark::State& state) {
+    return orderedGraph((Kind)state.range(0), (int)state.range(1),
+                        (Reorder::Method)state.range(2));
+}
+
+//---------------------------- describeOrder --------------------------------
+// describeOrder
+// labels the run with the kind of graph and the order, counts nodes and
+// edges, and gives the gap and the cache misses of one iteration
+void describeOrder(benchmark::State& state, const Ordered& ordered,
+                   const CacheMisses& misses) {
+    static const char* kinds[] = { "rmat", "grid", "erdos-renyi" };
+    static const char* methods[] = { "original", "degree", "rcm", "gorder" };
+    state.SetLabel(string(kinds[state.range(0)]) + "/" +
+                   methods[state.range(2)]);
+    state.counters["nodes"] = ordered.graph.getSize();
+    state.counters["edges"] = (double)ordered.graph.getEdgeCount();
+    state.counters["avg_gap"] = ordered.gap;
+    if (misses.isOpen()) {
+        state.counters["cache_misses"] = benchmark::Counter(
+            (double)misses.count(), benchmark::Counter::kAvgIterations);
+    }
+}
+
+void BM_GraphCSR_breadthFirst(benchmark::State& state) {
+    const Ordered& ordered = orderedGraph(state);
+    BreadthFirst search(ordered.graph, 1);
+    CacheMisses misses;
+    for (auto _ : state) {
+        misses.start();
+        search.search(ordered.source);
+        misses.stop();
+    }
+    describeOrder(state, ordered, misses);
+}
+
+void BM_GraphCSR_depthFirst(benchmark::State& state) {
+    const Ordered& ordered = orderedGraph(state);
+    DepthFirst search(ordered.graph);
+    CacheMisses misses;
+    for (auto _ : state) {
+        misses.start();
+        benchmark::DoNotOptimize(search.preorder().data());
+        misses.stop();
+    }
+    describeOrder(state, ordered, misses);
+}
+
+void BM_GraphCSR_dijkstra(benchmark::State& state) {
+    const Ordered& ordered = orderedGraph(state);
+    Dijkstra search(ordered.graph);
+    vector<TableType> row(ordered.graph.getSize() + 1);
+    CacheMisses misses;
+    for (auto _ : state) {
+        misses.start();
+        search.findShortestPath(ordered.source, row.data());
+        misses.stop();
+    }
+    describeOrder(state, ordered, misses);
+}
+
+void BM_Reorder_findOrder(benchmark::State& state) {
+    const Ordered& original = orderedGraph((Kind)state.range(0),
+                                           (int)state.range(1),
+                                           Reorder::ORIGINAL);
+    Reorder reorder(original.graph);
+    CacheMisses misses;
+    for (auto _ : state) {
+        misses.start();
+        reorder.findOrder((Reorder::Method)state.range(2));
+        misses.stop();
+    }
+    describeOrder(state, orderedGraph(state), misses);
+}
+
+// the kinds of graph by the numbers of nodes
+void listSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "kind", "nodes" });
+    b->ArgsProduct({ { RMAT, GRID, ERDOS_RENYI },
+                     { 25, 100, 1000, 1 << 14 } });
+    b->Unit(benchmark::kMicrosecond);
+}
+
+void matrixSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "kind", "nodes" });
+    b->ArgsProduct({ { RMAT, GRID, ERDOS_RENYI }, { 25, 50, 100 } });
+    b->Unit(benchmark::kMicrosecond);
+}
+
+// the kinds of graph by the numbers of nodes and the orders
+void orderSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "kind", "nodes", "order" });
+    b->ArgsProduct({ { RMAT, GRID, ERDOS_RENYI }, { 1 << 12, 1 << 17 },
+                     { Reorder::ORIGINAL, Reorder::DEGREE, Reorder::RCM,
+                       Reorder::GORDER } });
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_GraphL_buildGraph)->Apply(listSizes);
+BENCHMARK(BM_GraphL_displayGraph)->Apply(listSizes);
+BENCHMARK(BM_GraphL_depthFirstSearch)->Apply(listSizes);
+BENCHMARK(BM_GraphL_makeEmpty)->Apply(listSizes);
+BENCHMARK(BM_GraphM_buildGraph)->Apply(matrixSizes);
+BENCHMARK(BM_GraphM_findShortestPath)->Apply(matrixSizes);
+BENCHMARK(BM_GraphM_display)->Apply(matrixSizes);
+BENCHMARK(BM_GraphM_displayAll)->Apply(matrixSizes);
+BENCHMARK(BM_GraphCSR_breadthFirst)->Apply(orderSizes);
+BENCHMARK(BM_GraphCSR_depthFirst)->Apply(orderSizes);
+BENCHMARK(BM_GraphCSR_dijkstra)->Apply(orderSizes);
+BENCHMARK(BM_Reorder_findOrder)->Apply(orderSizes);
+
+} // namespace
+
+//-------------------------------- main -------------------------------------
+// main
+// runs the benchmarks with JSON output unless the command line asks for
+// another format
+int main(int argc, char** argv) {
+    static char json[] = "--benchmark_format=json";
+    vector<char*> args(argv, argv + argc);
+    args.insert(args.begin() + 1, json);
+    int count = (int)args.size();
+    args.push_back(NULL);
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::AddCustomContext("generator_seed", to_string(SEED));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------
+// breadthfirst.cpp
+// Simple class breadthfirst
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// breadthfirst class:  parallel breadth-first search on a GraphCSR
+//   that switches between top-down and bottom-up steps
+//
+// Assumptions:
+//   -- the graph is not changed while the object is in use
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "breadthfirst.h"
+
+// a top-down step with a smaller frontier runs on the calling thread
+static const size_t SMALL_FRONTIER = 256;
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class breadthfirst
+// builds the graph of incoming edges used by the bottom-up steps
+BreadthFirst::BreadthFirst(CSRView g, int threads)
+    : graph(g), pool(threads), source(0), reached(0), bottomUpSteps(0),
+      level(g.getSize() + 1, -1), parent(g.getSize() + 1) {
+    int size = graph.getSize();
+    vector<int> from, to;
+    for (int v = 1; v <= size; v++) {
+        for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v); e++) {
+            from.push_back(*e);
+            to.push_back(v);
+        }
+    }
+    incoming.assign(size, from, to);
+
+    found.resize(pool.getThreadCount());
+    scouts.resize(pool.getThreadCount());
+    awake.resize(pool.getThreadCount());
+    frontierBits.resize(size / 64 + 1);
+    nextBits.resize(size / 64 + 1);
+} // end of Constructor
+
+//------------------------------ search -------------------------------------
+// search
+// finds the level and the parent of every node reached from the source
+// scout is the number of edges leaving the frontier, edgesToCheck the
+// number of edges not yet followed by a top-down step
+void BreadthFirst::search(int start) {
+    int size = graph.getSize();
+    source = start;
+    reached = 0;
+    bottomUpSteps = 0;
+    pool.parallelFor(0, size + 1, [&](int v, int) {
+        level[v] = -1;
+        parent[v].store(0, memory_order_relaxed);
+    }, 4096);
+    if (start < 1 || start > size) return;
+
+    level[start] = 0;
+    parent[start].store(start, memory_order_relaxed);
+    reached = 1;
+    queue.assign(1, start);
+    long long edgesToCheck = graph.getEdgeCount();
+    long long scout = graph.degree(start);
+    int depth = 1;
+
+    while (!queue.empty()) {
+        if (scout > edgesToCheck / ALPHA) {
+            // bottom-up until the frontier is small and shrinking
+            queueToBits();
+            int count = (int)queue.size();
+            int previous;
+            do {
+                previous = count;
+                count = bottomUp(depth++);
+                reached += count;
+                bottomUpSteps++;
+            } while (count >= previous || count > size / BETA);
+            bitsToQueue();
+            scout = 1;
+        }
+        else {
+            edgesToCheck -= scout;
+            scout = topDown(depth++);
+            reached += (int)queue.size();
+        }
+    }
+} // end of search
+
+//----------------------------- topDown -------------------------------------
+// topDown
+// one top-down step from queue to the next queue at the given level
+// a node is claimed by the thread that changes its parent from 0, and
+// each thread collects the nodes it claims in its own list
+long long BreadthFirst::topDown(int depth) {
+    int threads = pool.getThreadCount();
+    for (int t = 0; t < threads; t++) {
+        found[t].clear();
+        scouts[t] = 0;
+    }
+
+    auto expand = [&](int i, int thread) {
+        int v = queue[i];
+        for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v); e++) {
+            int w = *e;
+            int unreached = 0;
+            if (parent[w].load(memory_order_relaxed) == 0
+                && parent[w].compare_exchange_strong(unreached, v,
+                                                     memory_order_relaxed)) {
+                level[w] = depth;
+                found[thread].push_back(w);
+                scouts[thread] += graph.degree(w);
+            }
+        }
+    };
+    if (queue.size() < SMALL_FRONTIER) {
+        for (size_t i = 0; i < queue.size(); i++) expand((int)i, 0);
+    }
+    else {
+        pool.parallelFor(0, (int)queue.size(), expand, 64);
+    }
+
+    queue.clear();
+    long long scout = 0;
+    for (int t = 0; t < threads; t++) {
+        queue.insert(queue.end(), found[t].begin(), found[t].end());
+        scout += scouts[t];
+    }
+    return scout;
+} // end of topDown
+
+//----------------------------- bottomUp ------------------------------------
+// bottomUp
+// one bottom-up step from frontierBits to nextBits at the given level
+// each index of the loop is one 64-node word of the bitmap, so only one
+// thread writes each word and each parent
+int BreadthFirst::bottomUp(int depth) {
+    int size = graph.getSize();
+    int threads = pool.getThreadCount();
+    for (int t = 0; t < threads; t++) awake[t] = 0;
+
+    pool.parallelFor(0, (int)nextBits.size(), [&](int word, int thread) {
+        unsigned long long bits = 0;
+        int first = word * 64;
+        int last = min(first + 63, size);
+        for (int v = max(first, 1); v <= last; v++) {
+            if (parent[v].load(memory_order_relaxed) != 0) continue;
+            for (const int* e = incoming.edgeBegin(v);
+                 e != incoming.edgeEnd(v); e++) {
+                int u = *e;
+                if ((frontierBits[u >> 6] >> (u & 63)) & 1) {
+                    parent[v].store(u, memory_order_relaxed);
+                    level[v] = depth;
+                    bits |= 1ULL << (v - first);
+                    awake[thread]++;
+                    break;
+                }
+            }
+        }
+        nextBits[word] = bits;
+    }, 16);
+
+    frontierBits.swap(nextBits);
+    int count = 0;
+    for (int t = 0; t < threads; t++) count += awake[t];
+    return count;
+} // end of bottomUp
+
+//--------------------------- queueToBits -----------------------------------
+// queueToBits
+// sets the bit of every node in the queue
+void BreadthFirst::queueToBits() {
+    fill(frontierBits.begin(), frontierBits.end(), 0ULL);
+    for (size_t i = 0; i < queue.size(); i++) {
+        frontierBits[queue[i] >> 6] |= 1ULL << (queue[i] & 63);
+    }
+} // end of queueToBits
+
+//--------------------------- bitsToQueue -----------------------------------
+// bitsToQueue
+// lists the node of every set bit in the queue
+void BreadthFirst::bitsToQueue() {
+    queue.clear();
+    for (size_t word = 0; word < frontierBits.size(); word++) {
+        unsigned long long bits = frontierBits[word];
+        while (bits != 0) {
+            queue.push_back((int)(word * 64) + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+} // end of bitsToQueue
+
+//------------------------------ accessors ----------------------------------
+int BreadthFirst::getLevel(int v) const {
+    return level[v];
+}
+
+int BreadthFirst::getParent(int v) const {
+    return v == source ? 0 : parent[v].load(memory_order_relaxed);
+}
+
+int BreadthFirst::getReachedCount() const {
+    return reached;
+}
+
+int BreadthFirst::getBottomUpSteps() const {
+    return bottomUpSteps;
+}
@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------
+// breadthfirst.h
+// Simple class breadthfirst
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// breadthfirst class:  parallel breadth-first search on a GraphCSR
+//   that switches between top-down and bottom-up steps
+//
+// A top-down step follows the edges leaving every node of the frontier.
+// A bottom-up step looks at every node not yet reached for an incoming
+// edge from the frontier, and stops at the first one it finds; when the
+// frontier holds a large part of the graph this checks far fewer edges.
+// The search goes bottom-up once the edges leaving the frontier are more
+// than 1/ALPHA of the edges still unexplored, and back to top-down once
+// the frontier shrinks below 1/BETA of the nodes (Beamer et al.).
+// A top-down frontier is a queue of nodes; a bottom-up frontier is a
+// bitmap with one bit per node.
+//
+// Any GraphL can be searched through GraphL::buildCSR.
+//
+// Assumptions:
+//   -- the graph is not changed while the object is in use
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#ifndef BREADTHFIRST_H
+#define BREADTHFIRST_H
+#include <atomic>
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+#include "threadpool.h"
+
+
+class BreadthFirst {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class breadthfirst
+// builds the graph of incoming edges used by the bottom-up steps
+// the number of threads, 0 uses one thread per core of the machine
+// the graph (GraphCSR or GraphSnapshot) must outlive the object
+    BreadthFirst(CSRView, int = 0);
+
+//------------------------------ search -------------------------------------
+// search
+// finds the level and the parent of every node reached from the source
+    void search(int);
+
+//------------------------------ accessors ----------------------------------
+// getLevel:         the number of edges from the source, -1 if not reached
+// getParent:        the previous node on a shortest path from the source,
+//                   0 for the source and for the nodes not reached
+// getReachedCount:  the number of nodes reached, including the source
+// getBottomUpSteps: the number of bottom-up steps of the last search
+    int getLevel(int) const;
+    int getParent(int) const;
+    int getReachedCount() const;
+    int getBottomUpSteps() const;
+
+private:
+    static const int ALPHA = 15;
+    static const int BETA = 18;
+
+    CSRView graph;                     // the graph to search
+    GraphCSR incoming;                 // graph with every edge reversed
+    ThreadPool pool;
+    int source;                        // the source of the last search
+    int reached;                       // nodes reached by the last search
+    int bottomUpSteps;                 // bottom-up steps of the last search
+
+    vector<int> level;                 // level of each node, -1 not reached
+    vector<atomic<int> > parent;       // parent of each node, 0 not reached
+    vector<int> queue;                 // the top-down frontier
+    vector<vector<int> > found;        // next frontier found by each thread
+    vector<long long> scouts;          // edges leaving it, by each thread
+    vector<unsigned long long> frontierBits;  // the bottom-up frontier
+    vector<unsigned long long> nextBits;      // the next bottom-up frontier
+    vector<int> awake;                 // nodes found by each thread
+
+//----------------------------- topDown -------------------------------------
+// topDown
+// one top-down step from queue to the next queue at the given level
+// returns the number of edges leaving the next frontier
+    long long topDown(int);
+
+//----------------------------- bottomUp ------------------------------------
+// bottomUp
+// one bottom-up step from frontierBits to nextBits at the given level
+// returns the number of nodes in the next frontier
+    int bottomUp(int);
+
+//--------------------------- queueToBits -----------------------------------
+// queueToBits, bitsToQueue
+// convert the frontier between a queue and a bitmap
+    void queueToBits();
+    void bitsToQueue();
+};
+#endif
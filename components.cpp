@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------
+// components.cpp
+// Simple class components
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// components class:  strongly connected components and topological order
+//   of a GraphCSR, e.g. the adjacency lists of a GraphL from buildCSR
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph does not change while the object is used
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "components.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class components
+Components::Components(CSRView g) : graph(g), count(0) {
+} // end of Constructor
+
+//----------------------------- findStrong ----------------------------------
+// findStrong
+// Tarjan's algorithm: index[v] is the order v was reached in and low[v]
+// the smallest index reachable from v's subtree through nodes still on
+// the stack; v is the root of a component when low[v] == index[v], and
+// the nodes above it on the stack are its component
+// a node is on the stack while it has an index but no component yet
+// Tarjan finishes the components sinks first, so they are numbered from
+// count down to 1
+int Components::findStrong() {
+    int size = graph.getSize();
+    vector<int> index(size + 1, 0), low(size + 1, 0);
+    vector<int> stack;
+    vector<pair<int, const int*> > pending;
+    component.assign(size + 1, 0);
+    int reached = 0;
+    int finished = 0;
+
+    for (int root = 1; root <= size; root++) {
+        if (index[root] != 0) continue;
+        index[root] = low[root] = ++reached;
+        stack.push_back(root);
+        pending.push_back(make_pair(root, graph.edgeBegin(root)));
+
+        while (!pending.empty()) {
+            int v = pending.back().first;
+            const int*& e = pending.back().second;
+            if (e != graph.edgeEnd(v)) {
+                int w = *e++;
+                if (index[w] == 0) {
+                    index[w] = low[w] = ++reached;
+                    stack.push_back(w);
+                    pending.push_back(make_pair(w, graph.edgeBegin(w)));
+                }
+                else if (component[w] == 0) {
+                    low[v] = min(low[v], index[w]);   // w is on the stack
+                }
+                continue;
+            }
+
+            // all edges of v are done
+            pending.pop_back();
+            if (low[v] == index[v]) {
+                finished++;
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    component[w] = finished;
+                } while (w != v);
+            }
+            if (!pending.empty()) {
+                int u = pending.back().first;
+                low[u] = min(low[u], low[v]);
+            }
+        }
+    }
+
+    // number in topological order, and group the nodes by component
+    count = finished;
+    start.assign(count + 2, 0);
+    for (int v = 1; v <= size; v++) {
+        component[v] = count - component[v] + 1;
+        start[component[v] + 1]++;
+    }
+    for (int c = 1; c <= count; c++) start[c + 1] += start[c];
+    members.resize(size);
+    vector<int> next(start.begin(), start.end());
+    for (int v = 1; v <= size; v++) members[next[component[v]]++] = v;
+    return count;
+} // end of findStrong
+
+//-------------------------- topologicalOrder -------------------------------
+// topologicalOrder
+// Kahn's algorithm: count the edges into each node, then take the nodes
+// with none left, removing their edges; the order itself is the queue
+bool Components::topologicalOrder(vector<int>& order) const {
+    int size = graph.getSize();
+    vector<int> into(size + 1, 0);
+    for (int v = 1; v <= size; v++) {
+        for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v); e++) {
+            into[*e]++;
+        }
+    }
+    order.clear();
+    order.reserve(size);
+    for (int v = 1; v <= size; v++) {
+        if (into[v] == 0) order.push_back(v);
+    }
+    for (size_t k = 0; k < order.size(); k++) {
+        int v = order[k];
+        for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v); e++) {
+            if (--into[*e] == 0) order.push_back(*e);
+        }
+    }
+    return (int)order.size() == size;
+} // end of topologicalOrder
+
+//----------------------------- findCycle -----------------------------------
+// findCycle
+// a node with an edge to itself is a cycle; otherwise, in a component of
+// more than one node every node has an edge to another node of it, so
+// following such edges must come back to a node already passed
+vector<int> Components::findCycle() const {
+    int size = graph.getSize();
+    for (int v = 1; v <= size; v++) {
+        for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v); e++) {
+            if (*e == v) return vector<int>(1, v);
+        }
+    }
+    for (int c = 1; c <= count; c++) {
+        if (start[c + 1] - start[c] < 2) continue;
+        vector<int> walk;
+        vector<int> position(size + 1, -1);
+        int v = members[start[c]];
+        while (position[v] == -1) {
+            position[v] = (int)walk.size();
+            walk.push_back(v);
+            const int* e = graph.edgeBegin(v);
+            while (component[*e] != c) e++;
+            v = *e;
+        }
+        return vector<int>(walk.begin() + position[v], walk.end());
+    }
+    return vector<int>();
+} // end of findCycle
+
+//------------------------------ condense -----------------------------------
+// condense
+// the edges of each component's nodes, those to another component kept
+// once each by stamping the components already joined
+void Components::condense(GraphCSR& dag) const {
+    vector<int> from, to;
+    vector<int> joined(count + 1, 0);
+    for (int c = 1; c <= count; c++) {
+        for (int k = start[c]; k < start[c + 1]; k++) {
+            int v = members[k];
+            for (const int* e = graph.edgeBegin(v); e != graph.edgeEnd(v);
+                 e++) {
+                int d = component[*e];
+                if (d != c && joined[d] != c) {
+                    joined[d] = c;
+                    from.push_back(c);
+                    to.push_back(d);
+                }
+            }
+        }
+    }
+    dag.assign(count, from, to);
+} // end of condense
+
+//------------------------------ accessors ----------------------------------
+int Components::getCount() const {
+    return count;
+}
+
+int Components::getComponent(int v) const {
+    return component[v];
+}
+
+vector<int> Components::getNodes(int c) const {
+    return vector<int>(members.begin() + start[c],
+                       members.begin() + start[c + 1]);
+}
+
+const vector<int>& Components::getMembers() const {
+    return members;
+}
+
+int Components::getStart(int c) const {
+    return start[c];
+}
@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------
+// components.h
+// Simple class components
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// components class:  strongly connected components and topological order
+//   of a GraphCSR, e.g. the adjacency lists of a GraphL from buildCSR
+//
+// findStrong is Tarjan's algorithm with an explicit stack of (node, next
+// edge), so it takes linear time and a deep graph cannot overflow the
+// call stack.  The components are numbered 1 .. count in topological
+// order: every edge between two components goes from a smaller number
+// to a larger one, so condense gives a DAG already in order.
+// topologicalOrder is Kahn's algorithm on the nodes; on a graph with a
+// cycle it returns false, and findCycle gives the nodes of one cycle.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph does not change while the object is used
+//---------------------------------------------------------------------------
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+
+
+class Components {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class components
+// the graph, a GraphCSR or a mapped GraphSnapshot, must outlive it
+    Components(CSRView);
+
+//----------------------------- findStrong ----------------------------------
+// findStrong
+// finds the strongly connected components; returns how many there are
+    int findStrong();
+
+//-------------------------- topologicalOrder -------------------------------
+// topologicalOrder
+// the nodes in an order where every edge goes forward; the nodes with
+// no edges in come first, in order of node, then each node as soon as
+// all its edges in are done; returns false, with the nodes that could be
+// ordered, if the graph has a cycle
+    bool topologicalOrder(vector<int>&) const;
+
+//----------------------------- findCycle -----------------------------------
+// findCycle
+// the nodes of a cycle, in order along its edges, the first node not
+// repeated at the end; empty if the graph has none
+// findStrong must be run first
+    vector<int> findCycle() const;
+
+//------------------------------ condense -----------------------------------
+// condense
+// the DAG of the components: node c is component c, with one edge for
+// each pair of components joined by at least one edge
+// findStrong must be run first
+    void condense(GraphCSR&) const;
+
+//------------------------------ accessors ----------------------------------
+// getCount:     the number of components found by findStrong
+// getComponent: the component of the given node, 1 .. getCount()
+// getNodes:     the nodes of the given component, in order of node
+// getMembers:   every node, grouped by component; component c is
+//               getMembers()[getStart(c)] .. getMembers()[getStart(c+1)-1]
+// getStart:     the first entry of a component in getMembers
+    int getCount() const;
+    int getComponent(int) const;
+    vector<int> getNodes(int) const;
+    const vector<int>& getMembers() const;
+    int getStart(int) const;
+
+private:
+    CSRView graph;                     // the graph to search
+    int count;                         // the number of components
+    vector<int> component;             // component[v] is the component of v
+    vector<int> members;               // the nodes grouped by component
+    vector<int> start;                 // start[c] is c's first in members
+};
+#endif
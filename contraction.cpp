@@ -0,0 +1,637 @@
+//---------------------------------------------------------------------------
+// contraction.cpp
+// Simple class contraction
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// contraction class:  contraction hierarchies for fast point-to-point
+//   shortest path queries on a graph that does not change
+//
+// Assumptions:
+//   -- edge weights are not negative
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include "contraction.h"
+#include "threadpool.h"
+
+// a witness search gives up after settling this many nodes, which can
+// only add a shortcut that was not needed, never lose a path; the
+// searches that only estimate the priority of a node stop much earlier
+static const int WITNESS_LIMIT = 500;
+static const int ESTIMATE_LIMIT = 50;
+
+// first bytes and version of the form written by save
+static const char CH_MAGIC[4] = { 'G', 'R', 'C', 'H' };
+static const int CH_VERSION = 1;
+
+//---------------------------------------------------------------------------
+// The graph while it is being contracted, and the work on it.
+
+// an edge between two nodes not yet contracted
+struct RemainingEdge {
+    int node;
+    int weight;
+    int middle;
+};
+
+// a shortcut found when contracting a node
+struct Shortcut {
+    int from;
+    int to;
+    int weight;
+    int middle;
+};
+
+// the scratch of one thread for witness searches
+struct WitnessSearch {
+    vector<unsigned> stamp;               // epoch that reached the node
+    vector<unsigned> target;              // epoch that needs the node
+    vector<int> dist;
+    unsigned epoch = 0;
+    vector<pair<long long, int> > heap;
+};
+
+struct Contraction {
+    vector<vector<RemainingEdge> > out;   // edges leaving each node
+    vector<vector<RemainingEdge> > in;    // edges entering each node
+    vector<int> deleted;                  // neighbors already contracted
+    vector<char> excluded;                // contracted in this round
+    vector<int> priority;                 // the edge difference
+};
+
+// the order of two nodes of equal priority, spread out by a hash so
+// that the nodes of one round are not bunched together
+static bool lessImportant(const Contraction& c, int v, int x) {
+    if (c.priority[v] != c.priority[x]) return c.priority[v] < c.priority[x];
+    unsigned hv = (unsigned)v * 2654435761u, hx = (unsigned)x * 2654435761u;
+    return hv != hx ? hv < hx : v < x;
+}
+
+// the shortcuts needed to contract v, appended to found if not NULL
+// for each u -> v, a Dijkstra from u avoiding v (and the other nodes of
+// the round) up to the longest u -> v -> w; w needs a shortcut if it
+// was not reached at least as short as through v
+static int simulate(const Contraction& c, int v, WitnessSearch& ws,
+                    vector<Shortcut>* found, int settleLimit) {
+    int count = 0;
+    int longestOut = 0;
+    for (size_t b = 0; b < c.out[v].size(); b++) {
+        longestOut = max(longestOut, c.out[v][b].weight);
+    }
+    greater<pair<long long, int> > later;
+
+    for (size_t a = 0; a < c.in[v].size(); a++) {
+        int u = c.in[v][a].node;
+        long long limit = (long long)c.in[v][a].weight + longestOut;
+
+        if (++ws.epoch == 0) {
+            fill(ws.stamp.begin(), ws.stamp.end(), 0);
+            fill(ws.target.begin(), ws.target.end(), 0);
+            ws.epoch = 1;
+        }
+        ws.heap.clear();
+        ws.stamp[u] = ws.epoch;
+        ws.dist[u] = 0;
+        ws.heap.push_back(make_pair(0LL, u));
+        int settled = 0;
+
+        // the search can stop once every w of u -> v -> w is settled
+        int targets = 0;
+        for (size_t b = 0; b < c.out[v].size(); b++) {
+            int w = c.out[v][b].node;
+            if (w != u && ws.target[w] != ws.epoch) {
+                ws.target[w] = ws.epoch;
+                targets++;
+            }
+        }
+
+        while (!ws.heap.empty()) {
+            pop_heap(ws.heap.begin(), ws.heap.end(), later);
+            long long d = ws.heap.back().first;
+            int x = ws.heap.back().second;
+            ws.heap.pop_back();
+            if (d > ws.dist[x]) continue;
+            if (d > limit || ++settled > settleLimit) break;
+            if (ws.target[x] == ws.epoch && --targets == 0) break;
+
+            for (size_t e = 0; e < c.out[x].size(); e++) {
+                int y = c.out[x][e].node;
+                if (y == v || c.excluded[y]) continue;
+                long long nd = d + c.out[x][e].weight;
+                if (nd > limit) continue;
+                if (ws.stamp[y] != ws.epoch || nd < ws.dist[y]) {
+                    ws.stamp[y] = ws.epoch;
+                    ws.dist[y] = (int)nd;
+                    ws.heap.push_back(make_pair(nd, y));
+                    push_heap(ws.heap.begin(), ws.heap.end(), later);
+                }
+            }
+        }
+
+        for (size_t b = 0; b < c.out[v].size(); b++) {
+            int w = c.out[v][b].node;
+            if (w == u) continue;
+            long long via = (long long)c.in[v][a].weight + c.out[v][b].weight;
+            if (ws.stamp[w] == ws.epoch && ws.dist[w] <= via) continue;
+            count++;
+            if (found != NULL) {
+                Shortcut s = { u, w, (int)via, v };
+                found->push_back(s);
+            }
+        }
+    }
+    return count;
+}
+
+// the edge difference of v, with the shortcuts counted twice so that
+// nodes that add shortcuts are put off longer, plus its neighbors
+// already contracted so that the contraction spreads evenly
+static int priorityOf(const Contraction& c, int v, WitnessSearch& ws) {
+    return 2 * simulate(c, v, ws, NULL, ESTIMATE_LIMIT) - (int)c.in[v].size()
+        - (int)c.out[v].size() + c.deleted[v];
+}
+
+// drops the edges to or from the given node out of a list
+static void dropNode(vector<RemainingEdge>& list, int node) {
+    size_t k = 0;
+    for (size_t e = 0; e < list.size(); e++) {
+        if (list[e].node != node) list[k++] = list[e];
+    }
+    list.resize(k);
+}
+
+// adds edge u -> w, or shortens it if it is already there
+// returns true only if a new edge was added
+static bool addEdge(Contraction& c, int u, int w, int weight, int middle) {
+    for (size_t e = 0; e < c.out[u].size(); e++) {
+        if (c.out[u][e].node != w) continue;
+        if (c.out[u][e].weight <= weight) return false;
+        c.out[u][e].weight = weight;
+        c.out[u][e].middle = middle;
+        for (size_t f = 0; f < c.in[w].size(); f++) {
+            if (c.in[w][f].node == u) {
+                c.in[w][f].weight = weight;
+                c.in[w][f].middle = middle;
+            }
+        }
+        return false;
+    }
+    RemainingEdge forward = { w, weight, middle };
+    RemainingEdge backward = { u, weight, middle };
+    c.out[u].push_back(forward);
+    c.in[w].push_back(backward);
+    return true;
+}
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class contraction
+ContractionHierarchy::ContractionHierarchy()
+    : size(0), shortcuts(0), query(0), lastDist(INT_MAX), settledCount(0) {
+} // end of Constructor
+
+//------------------------------- build -------------------------------------
+// build
+// contracts every node of the given graph by using the given number of
+// threads (0 uses one thread per core)
+void ContractionHierarchy::build(const GraphCSR& graph, int threads) {
+    size = graph.getSize();
+    shortcuts = 0;
+    Contraction c;
+    c.out.resize(size + 1);
+    c.in.resize(size + 1);
+    c.deleted.assign(size + 1, 0);
+    c.excluded.assign(size + 1, 0);
+    c.priority.assign(size + 1, 0);
+
+    // copy the edges, keeping the lightest of parallel edges
+    for (int v = 1; v <= size; v++) {
+        const int* cost = graph.weightBegin(v);
+        for (int e = 0; e < graph.degree(v); e++) {
+            int w = graph.edgeBegin(v)[e];
+            if (w != v) addEdge(c, v, w, cost ? cost[e] : 1, 0);
+        }
+    }
+
+    ThreadPool pool(threads);
+    vector<WitnessSearch> scratch(pool.getThreadCount());
+    for (size_t t = 0; t < scratch.size(); t++) {
+        scratch[t].stamp.assign(size + 1, 0);
+        scratch[t].target.assign(size + 1, 0);
+        scratch[t].dist.assign(size + 1, 0);
+    }
+
+    vector<int> alive;
+    for (int v = 1; v <= size; v++) alive.push_back(v);
+    pool.parallelFor(0, (int)alive.size(), [&](int i, int t) {
+        c.priority[alive[i]] = priorityOf(c, alive[i], scratch[t]);
+    }, 64);
+
+    rank.assign(size + 1, 0);
+    vector<vector<Arc> > up(size + 1), down(size + 1);
+    int nextRank = 1;
+    vector<char> chosen;
+    vector<int> touched;
+
+    while (!alive.empty()) {
+
+        // the nodes less important than all of their neighbors
+        chosen.assign(alive.size(), 0);
+        pool.parallelFor(0, (int)alive.size(), [&](int i, int) {
+            int v = alive[i];
+            for (size_t e = 0; e < c.out[v].size(); e++) {
+                if (!lessImportant(c, v, c.out[v][e].node)) return;
+            }
+            for (size_t e = 0; e < c.in[v].size(); e++) {
+                if (!lessImportant(c, v, c.in[v][e].node)) return;
+            }
+            chosen[i] = 1;
+        }, 256);
+        vector<int> round;
+        for (size_t i = 0; i < alive.size(); i++) {
+            if (chosen[i]) {
+                round.push_back(alive[i]);
+                c.excluded[alive[i]] = 1;
+            }
+        }
+
+        // find their shortcuts at the same time; no two are neighbors
+        // and the witness searches avoid all of them
+        vector<vector<Shortcut> > found(round.size());
+        pool.parallelFor(0, (int)round.size(), [&](int i, int t) {
+            simulate(c, round[i], scratch[t], &found[i], WITNESS_LIMIT);
+        }, 16);
+
+        // remove them, keeping their edges as the arcs of the hierarchy
+        touched.clear();
+        for (size_t i = 0; i < round.size(); i++) {
+            int v = round[i];
+            rank[v] = nextRank++;
+            for (size_t e = 0; e < c.out[v].size(); e++) {
+                const RemainingEdge& edge = c.out[v][e];
+                Arc arc = { edge.node, edge.weight, edge.middle };
+                up[v].push_back(arc);
+                dropNode(c.in[edge.node], v);
+                c.deleted[edge.node]++;
+                touched.push_back(edge.node);
+            }
+            for (size_t e = 0; e < c.in[v].size(); e++) {
+                const RemainingEdge& edge = c.in[v][e];
+                Arc arc = { edge.node, edge.weight, edge.middle };
+                down[v].push_back(arc);
+                dropNode(c.out[edge.node], v);
+                c.deleted[edge.node]++;
+                touched.push_back(edge.node);
+            }
+            vector<RemainingEdge>().swap(c.out[v]);
+            vector<RemainingEdge>().swap(c.in[v]);
+        }
+        for (size_t i = 0; i < found.size(); i++) {
+            for (size_t s = 0; s < found[i].size(); s++) {
+                const Shortcut& cut = found[i][s];
+                if (addEdge(c, cut.from, cut.to, cut.weight, cut.middle)) {
+                    shortcuts++;
+                }
+            }
+        }
+        for (size_t i = 0; i < round.size(); i++) {
+            c.excluded[round[i]] = 0;
+        }
+
+        // the neighbors may now need other shortcuts
+        sort(touched.begin(), touched.end());
+        touched.erase(unique(touched.begin(), touched.end()), touched.end());
+        pool.parallelFor(0, (int)touched.size(), [&](int i, int t) {
+            c.priority[touched[i]] = priorityOf(c, touched[i], scratch[t]);
+        }, 16);
+
+        size_t k = 0;
+        for (size_t i = 0; i < alive.size(); i++) {
+            if (rank[alive[i]] == 0) alive[k++] = alive[i];
+        }
+        alive.resize(k);
+    }
+
+    // lay the arcs out like a GraphCSR
+    upOffsets.assign(size + 2, 0);
+    downOffsets.assign(size + 2, 0);
+    upArcs.clear();
+    downArcs.clear();
+    for (int v = 1; v <= size; v++) {
+        upOffsets[v] = upArcs.size();
+        upArcs.insert(upArcs.end(), up[v].begin(), up[v].end());
+        downOffsets[v] = downArcs.size();
+        downArcs.insert(downArcs.end(), down[v].begin(), down[v].end());
+    }
+    upOffsets[size + 1] = upArcs.size();
+    downOffsets[size + 1] = downArcs.size();
+    resetSearch();
+} // end of build
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// the nodes of the shortest path from the first node to the second
+// both sides search upward; each stops once its smallest distance is no
+// better than the best path found through a node both have reached
+vector<int> ContractionHierarchy::shortestPath(int start, int end) {
+    if (++query == 0) {
+        fill(forward.stamp.begin(), forward.stamp.end(), 0);
+        fill(backward.stamp.begin(), backward.stamp.end(), 0);
+        query = 1;
+    }
+    lastDist = INT_MAX;
+    settledCount = 0;
+    if (start < 1 || start > size || end < 1 || end > size) {
+        return vector<int>();
+    }
+
+    Side* sides[2] = { &forward, &backward };
+    int ends[2] = { start, end };
+    for (int s = 0; s < 2; s++) {
+        sides[s]->heap.clear();
+        sides[s]->stamp[ends[s]] = query;
+        sides[s]->dist[ends[s]] = 0;
+        sides[s]->parent[ends[s]] = 0;
+        sides[s]->heap.push_back(make_pair(0, ends[s]));
+    }
+
+    long long best = INT_MAX;
+    int meet = 0;
+    for (;;) {
+        long long forwardTop = forward.heap.empty()
+            ? INT_MAX : forward.heap.front().first;
+        long long backwardTop = backward.heap.empty()
+            ? INT_MAX : backward.heap.front().first;
+        if (min(forwardTop, backwardTop) >= best) break;
+
+        if (forwardTop <= backwardTop) {
+            search(forward, backward, upOffsets, upArcs,
+                   downOffsets, downArcs, best, meet);
+        }
+        else {
+            search(backward, forward, downOffsets, downArcs,
+                   upOffsets, upArcs, best, meet);
+        }
+    }
+    if (meet == 0) return vector<int>();
+    lastDist = (int)best;
+
+    // the arcs from the start up to the meeting node, in order
+    vector<int> tops;
+    for (int v = meet; v != start; v = forward.parent[v]) {
+        tops.push_back(v);
+    }
+    vector<int> path(1, start);
+    for (size_t i = tops.size(); i-- > 0; ) {
+        int v = tops[i];
+        unpack(forward.parent[v], v, forward.middle[v], path);
+    }
+
+    // and from the meeting node down to the end
+    for (int v = meet; v != end; v = backward.parent[v]) {
+        unpack(v, backward.parent[v], backward.middle[v], path);
+    }
+    return path;
+} // end of shortestPath
+
+//------------------------------- search ------------------------------------
+// search
+// settles the top node of one side, unless a shorter path reaches it
+// from above (stall-on-demand), and relaxes its arcs
+void ContractionHierarchy::search(Side& side, const Side& other,
+                                  const vector<long long>& offsets,
+                                  const vector<Arc>& arcs,
+                                  const vector<long long>& stallOffsets,
+                                  const vector<Arc>& stallArcs,
+                                  long long& best, int& meet) {
+    greater<pair<int, int> > later;
+    pop_heap(side.heap.begin(), side.heap.end(), later);
+    int d = side.heap.back().first;
+    int v = side.heap.back().second;
+    side.heap.pop_back();
+    if (d > side.dist[v]) return;          // a stale heap entry
+    settledCount++;
+
+    if (other.stamp[v] == query && (long long)d + other.dist[v] < best) {
+        best = (long long)d + other.dist[v];
+        meet = v;
+    }
+
+    // a higher node already reached with a shorter way into v
+    for (long long e = stallOffsets[v]; e < stallOffsets[v + 1]; e++) {
+        int u = stallArcs[e].node;
+        if (side.stamp[u] == query
+                && (long long)side.dist[u] + stallArcs[e].weight < d) {
+            return;
+        }
+    }
+
+    for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+        int w = arcs[e].node;
+        long long dist = (long long)d + arcs[e].weight;
+        if (dist >= INT_MAX) continue;
+        if (side.stamp[w] != query || dist < side.dist[w]) {
+            side.stamp[w] = query;
+            side.dist[w] = (int)dist;
+            side.parent[w] = v;
+            side.middle[w] = arcs[e].middle;
+            side.heap.push_back(make_pair((int)dist, w));
+            push_heap(side.heap.begin(), side.heap.end(), later);
+        }
+    }
+} // end of search
+
+//------------------------------- unpack ------------------------------------
+// unpack
+// appends the original nodes of arc from -> to (not from itself)
+// shortcut u -> w through v is the down arc u -> v stored at v followed
+// by the up arc v -> w stored at v
+void ContractionHierarchy::unpack(int from, int to, int middle,
+                                  vector<int>& path) const {
+    vector<Shortcut> pending;             // the arcs still to unpack
+    Shortcut first = { from, to, 0, middle };
+    pending.push_back(first);
+    while (!pending.empty()) {
+        Shortcut arc = pending.back();
+        pending.pop_back();
+        if (arc.middle == 0) {
+            path.push_back(arc.to);
+            continue;
+        }
+        const Arc* in = findArc(downOffsets, downArcs, arc.middle, arc.from);
+        const Arc* out = findArc(upOffsets, upArcs, arc.middle, arc.to);
+        Shortcut before = { arc.from, arc.middle, 0, in ? in->middle : 0 };
+        Shortcut after = { arc.middle, arc.to, 0, out ? out->middle : 0 };
+        pending.push_back(after);
+        pending.push_back(before);
+    }
+} // end of unpack
+
+//------------------------------ findArc ------------------------------------
+// findArc
+// the arc to the given node among the arcs of v, NULL if none
+const ContractionHierarchy::Arc* ContractionHierarchy::findArc(
+        const vector<long long>& offsets, const vector<Arc>& arcs,
+        int v, int node) const {
+    for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+        if (arcs[e].node == node) return &arcs[e];
+    }
+    return NULL;
+} // end of findArc
+
+//-------------------------------- save -------------------------------------
+// save
+// writes the hierarchy in a binary form that load reads back:
+// magic, version, size, shortcut count, ranks, then the up and the down
+// arcs, each as offsets followed by the arcs
+bool ContractionHierarchy::save(ostream& out) const {
+    long long counts[2] = { (long long)upArcs.size(),
+                            (long long)downArcs.size() };
+    out.write(CH_MAGIC, sizeof(CH_MAGIC));
+    out.write((const char*)&CH_VERSION, sizeof(CH_VERSION));
+    out.write((const char*)&size, sizeof(size));
+    out.write((const char*)&shortcuts, sizeof(shortcuts));
+    out.write((const char*)counts, sizeof(counts));
+    if (size > 0) {
+        out.write((const char*)rank.data(), sizeof(int) * (size + 1));
+        out.write((const char*)upOffsets.data(),
+                  sizeof(long long) * (size + 2));
+        out.write((const char*)upArcs.data(), sizeof(Arc) * counts[0]);
+        out.write((const char*)downOffsets.data(),
+                  sizeof(long long) * (size + 2));
+        out.write((const char*)downArcs.data(), sizeof(Arc) * counts[1]);
+    }
+    return (bool)out;
+} // end of save
+
+//-------------------------------- load -------------------------------------
+// load
+// reads a hierarchy written by save, checking that every offset and
+// every arc stays inside the graph and that the ranks and shortcuts
+// fit together (validRanks); the hierarchy is empty if it fails
+bool ContractionHierarchy::load(istream& in) {
+    char magic[4];
+    int version = 0, nodes = 0;
+    long long counts[2] = { 0, 0 };
+    size = 0;
+    in.read(magic, sizeof(magic));
+    in.read((char*)&version, sizeof(version));
+    in.read((char*)&nodes, sizeof(nodes));
+    in.read((char*)&shortcuts, sizeof(shortcuts));
+    in.read((char*)counts, sizeof(counts));
+    if (!in || memcmp(magic, CH_MAGIC, sizeof(magic)) != 0
+            || version != CH_VERSION || nodes < 0
+            || counts[0] < 0 || counts[1] < 0) {
+        return false;
+    }
+
+    if (nodes > 0) {
+        rank.resize(nodes + 1);
+        upOffsets.resize(nodes + 2);
+        upArcs.resize(counts[0]);
+        downOffsets.resize(nodes + 2);
+        downArcs.resize(counts[1]);
+        in.read((char*)rank.data(), sizeof(int) * (nodes + 1));
+        in.read((char*)upOffsets.data(), sizeof(long long) * (nodes + 2));
+        in.read((char*)upArcs.data(), sizeof(Arc) * counts[0]);
+        in.read((char*)downOffsets.data(), sizeof(long long) * (nodes + 2));
+        in.read((char*)downArcs.data(), sizeof(Arc) * counts[1]);
+        if (!in) return false;
+
+        const vector<long long>* offsets[2] = { &upOffsets, &downOffsets };
+        const vector<Arc>* arcs[2] = { &upArcs, &downArcs };
+        for (int s = 0; s < 2; s++) {
+            if ((*offsets[s])[1] != 0
+                    || (*offsets[s])[nodes + 1] != counts[s]) {
+                return false;
+            }
+            for (int v = 1; v <= nodes; v++) {
+                if ((*offsets[s])[v] > (*offsets[s])[v + 1]) return false;
+            }
+            for (size_t e = 0; e < arcs[s]->size(); e++) {
+                const Arc& arc = (*arcs[s])[e];
+                if (arc.node < 1 || arc.node > nodes || arc.middle < 0
+                        || arc.middle > nodes || arc.weight < 0) {
+                    return false;
+                }
+            }
+        }
+        if (!validRanks(nodes)) return false;
+    }
+    size = nodes;
+    resetSearch();
+    return true;
+} // end of load
+
+//----------------------------- validRanks ----------------------------------
+// validRanks
+// whether the ranks of a loaded hierarchy are 1 .. nodes, each once, every
+// arc goes up in rank, and every shortcut goes through a lower node that
+// has both of its halves; unpack then always ends
+bool ContractionHierarchy::validRanks(int nodes) const {
+    vector<char> seen(nodes + 1, 0);
+    for (int v = 1; v <= nodes; v++) {
+        if (rank[v] < 1 || rank[v] > nodes || seen[rank[v]]) return false;
+        seen[rank[v]] = 1;
+    }
+    for (int s = 0; s < 2; s++) {
+        const vector<long long>& offsets = s == 0 ? upOffsets : downOffsets;
+        const vector<Arc>& arcs = s == 0 ? upArcs : downArcs;
+        for (int v = 1; v <= nodes; v++) {
+            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                const Arc& arc = arcs[e];
+                if (rank[arc.node] <= rank[v]) return false;
+                int m = arc.middle;
+                if (m == 0) continue;
+
+                // up arc v -> node, or down arc node -> v
+                int from = s == 0 ? v : arc.node;
+                int to = s == 0 ? arc.node : v;
+                if (rank[m] >= rank[v] || rank[m] >= rank[arc.node]
+                        || findArc(downOffsets, downArcs, m, from) == NULL
+                        || findArc(upOffsets, upArcs, m, to) == NULL) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+} // end of validRanks
+
+//------------------------------ accessors ----------------------------------
+int ContractionHierarchy::getSize() const {
+    return size;
+}
+
+int ContractionHierarchy::getRank(int v) const {
+    return rank[v];
+}
+
+long long ContractionHierarchy::getShortcutCount() const {
+    return shortcuts;
+}
+
+int ContractionHierarchy::getDist() const {
+    return lastDist;
+}
+
+int ContractionHierarchy::getSettledCount() const {
+    return settledCount;
+}
+
+//------------------------------ resetSearch --------------------------------
+// resetSearch
+// sizes the search state for the current number of nodes
+void ContractionHierarchy::resetSearch() {
+    Side* sides[2] = { &forward, &backward };
+    for (int s = 0; s < 2; s++) {
+        sides[s]->stamp.assign(size + 1, 0);
+        sides[s]->dist.assign(size + 1, INT_MAX);
+        sides[s]->parent.assign(size + 1, 0);
+        sides[s]->middle.assign(size + 1, 0);
+        sides[s]->heap.clear();
+    }
+    query = 0;
+} // end of resetSearch
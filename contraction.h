@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------
+// contraction.h
+// Simple class contraction
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// contraction class:  contraction hierarchies for fast point-to-point
+//   shortest path queries on a graph that does not change
+//
+// build contracts the nodes in rounds, least important first.  Each
+// round takes every node that is less important than all its neighbors,
+// so no two of them are neighbors, and contracts them together, spread
+// over the threads.  When node v is removed, a shortcut u -> w (through
+// v) is added for each pair of neighbors whose shortest path goes through
+// v; a witness search from u that avoids the nodes of the round finds the
+// pairs that do not need one.  The importance of a node is its edge
+// difference: twice the shortcuts it needs minus the edges it removes,
+// plus its neighbors already contracted.
+//
+// The order of contraction is the rank of a node.  A query searches only
+// upward in rank, forward from the start and backward from the end, and
+// the shortcuts on the path found are unpacked into the original nodes.
+//
+// Assumptions:
+//   -- edge weights are not negative
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+#include <vector>
+#include "graphcsr.h"
+
+
+class ContractionHierarchy {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class contraction
+    ContractionHierarchy();
+
+//------------------------------- build -------------------------------------
+// build
+// contracts every node of the given graph by using the given number of
+// threads (0 uses one thread per core)
+    void build(const GraphCSR&, int = 0);
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// the nodes of the shortest path from the first node to the second,
+// both ends included, empty if there is none
+    vector<int> shortestPath(int, int);
+
+//-------------------------------- save -------------------------------------
+// save
+// writes the hierarchy in a binary form that load reads back
+// returns false if the stream fails
+    bool save(ostream&) const;
+
+//-------------------------------- load -------------------------------------
+// load
+// reads a hierarchy written by save
+// returns false, leaving the hierarchy empty, if the data is not valid
+    bool load(istream&);
+
+//------------------------------ accessors ----------------------------------
+// getSize:          the number of nodes
+// getRank:          the order in which the given node was contracted
+// getShortcutCount: the number of shortcuts build added as new edges,
+//                   not counting edges it only made shorter
+// getDist:          the distance of the last path found, INT_MAX if none
+// getSettledCount:  the number of nodes settled by the last query
+    int getSize() const;
+    int getRank(int) const;
+    long long getShortcutCount() const;
+    int getDist() const;
+    int getSettledCount() const;
+
+private:
+    // an edge to a node of higher rank; for a shortcut, middle is the
+    // node it goes through, 0 for an edge of the original graph
+    struct Arc {
+        int node;
+        int weight;
+        int middle;
+    };
+
+    // the state of one search direction, valid where stamp == query
+    struct Side {
+        vector<unsigned> stamp;          // query that reached the node
+        vector<int> dist;                // distance from the search start
+        vector<int> parent;              // previous node in the search
+        vector<int> middle;              // middle of the arc from parent
+        vector<pair<int, int> > heap;    // (dist, node), smallest first
+    };
+
+    int size;                        // the number of nodes
+    long long shortcuts;             // the number of new shortcut edges
+    vector<int> rank;                // the contraction order of each node
+
+    // up: arcs v -> w, down: arcs w -> v stored at v; rank of w > rank v
+    vector<long long> upOffsets;
+    vector<Arc> upArcs;
+    vector<long long> downOffsets;
+    vector<Arc> downArcs;
+
+    Side forward;                    // search from the first node
+    Side backward;                   // search from the second node
+    unsigned query;                  // stamp of the current query
+    int lastDist;                    // distance found by the last query
+    int settledCount;                // nodes settled by the last query
+
+//------------------------------ resetSearch --------------------------------
+// resetSearch
+// sizes the search state for the current number of nodes
+    void resetSearch();
+
+//------------------------------- search ------------------------------------
+// search
+// settles the top node of one side, unless a shorter path reaches it
+// from above (stall-on-demand), and relaxes its arcs; updates the best
+// distance and meeting node when the other side has reached a node
+    void search(Side&, const Side&, const vector<long long>&,
+                const vector<Arc>&, const vector<long long>&,
+                const vector<Arc>&, long long&, int&);
+
+//------------------------------- unpack ------------------------------------
+// unpack
+// appends the original nodes of arc from -> to (not from itself)
+    void unpack(int, int, int, vector<int>&) const;
+
+//------------------------------ findArc ------------------------------------
+// findArc
+// the arc to the given node among the arcs of v, NULL if none
+    const Arc* findArc(const vector<long long>&, const vector<Arc>&,
+                       int, int) const;
+
+//----------------------------- validRanks ----------------------------------
+// validRanks
+// whether the loaded ranks and shortcuts of the given number of nodes
+// fit together, so that queries and unpack stay inside the hierarchy
+    bool validRanks(int) const;
+};
+#endif
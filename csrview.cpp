@@ -0,0 +1,61 @@
+//---------------------------------------------------------------------------
+// csrview.cpp
+// Simple class csrview
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// csrview class:  read-only access to the edges of a graph in compressed
+//   sparse row storage, wherever the arrays are kept
+//
+// Assumptions:
+//   -- the graph it was made from outlives the view and does not change
+//---------------------------------------------------------------------------
+#include <cstddef>
+#include "csrview.h"
+#include "graphcsr.h"
+#include "snapshot.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class csrview
+// the arrays of a GraphCSR
+CSRView::CSRView(const GraphCSR& g)
+    : size(g.size), edges((long long)g.neighbors.size()),
+      offsets(g.offsets.data()), neighbors(g.neighbors.data()),
+      weights(g.weights.empty() ? NULL : g.weights.data()) {
+} // end of Constructor
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class csrview
+// the sections of a mapped GraphSnapshot
+CSRView::CSRView(const GraphSnapshot& g)
+    : size(g.size), edges(g.edges), offsets(g.offsets),
+      neighbors(g.neighbors), weights(g.weights) {
+} // end of Constructor
+
+//------------------------------ accessors ----------------------------------
+int CSRView::getSize() const {
+    return size;
+}
+
+long long CSRView::getEdgeCount() const {
+    return edges;
+}
+
+int CSRView::degree(int i) const {
+    return (int)(offsets[i + 1] - offsets[i]);
+}
+
+const int* CSRView::edgeBegin(int i) const {
+    return neighbors + offsets[i];
+}
+
+const int* CSRView::edgeEnd(int i) const {
+    return neighbors + offsets[i + 1];
+}
+
+const int* CSRView::weightBegin(int i) const {
+    return weights ? weights + offsets[i] : NULL;
+}
+
+bool CSRView::isWeighted() const {
+    return weights != NULL;
+}
@@ -0,0 +1,59 @@
+//---------------------------------------------------------------------------
+// csrview.h
+// Simple class csrview
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// csrview class:  read-only access to the edges of a graph in compressed
+//   sparse row storage, wherever the arrays are kept
+//
+// A GraphCSR keeps its offsets, neighbor and weight arrays in vectors and
+// a GraphSnapshot reads them from a mapped file; a CSRView points at
+// either, so DepthFirst, BreadthFirst, Dijkstra, PathSearch,
+// DeltaStepping and Components search a mapped snapshot in place, with
+// no copy into a GraphCSR.  Both convert to a CSRView without a cast.
+// A view is a few pointers and is copied by value.
+//
+// Assumptions:
+//   -- the graph it was made from outlives the view and does not change
+//---------------------------------------------------------------------------
+#ifndef CSRVIEW_H
+#define CSRVIEW_H
+
+class GraphCSR;
+class GraphSnapshot;
+
+
+class CSRView {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class csrview
+// the edges of the given graph
+    CSRView(const GraphCSR&);
+    CSRView(const GraphSnapshot&);
+
+//------------------------------ accessors ----------------------------------
+// getSize:      the number of nodes
+// getEdgeCount: the number of edges
+// degree:       the number of edges leaving the given node
+// edgeBegin:    pointer to the first neighbor of the given node
+// edgeEnd:      pointer past the last neighbor of the given node
+// weightBegin:  pointer to the weight of the first edge of the given node,
+//               parallel to edgeBegin, NULL when the graph is unweighted
+// isWeighted:   whether the graph keeps edge weights
+    int getSize() const;
+    long long getEdgeCount() const;
+    int degree(int) const;
+    const int* edgeBegin(int) const;
+    const int* edgeEnd(int) const;
+    const int* weightBegin(int) const;
+    bool isWeighted() const;
+
+private:
+    int size;                    // the number of nodes
+    long long edges;             // the number of edges
+    const long long* offsets;    // offsets[i] is the first edge of node i
+    const int* neighbors;        // adjacent nodes of every edge, by node
+    const int* weights;          // weight of every edge, NULL if unweighted
+};
+#endif
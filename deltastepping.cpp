@@ -0,0 +1,313 @@
+//---------------------------------------------------------------------------
+// deltastepping.cpp
+// Simple class deltastepping
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// deltastepping class:  parallel single-source shortest paths on a
+//   GraphCSR by delta-stepping (Meyer and Sanders)
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- the row has room for getSize() + 1 entries
+//   -- the graph must outlive the deltastepping object and not change
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "deltastepping.h"
+#include "stats.h"
+
+// a phase with fewer nodes runs on the calling thread
+static const int SMALL_PHASE = 256;
+
+// the most buckets ahead of the current one kept in slots
+static const int MAX_SLOTS = 1024;
+
+// no path known to a node yet
+static const unsigned long long NO_PATH = ~0ULL;
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class deltastepping
+// copies the edges of every node sorted by weight, an unweighted graph
+// with weight 1
+DeltaStepping::DeltaStepping(CSRView g, int threads, int width)
+    : graph(g), pool(threads), delta(1), maxWeight(1), slotCount(1),
+      current(0), buckets(0), phases(0), dist(g.getSize() + 1),
+      done(g.getSize() + 1), heavyDone(g.getSize() + 1),
+      best(g.getSize() + 1), locals(pool.getThreadCount()) {
+    int size = graph.getSize();
+    offsets.assign(size + 2, 0);
+    for (int v = 1; v <= size; v++) {
+        offsets[v + 1] = offsets[v] + graph.degree(v);
+    }
+    targets.resize(offsets[size + 1]);
+    weights.resize(offsets[size + 1]);
+    lightEnd.assign(size + 2, 0);
+
+    vector<int> largest(pool.getThreadCount(), 1);
+    pool.parallelFor(1, size + 1, [&](int v, int thread) {
+        const int* adj = graph.edgeBegin(v);
+        const int* cost = graph.weightBegin(v);
+        vector<pair<int, int> > edges(graph.degree(v));
+        for (int e = 0; e < graph.degree(v); e++) {
+            edges[e] = make_pair(cost ? cost[e] : 1, adj[e]);
+        }
+        sort(edges.begin(), edges.end());
+        for (size_t e = 0; e < edges.size(); e++) {
+            weights[offsets[v] + e] = edges[e].first;
+            targets[offsets[v] + e] = edges[e].second;
+        }
+        if (!edges.empty()) {
+            largest[thread] = max(largest[thread], edges.back().first);
+        }
+    }, 256);
+    maxWeight = *max_element(largest.begin(), largest.end());
+    setDelta(width);
+} // end of Constructor
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// empties the buckets in order, each in light phases and then one heavy
+// pass; then, for every edge (u, w) on a shortest path, keeps at w the
+// smallest (distance of u, u), which is the previous node Dijkstra keeps
+void DeltaStepping::findShortestPath(int source, TableType row[]) {
+    STATS_TIMER(SOURCE_SEARCH);
+    int size = graph.getSize();
+    pool.parallelFor(0, size + 1, [&](int v, int) {
+        dist[v].store(INT_MAX, memory_order_relaxed);
+        done[v].store(-1, memory_order_relaxed);
+        heavyDone[v].store(-1, memory_order_relaxed);
+        best[v].store(NO_PATH, memory_order_relaxed);
+    }, 4096);
+    for (size_t t = 0; t < locals.size(); t++) {
+        Local& local = locals[t];
+        local.slots.assign(slotCount, vector<int>());
+        local.overflow.clear();
+        local.overflowFirst = INT_MAX;
+        local.settled.clear();
+        local.scanned = 0;
+        local.relaxed = 0;
+    }
+    buckets = 0;
+    phases = 0;
+    current = 0;
+
+    if (source >= 1 && source <= size) {
+        relax(locals[0], source, 0);
+    }
+    while (nextBucket()) {
+        buckets++;
+        for (size_t t = 0; t < locals.size(); t++) locals[t].settled.clear();
+
+        // the light edges, until no node is put back in the bucket
+        for (take(); !frontier.empty(); take()) {
+            phases++;
+            run((int)frontier.size(), [&](int i, Local& local) {
+                int v = frontier[i];
+                int d = dist[v].load(memory_order_relaxed);
+                if (d / delta != current) return;         // moved on
+                if (done[v].exchange(d, memory_order_relaxed) == d) return;
+                local.scanned++;
+                local.settled.push_back(v);
+                for (long long e = offsets[v]; e < lightEnd[v]; e++) {
+                    relax(local, targets[e], (long long)d + weights[e]);
+                }
+                local.relaxed += lightEnd[v] - offsets[v];
+            });
+        }
+
+        // the heavy edges of the nodes of the bucket, now final
+        frontier.clear();
+        for (size_t t = 0; t < locals.size(); t++) {
+            frontier.insert(frontier.end(), locals[t].settled.begin(),
+                            locals[t].settled.end());
+        }
+        run((int)frontier.size(), [&](int i, Local& local) {
+            int v = frontier[i];
+            if (heavyDone[v].exchange(current, memory_order_relaxed)
+                    == current) {
+                return;
+            }
+            int d = dist[v].load(memory_order_relaxed);
+            for (long long e = lightEnd[v]; e < offsets[v + 1]; e++) {
+                relax(local, targets[e], (long long)d + weights[e]);
+            }
+            local.relaxed += offsets[v + 1] - lightEnd[v];
+        });
+        current++;
+    }
+
+    // the previous node of each node, then the row
+    pool.parallelFor(1, size + 1, [&](int u, int) {
+        int d = dist[u].load(memory_order_relaxed);
+        if (d == INT_MAX) return;
+        unsigned long long key = (unsigned long long)d << 32 | (unsigned)u;
+        for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+            int w = targets[e];
+            if ((long long)d + weights[e]
+                    != dist[w].load(memory_order_relaxed)) {
+                continue;
+            }
+            unsigned long long old = best[w].load(memory_order_relaxed);
+            while (key < old && !best[w].compare_exchange_weak(
+                                    old, key, memory_order_relaxed)) {
+            }
+        }
+    }, 256);
+    pool.parallelFor(0, size + 1, [&](int v, int) {
+        int d = dist[v].load(memory_order_relaxed);
+        unsigned long long path = best[v].load(memory_order_relaxed);
+        row[v].visited = v != 0 && d != INT_MAX;
+        row[v].dist = v != 0 ? d : INT_MAX;
+        row[v].path = path == NO_PATH ? 0 : (int)(path & 0xFFFFFFFFULL);
+    }, 4096);
+
+    long long scanned = 0, relaxed = 0;
+    for (size_t t = 0; t < locals.size(); t++) {
+        scanned += locals[t].scanned;
+        relaxed += locals[t].relaxed;
+    }
+    STATS_ADD(SOURCES_SEARCHED, 1);
+    STATS_ADD(NODES_SCANNED, scanned);
+    STATS_ADD(EDGES_RELAXED, relaxed);
+} // end of findShortestPath
+
+//------------------------------ setDelta -----------------------------------
+// setDelta
+// sets the bucket width, 0 for the largest weight over the average
+// degree; the light edges of each node are those up to the first heavier
+// than delta, and a node is never put more than maxWeight / delta + 1
+// buckets ahead, so that many slots, up to MAX_SLOTS, are enough
+void DeltaStepping::setDelta(int width) {
+    int size = graph.getSize();
+    if (width <= 0) {
+        double degree = size > 0 ? (double)weights.size() / size : 1;
+        width = (int)(maxWeight / max(degree, 1.0));
+    }
+    delta = max(width, 1);
+    slotCount = (int)min((long long)maxWeight / delta + 2,
+                         (long long)MAX_SLOTS);
+    pool.parallelFor(1, size + 1, [&](int v, int) {
+        lightEnd[v] = upper_bound(weights.begin() + offsets[v],
+                                  weights.begin() + offsets[v + 1], delta)
+                      - weights.begin();
+    }, 1024);
+} // end of setDelta
+
+//------------------------------ accessors ----------------------------------
+int DeltaStepping::getSize() const {
+    return graph.getSize();
+}
+
+int DeltaStepping::getDelta() const {
+    return delta;
+}
+
+int DeltaStepping::getThreadCount() const {
+    return pool.getThreadCount();
+}
+
+int DeltaStepping::getBucketCount() const {
+    return buckets;
+}
+
+int DeltaStepping::getPhaseCount() const {
+    return phases;
+}
+
+//------------------------------- relax -------------------------------------
+// relax
+// lowers the distance with compare and swap; only the thread that lowers
+// it puts the node in a bucket; a distance that does not fit an int is
+// never taken, as in Dijkstra
+void DeltaStepping::relax(Local& local, int w, long long d) {
+    if (d >= INT_MAX) return;
+    int old = dist[w].load(memory_order_relaxed);
+    while (d < old) {
+        if (dist[w].compare_exchange_weak(old, (int)d,
+                                          memory_order_relaxed)) {
+            place(local, w, (int)d / delta);
+            return;
+        }
+    }
+} // end of relax
+
+//------------------------------- place -------------------------------------
+// place
+// puts a node in the slot of a bucket, or in overflow if too far ahead
+void DeltaStepping::place(Local& local, int w, int bucket) {
+    if (bucket - current < slotCount) {
+        local.slots[bucket % slotCount].push_back(w);
+    }
+    else {
+        local.overflow.push_back(w);
+        local.overflowFirst = min(local.overflowFirst, bucket);
+    }
+} // end of place
+
+//---------------------------- nextBucket -----------------------------------
+// nextBucket
+// looks through the slots from current on, but not past the least bucket
+// put in overflow, whose nodes must be done first; when it gets there, or
+// the slots are all empty, current moves to that bucket and the nodes in
+// overflow go to the slots by their distance now (one whose bucket is
+// below current was done since, at a smaller distance, and is dropped)
+bool DeltaStepping::nextBucket() {
+    while (true) {
+        int limit = INT_MAX;
+        for (size_t t = 0; t < locals.size(); t++) {
+            limit = min(limit, locals[t].overflowFirst);
+        }
+        for (int k = 0; k < slotCount && current + k < limit; k++) {
+            int slot = (current + k) % slotCount;
+            for (size_t t = 0; t < locals.size(); t++) {
+                if (!locals[t].slots[slot].empty()) {
+                    current += k;
+                    return true;
+                }
+            }
+        }
+        if (limit == INT_MAX) return false;
+
+        vector<int> waiting;
+        current = max(current, limit);
+        for (size_t t = 0; t < locals.size(); t++) {
+            waiting.insert(waiting.end(), locals[t].overflow.begin(),
+                           locals[t].overflow.end());
+            locals[t].overflow.clear();
+            locals[t].overflowFirst = INT_MAX;
+        }
+        for (size_t i = 0; i < waiting.size(); i++) {
+            int w = waiting[i];
+            int bucket = dist[w].load(memory_order_relaxed) / delta;
+            if (bucket >= current) place(locals[0], w, bucket);
+        }
+    }
+} // end of nextBucket
+
+//------------------------------- take --------------------------------------
+// take
+// moves the nodes of the current bucket of every thread into frontier
+void DeltaStepping::take() {
+    int slot = current % slotCount;
+    frontier.clear();
+    for (size_t t = 0; t < locals.size(); t++) {
+        vector<int>& nodes = locals[t].slots[slot];
+        frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+        nodes.clear();
+    }
+} // end of take
+
+//------------------------------- run ---------------------------------------
+// run
+// calls body(i, local) for i in 0 .. n-1, on the calling thread if n is
+// small and on every thread if not
+void DeltaStepping::run(int n, const function<void(int, Local&)>& body) {
+    if (n < SMALL_PHASE) {
+        for (int i = 0; i < n; i++) body(i, locals[0]);
+    }
+    else {
+        pool.parallelFor(0, n, [&](int i, int thread) {
+            body(i, locals[thread]);
+        }, 64);
+    }
+} // end of run
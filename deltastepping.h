@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------
+// deltastepping.h
+// Simple class deltastepping
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// deltastepping class:  parallel single-source shortest paths on a
+//   GraphCSR by delta-stepping (Meyer and Sanders)
+//
+// The nodes wait in buckets of width delta by their distance so far.
+// The smallest bucket not empty is emptied in phases: each phase relaxes,
+// on every thread at once, the light edges (weight at most delta) of the
+// nodes in the bucket, which may put nodes back in it.  Once the bucket
+// stays empty the heavy edges of the nodes it held are relaxed, once
+// each.  A distance is lowered with an atomic compare and swap, so a
+// phase takes no lock.  A small delta does the work of Dijkstra in many
+// short phases; a large one has fewer, wider phases that relax some edges
+// more than once.
+//
+// findShortestPath fills a row of TableType the same way as
+// Dijkstra::findShortestPath, the paths too: of the previous nodes on a
+// shortest path, a node keeps the one closest to the source, then the
+// smaller number, which is the one Dijkstra settles first.  These are
+// found after the distances, in one more pass over the edges.
+//
+// The edges of each node are copied sorted by weight, so the light edges
+// of any delta are the front of the list.
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- the row has room for getSize() + 1 entries
+//   -- the graph must outlive the deltastepping object and not change
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+#include <atomic>
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+#include "tabletype.h"
+#include "threadpool.h"
+
+
+class DeltaStepping {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class deltastepping
+// the number of threads, 0 uses one thread per core of the machine, and
+// the bucket width, 0 picks the largest weight over the average degree;
+// the graph, a GraphCSR or a GraphSnapshot, must outlive the object
+    DeltaStepping(CSRView, int = 0, int = 0);
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// the distance and path of every node from the given source in the given
+// row, as Dijkstra::findShortestPath gives them
+    void findShortestPath(int, TableType[]);
+
+//------------------------------ setDelta -----------------------------------
+// setDelta
+// sets the bucket width, 0 for the default
+    void setDelta(int);
+
+//------------------------------ accessors ----------------------------------
+// getSize:        the number of nodes
+// getDelta:       the bucket width
+// getThreadCount: the number of threads
+// getBucketCount: the buckets emptied by the last search
+// getPhaseCount:  the light edge phases of the last search
+    int getSize() const;
+    int getDelta() const;
+    int getThreadCount() const;
+    int getBucketCount() const;
+    int getPhaseCount() const;
+
+private:
+    // the buckets and counts of one thread; padded so the threads do not
+    // write to the same cache line
+    struct Local {
+        vector<vector<int> > slots;    // the nodes put in each bucket slot
+        vector<int> overflow;          // the nodes too far ahead for a slot
+        int overflowFirst;             // the least bucket put in overflow
+        vector<int> settled;           // the nodes whose light edges it did
+        long long scanned;             // the nodes it took from a bucket
+        long long relaxed;             // the edges it relaxed
+        char padding[64];
+    };
+
+    CSRView graph;                     // the graph to search
+    ThreadPool pool;
+    int delta;                         // the bucket width
+    int maxWeight;                     // the largest edge weight
+    int slotCount;                     // the buckets kept ahead, cyclic
+    int current;                       // the bucket being emptied
+    int buckets;                       // buckets of the last search
+    int phases;                        // phases of the last search
+
+    vector<long long> offsets;         // the edges of node v, by weight:
+    vector<int> targets;               //   targets[offsets[v]] ..
+    vector<int> weights;               //   targets[offsets[v+1]-1]
+    vector<long long> lightEnd;        // the end of the light edges of v
+
+    vector<atomic<int> > dist;         // the distance so far
+    vector<atomic<int> > done;         // the distance v's light edges had
+    vector<atomic<int> > heavyDone;    // the bucket v's heavy edges had
+    vector<atomic<unsigned long long> > best;  // (dist, node) of the path
+    vector<Local> locals;              // one per thread
+    vector<int> frontier;              // the nodes of a phase
+
+//------------------------------- relax -------------------------------------
+// relax
+// lowers the distance of a node, if the given one is smaller, and puts
+// the node in the bucket of its new distance
+    void relax(Local&, int, long long);
+
+//------------------------------- place -------------------------------------
+// place
+// puts a node in the slot of a bucket, or in overflow if too far ahead
+    void place(Local&, int, int);
+
+//---------------------------- nextBucket -----------------------------------
+// nextBucket
+// moves current to the next bucket that has nodes, in a slot or in
+// overflow; returns false if none
+    bool nextBucket();
+
+//------------------------------- take --------------------------------------
+// take
+// moves the nodes of the current bucket of every thread into frontier
+    void take();
+
+//------------------------------- run ---------------------------------------
+// run
+// calls body(i, local) for i in 0 .. n-1, on the calling thread if n is
+// small and on every thread if not
+    void run(int, const function<void(int, Local&)>&);
+};
+#endif
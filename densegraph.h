@@ -0,0 +1,226 @@
+//---------------------------------------------------------------------------
+// densegraph.h
+// Simple class densegraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// densegraph class:  GraphM's all-pairs shortest paths on a
+//   WeightMatrix of the given weight type
+//
+// The results are kept as planes instead of a TableType per cell: one
+// array of dist and one of path, each laid out row by source; a node is
+// visited when its dist is known, so visited needs no plane.  The entries
+// of a plane are 1, 2 or 4 bytes, the fewest that hold its largest
+// value: size for path, and the largest weight of the type times size-1
+// for dist, the all-ones entry standing for INT_MAX.  The Dijkstra search
+// from one source runs on int rows of its own next to the weight matrix
+// and stores them into the planes when it is done.
+//
+// Bytes per cell, against the 4 + 12 of GraphM's C and T:
+//                       up to 254 nodes          up to 65534 nodes
+//   bool                1 bit + 1 + 1 (7.5x)     1 bit + 2 + 2 (3.9x)
+//   unsigned char       1 + 2 + 1 (4x)           1 + 4 + 2 (2.3x)
+//   unsigned short      2 + 4 + 1 (2.3x)         2 + 4 + 2 (2x)
+//   int                 4 + 4 + 1 (1.8x)         4 + 4 + 2 (1.6x)
+// so the 4 to 10 times smaller working set is met only up to 254 nodes,
+// GraphM's 100 among them, with bool or unsigned char weights.  Past
+// that, or with wider weights, the target is not met: the dist plane
+// needs 4 bytes as soon as the sum of size-1 weights passes 65534.
+// The search is the one of GraphM: the nearest node not yet visited is
+// found by a scan, ties go to the smaller node, and the edges of a node
+// are relaxed in order of node, so dist and path equal GraphM's T.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size, no fixed limit on the number of nodes
+//   -- distances fit in an int
+//---------------------------------------------------------------------------
+#ifndef DENSEGRAPH_H
+#define DENSEGRAPH_H
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "graphcsr.h"
+#include "tabletype.h"
+#include "weightmatrix.h"
+
+
+template <class Weight>
+class DenseGraph {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class densegraph
+    DenseGraph() : size(0), stride(0) {}
+
+//------------------------------ resize -------------------------------------
+// resize
+// a graph of the given number of nodes and no edges
+    void resize(int n) {
+        size = n;
+        stride = n + 1;
+        weights.resize(n);
+        unsigned long long heaviest = numeric_limits<Weight>::max();
+        dist.assign(stride * stride, heaviest * (n > 1 ? n - 1 : 0),
+                    INT_MAX);
+        path.assign(stride * stride, n, 0);
+    }
+
+//------------------------------ setEdge ------------------------------------
+// setEdge
+// sets the weight of the edge between two nodes, 0 removes it
+// returns false if the weight does not fit the weight type
+    bool setEdge(int i, int j, long long weight) {
+        if (i < 1 || i > size || j < 1 || j > size) return true;
+        if (!WeightMatrix<Weight>::fits(weight)) return false;
+        weights.set(i, j, weight);
+        return true;
+    }
+
+//------------------------------ assign -------------------------------------
+// assign
+// copies the edges of a GraphCSR, an unweighted edge has weight 1
+// returns false, leaving the graph empty, if a weight does not fit
+    bool assign(const GraphCSR& graph) {
+        resize(graph.getSize());
+        for (int v = 1; v <= size; v++) {
+            const int* cost = graph.weightBegin(v);
+            for (int e = 0; e < graph.degree(v); e++) {
+                if (!setEdge(v, graph.edgeBegin(v)[e], cost ? cost[e] : 1)) {
+                    resize(0);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// the shortest path from every source, or from the given one
+    void findShortestPath() {
+        for (int source = 1; source <= size; source++) {
+            findShortestPath(source);
+        }
+    }
+
+    void findShortestPath(int source) {
+        rowDist.assign(stride, INT_MAX);
+        rowPath.assign(stride, 0);
+        int* d = rowDist.data();
+        int* p = rowPath.data();
+        d[source] = 0;
+
+        // key is dist for the nodes not yet visited and INT_MAX for the
+        // rest, so the nearest node is found by one scan of one array
+        key.assign(d, d + stride);
+        for (int step = 1; step <= size; step++) {
+            // the nearest node not yet visited, the smaller one on a tie
+            int v = 0;
+            int nearest = INT_MAX;
+            for (int u = 1; u <= size; u++) {
+                if (key[u] < nearest) {
+                    nearest = key[u];
+                    v = u;
+                }
+            }
+            if (v == 0) break;           // the rest cannot be reached
+            key[v] = INT_MAX;
+
+            // a visited node is no farther than nearest, so with weights
+            // above 0 the row can be relaxed without skipping it
+            weights.lowerRow(v, nearest, d, key.data(), p);
+        }
+        for (int v = 0; v <= size; v++) {
+            dist.set(source * stride + v, d[v]);
+            path.set(source * stride + v, p[v]);
+        }
+    }
+
+//------------------------------ fillRow ------------------------------------
+// fillRow
+// copies the results from the given source into a row of TableType,
+// as GraphM's T[source][*]
+    void fillRow(int source, TableType row[]) const {
+        for (int v = 1; v <= size; v++) {
+            row[v].dist = getDist(source, v);
+            row[v].path = getPath(source, v);
+            row[v].visited = isVisited(source, v);
+        }
+    }
+
+//------------------------------ accessors ----------------------------------
+// getSize:   the number of nodes
+// getWeight: the weight of the edge between two nodes, 0 if none
+// getDist:   the shortest distance from the source, INT_MAX if none
+// getPath:   the previous node in the path, 0 if none
+// isVisited: whether the search from the source reached the node
+// getBytes:  the memory of the matrix and the planes
+    int getSize() const { return size; }
+    int getWeight(int i, int j) const { return (int)weights.get(i, j); }
+    int getDist(int s, int v) const { return dist.get(s * stride + v); }
+    int getPath(int s, int v) const { return path.get(s * stride + v); }
+    bool isVisited(int s, int v) const { return getDist(s, v) != INT_MAX; }
+    size_t getBytes() const {
+        return weights.getBytes() + dist.getBytes() + path.getBytes();
+    }
+
+private:
+    // entries of 1, 2 or 4 bytes, all ones meaning INT_MAX
+    class Plane {
+    public:
+        Plane() : width(4) {}
+
+        // count entries of the given value, wide enough for values up to
+        // largest
+        void assign(size_t count, unsigned long long largest, int value) {
+            width = largest < 0xFF ? 1 : largest < 0xFFFF ? 2 : 4;
+            bytes.assign(count * width, value == INT_MAX ? 0xFF : 0);
+            if (value != 0 && value != INT_MAX) {
+                for (size_t k = 0; k < count; k++) set(k, value);
+            }
+        }
+
+        int get(size_t k) const {
+            const unsigned char* at = bytes.data() + k * width;
+            if (width == 1) return *at == 0xFF ? INT_MAX : *at;
+            if (width == 2) {
+                unsigned short value;
+                memcpy(&value, at, 2);
+                return value == 0xFFFF ? INT_MAX : value;
+            }
+            unsigned value;
+            memcpy(&value, at, 4);
+            return value >= (unsigned)INT_MAX ? INT_MAX : (int)value;
+        }
+
+        void set(size_t k, int value) {
+            unsigned char* at = bytes.data() + k * width;
+            if (width == 1) {
+                *at = (unsigned char)value;
+            }
+            else if (width == 2) {
+                unsigned short narrow = (unsigned short)value;
+                memcpy(at, &narrow, 2);
+            }
+            else {
+                memcpy(at, &value, 4);
+            }
+        }
+
+        size_t getBytes() const { return bytes.size(); }
+
+    private:
+        int width;                     // bytes per entry
+        vector<unsigned char> bytes;   // the entries, back to back
+    };
+
+    int size;                          // the number of nodes
+    size_t stride;                     // entries per row of dist and path
+    WeightMatrix<Weight> weights;      // the edges
+    Plane dist;                        // the dist plane
+    Plane path;                        // the path plane
+    vector<int> rowDist;               // the search's dist row
+    vector<int> rowPath;               // the search's path row
+    vector<int> key;                   // the search's nodes not yet visited
+};
+#endif
@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------
+// depthfirst.cpp
+// Simple class depthfirst
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// depthfirst class:  depth-first search on a GraphCSR
+//   with an explicit stack, so a deep graph cannot overflow the call stack
+//
+// Assumptions:
+//   -- nodes are visited in the order of their edges, roots from 1 .. size
+//   -- the same object is not used by two threads at once
+//---------------------------------------------------------------------------
+#include "depthfirst.h"
+#include "stats.h"
+
+//---------------------------------------------------------------------------
+// The hooks run() calls.  The orderings are collected without a virtual
+// call per node; a Visitor is called through VisitorHooks.
+
+namespace {
+
+struct VisitorHooks {
+    DepthFirst::Visitor& visitor;
+    VisitorHooks(DepthFirst::Visitor& v) : visitor(v) {}
+    void preorder(int v) { visitor.preorder(v); }
+    void postorder(int v) { visitor.postorder(v); }
+};
+
+struct PreorderHooks {
+    vector<int>& order;
+    PreorderHooks(vector<int>& o) : order(o) {}
+    void preorder(int v) { order.push_back(v); }
+    void postorder(int) {}
+};
+
+struct PostorderHooks {
+    vector<int>& order;
+    PostorderHooks(vector<int>& o) : order(o) {}
+    void preorder(int) {}
+    void postorder(int v) { order.push_back(v); }
+};
+
+}
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class depthfirst
+DepthFirst::DepthFirst(CSRView g) : graph(g), epoch(0) {
+} // end of Constructor
+
+//------------------------------ search -------------------------------------
+// search
+// searches from every node not yet reached, in the order 1 .. size
+void DepthFirst::search(Visitor& visitor) {
+    STATS_TIMER(DEPTH_FIRST);
+    reset();
+    VisitorHooks hooks(visitor);
+    for (int i = 1; i <= graph.getSize(); i++) {
+        if (stamp[i] != epoch) run(i, hooks);
+    }
+} // end of search
+
+//---------------------------- searchFrom -----------------------------------
+// searchFrom
+// searches only the nodes reachable from the given node
+void DepthFirst::searchFrom(int source, Visitor& visitor) {
+    STATS_TIMER(DEPTH_FIRST);
+    reset();
+    VisitorHooks hooks(visitor);
+    if (source >= 1 && source <= graph.getSize()) run(source, hooks);
+} // end of searchFrom
+
+//----------------------------- preorder ------------------------------------
+// preorder
+// the nodes in the order they are first reached, from every root
+const vector<int>& DepthFirst::preorder() {
+    STATS_TIMER(DEPTH_FIRST);
+    reset();
+    order.clear();
+    PreorderHooks hooks(order);
+    for (int i = 1; i <= graph.getSize(); i++) {
+        if (stamp[i] != epoch) run(i, hooks);
+    }
+    return order;
+} // end of preorder
+
+//----------------------------- postorder -----------------------------------
+// postorder
+// the nodes in the order they are finished, from every root
+const vector<int>& DepthFirst::postorder() {
+    STATS_TIMER(DEPTH_FIRST);
+    reset();
+    order.clear();
+    PostorderHooks hooks(order);
+    for (int i = 1; i <= graph.getSize(); i++) {
+        if (stamp[i] != epoch) run(i, hooks);
+    }
+    return order;
+} // end of postorder
+
+//----------------------------- reachable -----------------------------------
+// reachable
+// the nodes reachable from the given node, in preorder
+const vector<int>& DepthFirst::reachable(int source) {
+    STATS_TIMER(DEPTH_FIRST);
+    reset();
+    order.clear();
+    PreorderHooks hooks(order);
+    if (source >= 1 && source <= graph.getSize()) run(source, hooks);
+    return order;
+} // end of reachable
+
+//----------------------------- isVisited -----------------------------------
+// isVisited
+// whether the last search reached the given node
+bool DepthFirst::isVisited(int v) const {
+    return v >= 1 && v < (int)stamp.size() && stamp[v] == epoch;
+} // end of isVisited
+
+//------------------------------- reset -------------------------------------
+// reset
+// starts a new search by moving to the next epoch
+// the stamps are only cleared when the graph has grown or the epoch wraps
+void DepthFirst::reset() {
+    size_t needed = graph.getSize() + 1;
+    if (stamp.size() != needed || ++epoch == 0) {
+        stamp.assign(needed, 0);
+        epoch = 1;
+    }
+} // end of reset
+
+//-------------------------------- run --------------------------------------
+// run
+// the depth-first search from one root that is not yet visited
+// each entry of pending is a node and the next of its edges to follow
+// the nodes reached and the deepest stack are counted in locals and
+// added to the stats once per root
+template <class Hooks>
+void DepthFirst::run(int root, Hooks& hooks) {
+    long long reached = 1;
+    size_t deepest = 1;
+    stamp[root] = epoch;
+    hooks.preorder(root);
+    pending.push_back(make_pair(root, graph.edgeBegin(root)));
+
+    while (!pending.empty()) {
+        int v = pending.back().first;
+        const int*& e = pending.back().second;
+        const int* end = graph.edgeEnd(v);
+
+        // the next adjacent node that is not visited
+        while (e != end && stamp[*e] == epoch) e++;
+        if (e == end) {
+            pending.pop_back();          // all adjacent nodes are done
+            hooks.postorder(v);
+            continue;
+        }
+        int w = *e++;
+        stamp[w] = epoch;
+        hooks.preorder(w);
+        pending.push_back(make_pair(w, graph.edgeBegin(w)));
+        reached++;
+        deepest = max(deepest, pending.size());
+    }
+    STATS_ADD(DFS_NODES, reached);
+    STATS_MAX(DFS_MAX_DEPTH, (long long)deepest);
+} // end of run
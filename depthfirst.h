@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------
+// depthfirst.h
+// Simple class depthfirst
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// depthfirst class:  depth-first search on a GraphCSR
+//   with an explicit stack, so a deep graph cannot overflow the call stack
+//
+// A Visitor is told when a node is first reached (preorder) and when all
+// of its edges are done (postorder); preorder and postorder return the
+// ordering as data instead.  The visited flags are an array of epoch
+// stamps: a node is visited when its stamp equals the current epoch, so
+// starting a new search only increments the epoch.  The stack and the
+// stamps are kept between searches, so repeated searches allocate nothing.
+//
+// Assumptions:
+//   -- nodes are visited in the order of their edges, roots from 1 .. size
+//   -- the same object is not used by two threads at once
+//---------------------------------------------------------------------------
+#ifndef DEPTHFIRST_H
+#define DEPTHFIRST_H
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+
+
+class DepthFirst {
+public:
+
+//------------------------------ Visitor ------------------------------------
+// Visitor
+// the hooks called during a search, each does nothing by default
+    class Visitor {
+    public:
+        virtual ~Visitor() {}
+        virtual void preorder(int) {}
+        virtual void postorder(int) {}
+    };
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class depthfirst
+// the graph, a GraphCSR or a GraphSnapshot, must outlive the object
+    DepthFirst(CSRView);
+
+//------------------------------ search -------------------------------------
+// search
+// searches from every node not yet reached, in the order 1 .. size
+    void search(Visitor&);
+
+//---------------------------- searchFrom -----------------------------------
+// searchFrom
+// searches only the nodes reachable from the given node
+    void searchFrom(int, Visitor&);
+
+//----------------------------- preorder ------------------------------------
+// preorder
+// the nodes in the order they are first reached, from every root
+// the array is reused by the next search
+    const vector<int>& preorder();
+
+//----------------------------- postorder -----------------------------------
+// postorder
+// the nodes in the order they are finished, from every root
+// the array is reused by the next search
+    const vector<int>& postorder();
+
+//----------------------------- reachable -----------------------------------
+// reachable
+// the nodes reachable from the given node, in preorder
+// the array is reused by the next search
+    const vector<int>& reachable(int);
+
+//----------------------------- isVisited -----------------------------------
+// isVisited
+// whether the last search reached the given node
+    bool isVisited(int) const;
+
+private:
+    CSRView graph;                     // the graph to search
+    vector<unsigned> stamp;            // stamp[v] == epoch when v is visited
+    unsigned epoch;                    // the stamp of the current search
+
+    // the nodes being searched, with the next edge to follow of each
+    vector<pair<int, const int*> > pending;
+    vector<int> order;                 // the result of the last search
+
+    void reset();
+
+    template <class Hooks>
+    void run(int, Hooks&);
+};
+#endif
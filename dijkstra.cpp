@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+// dijkstra.cpp
+// Simple class dijkstra
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dijkstra class:  Dijkstra's shortest path algorithm
+//   on a GraphCSR by using a binary heap
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- the row has room for getSize() + 1 entries
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include "dijkstra.h"
+#include "stats.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class dijkstra
+Dijkstra::Dijkstra(CSRView g) : graph(g) {
+} // end of Constructor
+
+//------------------------- findShortestPath -------------------------------
+// findShortestPath
+// perform the Dijkstra's algorithm from the given source
+// the heap pops ties by the smaller node number, so the paths found are
+// the same as the linear scan in GraphM::findShortestPathHelper
+// the nodes scanned and edges relaxed are counted in locals and added
+// to the stats once per source
+void Dijkstra::findShortestPath(int source, TableType row[]) {
+    STATS_TIMER(SOURCE_SEARCH);
+    long long scanned = 0, relaxed = 0;
+    int size = graph.getSize();
+    for (int i = 0; i <= size; i++) {
+        row[i].visited = false;
+        row[i].dist = INT_MAX;
+        row[i].path = 0;
+    }
+    if (source < 1 || source > size) return;
+
+    greater<pair<int, int> > later;    // heap order, smallest on top
+    heap.clear();
+    row[source].dist = 0;
+    heap.push_back(make_pair(0, source));
+
+    while (!heap.empty()) {
+
+        // find v, which is the not visited, shortest distance at this point
+        pop_heap(heap.begin(), heap.end(), later);
+        int v = heap.back().second;
+        heap.pop_back();
+        if (row[v].visited) continue;
+        row[v].visited = true;
+        scanned++;
+
+        // for each w adjacent to v and w is not visited
+        int degree = graph.degree(v);
+        const int* adj = graph.edgeBegin(v);
+        const int* cost = graph.weightBegin(v);
+        relaxed += degree;
+        for (int e = 0; e < degree; e++) {
+            int w = adj[e];
+            if (row[w].visited) continue;
+            long long dist = (long long)row[v].dist + (cost ? cost[e] : 1);
+            if (dist < row[w].dist) {
+                row[w].dist = (int)dist;
+                row[w].path = v;
+                heap.push_back(make_pair(row[w].dist, w));
+                push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+    STATS_ADD(SOURCES_SEARCHED, 1);
+    STATS_ADD(NODES_SCANNED, scanned);
+    STATS_ADD(EDGES_RELAXED, relaxed);
+} // end of findShortestPath
@@ -0,0 +1,50 @@
+//---------------------------------------------------------------------------
+// dijkstra.h
+// Simple class dijkstra
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dijkstra class:  Dijkstra's shortest path algorithm
+//   on a GraphCSR by using a binary heap
+//
+// Finds the shortest path from one source to every other node and
+// fills a row of TableType the same way GraphM fills T[source][*]:
+//   -- dist is the shortest distance, INT_MAX when not reachable
+//   -- path is the previous node in the path, 0 for the source
+//   -- visited is true for every node whose distance is final
+// Each source costs O((V + E) log V) instead of O(V^2).
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- the row has room for getSize() + 1 entries
+//---------------------------------------------------------------------------
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+#include "tabletype.h"
+
+
+class Dijkstra {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class dijkstra
+// searches a GraphCSR or a mapped GraphSnapshot in place,
+// which must outlive the dijkstra object
+    Dijkstra(CSRView);
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// perform the Dijkstra's algorithm from the given source
+// and store the distance and path of every node in the given row
+    void findShortestPath(int, TableType[]);
+
+private:
+    CSRView graph;                     // the graph to search
+
+    // the heap of (distance, node), smallest first; a node may be in the
+    // heap more than once, the entries with a stale distance are skipped
+    vector<pair<int, int> > heap;
+};
+#endif
@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------
+// dynamicgraph.cpp
+// Simple class dynamicgraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dynamicgraph class:  a weighted graph whose edges can be changed
+//   keeping both the edges leaving and the edges entering each node
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- edge weights are positive
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "dynamicgraph.h"
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class dynamicgraph
+DynamicGraph::DynamicGraph() : size(0) {
+} // end of Constructor
+
+//------------------------------ assign -------------------------------------
+// assign
+// copies the edges of a GraphCSR, an unweighted edge has weight 1 and of
+// several edges between the same two nodes the lightest is kept
+void DynamicGraph::assign(const GraphCSR& graph) {
+    size = graph.getSize();
+    out.assign(size + 1, vector<pair<int, int> >());
+    in.assign(size + 1, vector<pair<int, int> >());
+    for (int v = 1; v <= size; v++) {
+        const int* cost = graph.weightBegin(v);
+        vector<pair<int, int> >& list = out[v];
+        for (int e = 0; e < graph.degree(v); e++) {
+            list.push_back(make_pair(graph.edgeBegin(v)[e], cost ? cost[e] : 1));
+        }
+
+        // sorted by node then weight, the first edge to each node is kept
+        sort(list.begin(), list.end());
+        size_t kept = 0;
+        for (size_t k = 0; k < list.size(); k++) {
+            if (kept == 0 || list[k].first != list[kept - 1].first) {
+                list[kept++] = list[k];
+            }
+        }
+        list.resize(kept);
+        for (size_t k = 0; k < list.size(); k++) {
+            in[list[k].first].push_back(make_pair(v, list[k].second));
+        }
+    }
+} // end of assign
+
+//----------------------------- setWeight -----------------------------------
+// setWeight
+// sets the weight of the edge from the first node to the second,
+// 0 removes it; returns the old weight, 0 if there was no edge
+int DynamicGraph::setWeight(int from, int to, int weight) {
+    if (from < 1 || from > size || to < 1 || to > size) return 0;
+    setArc(in[to], from, weight);
+    return setArc(out[from], to, weight);
+} // end of setWeight
+
+//----------------------------- setArc --------------------------------------
+// setArc
+// sets the weight of node in one list, 0 removes it; returns the old one
+// a removed entry is replaced by the last one, the order does not matter
+int DynamicGraph::setArc(vector<pair<int, int> >& list, int node, int weight) {
+    for (size_t k = 0; k < list.size(); k++) {
+        if (list[k].first != node) continue;
+        int old = list[k].second;
+        if (weight == 0) {
+            list[k] = list.back();
+            list.pop_back();
+        }
+        else {
+            list[k].second = weight;
+        }
+        return old;
+    }
+    if (weight != 0) list.push_back(make_pair(node, weight));
+    return 0;
+} // end of setArc
+
+//------------------------------ accessors ----------------------------------
+int DynamicGraph::getSize() const {
+    return size;
+}
+
+int DynamicGraph::getWeight(int from, int to) const {
+    if (from < 1 || from > size || to < 1 || to > size) return 0;
+    const vector<pair<int, int> >& list = out[from];
+    for (size_t k = 0; k < list.size(); k++) {
+        if (list[k].first == to) return list[k].second;
+    }
+    return 0;
+}
+
+const vector<pair<int, int> >& DynamicGraph::outgoing(int v) const {
+    return out[v];
+}
+
+const vector<pair<int, int> >& DynamicGraph::incoming(int v) const {
+    return in[v];
+}
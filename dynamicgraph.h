@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------
+// dynamicgraph.h
+// Simple class dynamicgraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dynamicgraph class:  a weighted graph whose edges can be changed
+//   keeping both the edges leaving and the edges entering each node
+//
+// setWeight changes, adds or removes one edge in time proportional to the
+// degree of its ends; DynamicPaths uses the entering edges to repair a
+// shortest path tree after edges get worse.  Like GraphM there is at most
+// one edge from one node to another and a weight of 0 means no edge.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- edge weights are positive
+//---------------------------------------------------------------------------
+#ifndef DYNAMICGRAPH_H
+#define DYNAMICGRAPH_H
+#include <vector>
+#include "graphcsr.h"
+
+// a change of the weight of the edge from -> to, 0 removes the edge;
+// oldWeight is the weight before the change, filled in when it is applied
+struct EdgeChange {
+    int from;
+    int to;
+    int weight;
+    int oldWeight;
+};
+
+
+class DynamicGraph {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class dynamicgraph
+    DynamicGraph();
+
+//------------------------------ assign -------------------------------------
+// assign
+// copies the edges of a GraphCSR, an unweighted edge has weight 1 and of
+// several edges between the same two nodes the lightest is kept
+    void assign(const GraphCSR&);
+
+//----------------------------- setWeight -----------------------------------
+// setWeight
+// sets the weight of the edge from the first node to the second,
+// 0 removes it; returns the old weight, 0 if there was no edge
+// an edge with an end outside 1 .. size is ignored
+    int setWeight(int, int, int);
+
+//------------------------------ accessors ----------------------------------
+// getSize:   the number of nodes
+// getWeight: the weight of the edge between two nodes, 0 if there is none
+// outgoing:  the (node, weight) of every edge leaving the given node
+// incoming:  the (node, weight) of every edge entering the given node
+    int getSize() const;
+    int getWeight(int, int) const;
+    const vector<pair<int, int> >& outgoing(int) const;
+    const vector<pair<int, int> >& incoming(int) const;
+
+private:
+    int size;                               // the number of nodes
+    vector<vector<pair<int, int> > > out;   // edges leaving each node
+    vector<vector<pair<int, int> > > in;    // edges entering each node
+
+//----------------------------- setArc --------------------------------------
+// setArc
+// sets the weight of node in one list, 0 removes it; returns the old one
+    static int setArc(vector<pair<int, int> >&, int, int);
+};
+#endif
@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------
+// dynamicpaths.cpp
+// Simple class dynamicpaths
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dynamicpaths class:  keeps a shortest path tree up to date
+//   when edges of a DynamicGraph change (Ramalingam and Reps)
+//
+// Assumptions:
+//   -- the row has room for getSize() + 1 entries
+//   -- each change has its oldWeight filled in
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include "dynamicpaths.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class dynamicpaths
+DynamicPaths::DynamicPaths(const DynamicGraph& g)
+    : graph(g), epoch(0), touched(0) {
+} // end of Constructor
+
+//------------------------------ update -------------------------------------
+// update
+// repairs the shortest path tree from the given source stored in the
+// given row, after the given changes were applied to the graph
+// first the affected subtrees are found while the paths are still the
+// old ones, then they are cleared and reconnected, then the better edges
+// lower their end nodes, and one Dijkstra pass settles everything lowered
+void DynamicPaths::update(int source, TableType row[],
+                          const vector<EdgeChange>& changes) {
+    int size = graph.getSize();
+    reset();
+    affected.clear();
+    heap.clear();
+    touched = 0;
+    if (source < 1 || source > size) return;
+
+    // edges that got worse and are in the tree
+    for (size_t k = 0; k < changes.size(); k++) {
+        const EdgeChange& c = changes[k];
+        if (c.from < 1 || c.from > size || c.to < 1 || c.to > size) continue;
+        bool worse = c.oldWeight != 0
+            && (c.weight == 0 || c.weight > c.oldWeight);
+        if (worse && row[c.to].path == c.from && stamp[c.to] != epoch) {
+            markTree(c.to, row);
+        }
+    }
+
+    // each affected node starts again from its best edge entering
+    // from a node that is not affected
+    for (size_t k = 0; k < affected.size(); k++) {
+        int v = affected[k];
+        row[v].dist = INT_MAX;
+        row[v].path = 0;
+        row[v].visited = false;
+    }
+    for (size_t k = 0; k < affected.size(); k++) {
+        int v = affected[k];
+        const vector<pair<int, int> >& edges = graph.incoming(v);
+        for (size_t e = 0; e < edges.size(); e++) {
+            int u = edges[e].first;
+            if (stamp[u] != epoch && row[u].dist != INT_MAX) {
+                lower(row, v, (long long)row[u].dist + edges[e].second, u);
+            }
+        }
+    }
+
+    // edges that got better, with their weight after the whole batch
+    for (size_t k = 0; k < changes.size(); k++) {
+        const EdgeChange& c = changes[k];
+        if (c.from < 1 || c.from > size || c.to < 1 || c.to > size) continue;
+        bool better = c.weight != 0
+            && (c.oldWeight == 0 || c.weight < c.oldWeight);
+        int weight = graph.getWeight(c.from, c.to);
+        if (better && weight != 0 && row[c.from].dist != INT_MAX) {
+            lower(row, c.to, (long long)row[c.from].dist + weight, c.from);
+        }
+    }
+
+    // settle the lowered nodes in order of distance; an entry whose
+    // distance has been lowered again since it was pushed is skipped
+    greater<pair<int, int> > later;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), later);
+        int d = heap.back().first;
+        int v = heap.back().second;
+        heap.pop_back();
+        if (d != row[v].dist || row[v].visited) continue;
+        row[v].visited = true;
+        touched++;
+
+        const vector<pair<int, int> >& edges = graph.outgoing(v);
+        for (size_t e = 0; e < edges.size(); e++) {
+            lower(row, edges[e].first, (long long)d + edges[e].second, v);
+        }
+    }
+} // end of update
+
+//--------------------------- getTouchedCount -------------------------------
+// getTouchedCount
+// the number of nodes whose entry the last update recomputed
+int DynamicPaths::getTouchedCount() const {
+    return touched;
+} // end of getTouchedCount
+
+//------------------------------ reset --------------------------------------
+// reset
+// starts a new update by moving to the next epoch
+// the stamps are only cleared when the graph has grown or the epoch wraps
+void DynamicPaths::reset() {
+    size_t needed = graph.getSize() + 1;
+    if (stamp.size() != needed || ++epoch == 0) {
+        stamp.assign(needed, 0);
+        epoch = 1;
+    }
+} // end of reset
+
+//------------------------------ markTree -----------------------------------
+// markTree
+// marks the given node and every node below it in the tree as affected
+// the children of v are the nodes at the end of an edge leaving v whose
+// previous node in the path is v
+void DynamicPaths::markTree(int root, TableType row[]) {
+    size_t next = affected.size();
+    stamp[root] = epoch;
+    affected.push_back(root);
+    while (next < affected.size()) {
+        int v = affected[next++];
+        const vector<pair<int, int> >& edges = graph.outgoing(v);
+        for (size_t e = 0; e < edges.size(); e++) {
+            int w = edges[e].first;
+            if (stamp[w] != epoch && row[w].path == v
+                && row[w].dist != INT_MAX) {
+                stamp[w] = epoch;
+                affected.push_back(w);
+            }
+        }
+    }
+} // end of markTree
+
+//------------------------------ lower --------------------------------------
+// lower
+// records a shorter distance and previous node, and pushes it on the heap
+// the node is not final until it is taken off the heap
+void DynamicPaths::lower(TableType row[], int v, long long dist, int previous) {
+    if (dist >= row[v].dist || dist >= INT_MAX) return;
+    row[v].dist = (int)dist;
+    row[v].path = previous;
+    row[v].visited = false;
+    heap.push_back(make_pair((int)dist, v));
+    push_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+} // end of lower
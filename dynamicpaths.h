@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------
+// dynamicpaths.h
+// Simple class dynamicpaths
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// dynamicpaths class:  keeps a shortest path tree up to date
+//   when edges of a DynamicGraph change (Ramalingam and Reps)
+//
+// update repairs a row of TableType, filled by Dijkstra or by an earlier
+// update, after a batch of edge changes has been applied to the graph:
+//   -- an edge that got worse or was removed and is in the tree makes the
+//      subtree below it affected; each affected node starts again from
+//      the best edge entering it from a node that is not affected
+//   -- an edge that got better lowers the distance of its end node
+// The nodes whose distance changes then go through one Dijkstra heap, so
+// only they and their edges are looked at, and a batch of changes costs
+// one pass instead of one per change.
+// The distances equal those of a full Dijkstra; where two paths are
+// equally short the path kept may be a different one of them.
+//
+// Assumptions:
+//   -- the row has room for getSize() + 1 entries
+//   -- each change has its oldWeight filled in
+//---------------------------------------------------------------------------
+#ifndef DYNAMICPATHS_H
+#define DYNAMICPATHS_H
+#include <vector>
+#include "dynamicgraph.h"
+#include "tabletype.h"
+
+
+class DynamicPaths {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class dynamicpaths
+// the graph must outlive the dynamicpaths object
+    DynamicPaths(const DynamicGraph&);
+
+//------------------------------ update -------------------------------------
+// update
+// repairs the shortest path tree from the given source stored in the
+// given row, after the given changes were applied to the graph
+    void update(int, TableType[], const vector<EdgeChange>&);
+
+//--------------------------- getTouchedCount -------------------------------
+// getTouchedCount
+// the number of nodes whose entry the last update recomputed
+    int getTouchedCount() const;
+
+private:
+    const DynamicGraph& graph;         // the graph of the tree
+    vector<unsigned> stamp;            // stamp[v] == epoch: v is affected
+    unsigned epoch;                    // the stamp of the current update
+    vector<int> affected;              // the affected nodes
+    vector<pair<int, int> > heap;      // (distance, node), smallest first
+    int touched;                       // entries recomputed by the update
+
+//------------------------------ reset --------------------------------------
+// reset
+// starts a new update by moving to the next epoch
+    void reset();
+
+//------------------------------ markTree -----------------------------------
+// markTree
+// marks the given node and every node below it in the tree as affected
+    void markTree(int, TableType[]);
+
+//------------------------------ lower --------------------------------------
+// lower
+// records a shorter distance and previous node, and pushes it on the heap
+    void lower(TableType[], int, long long, int);
+};
+#endif
@@ -0,0 +1,218 @@
+//---------------------------------------------------------------------------
+// floyd.cpp
+// Simple class floyd
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// floyd class:  Floyd-Warshall all pairs shortest paths
+//   for dense graphs given as an adjacency matrix
+//
+// Assumptions:
+//   -- edge weights are positive, a weight of 0 means there is no edge
+//   -- every shortest distance is less than INT_MAX / 2
+//---------------------------------------------------------------------------
+#include <cstring>
+#include "floyd.h"
+#include "threadpool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FLOYD_X86 1
+#include <immintrin.h>
+#endif
+
+// the distance used for "no path", small enough that two can be added
+static const int INF = INT_MAX / 2;
+
+//---------------------------------------------------------------------------
+// The min-plus loops over one row of a tile:
+//   for each j: if dik + dkj[j] < dij[j], take it and the path of k -> j
+// n is BLOCK, so it is a multiple of every vector width.
+
+static void minPlusScalar(int* dij, int* pij, const int* dkj,
+                          const int* pkj, int dik, int n) {
+    for (int j = 0; j < n; j++) {
+        int d = dik + dkj[j];
+        if (d < dij[j]) {
+            dij[j] = d;
+            pij[j] = pkj[j];
+        }
+    }
+}
+
+#ifdef FLOYD_X86
+__attribute__((target("avx2")))
+static void minPlusAvx2(int* dij, int* pij, const int* dkj,
+                        const int* pkj, int dik, int n) {
+    __m256i ik = _mm256_set1_epi32(dik);
+    for (int j = 0; j < n; j += 8) {
+        __m256i d = _mm256_add_epi32(ik,
+            _mm256_loadu_si256((const __m256i*)(dkj + j)));
+        __m256i old = _mm256_loadu_si256((const __m256i*)(dij + j));
+        __m256i less = _mm256_cmpgt_epi32(old, d);
+        _mm256_storeu_si256((__m256i*)(dij + j), _mm256_min_epi32(old, d));
+        _mm256_maskstore_epi32(pij + j, less,
+            _mm256_loadu_si256((const __m256i*)(pkj + j)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void minPlusAvx512(int* dij, int* pij, const int* dkj,
+                          const int* pkj, int dik, int n) {
+    __m512i ik = _mm512_set1_epi32(dik);
+    for (int j = 0; j < n; j += 16) {
+        __m512i d = _mm512_add_epi32(ik, _mm512_loadu_si512(dkj + j));
+        __m512i old = _mm512_loadu_si512(dij + j);
+        __mmask16 less = _mm512_cmplt_epi32_mask(d, old);
+        _mm512_mask_storeu_epi32(dij + j, less, d);
+        _mm512_mask_storeu_epi32(pij + j, less,
+                                 _mm512_loadu_si512(pkj + j));
+    }
+}
+#endif
+
+typedef void (*MinPlus)(int*, int*, const int*, const int*, int, int);
+
+// the names of the min-plus loops, widest first
+static const char* const KERNELS[] = { "avx512", "avx2", "scalar" };
+
+// the min-plus loop of the given name, NULL if the processor lacks it
+static MinPlus findKernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) return minPlusScalar;
+#ifdef FLOYD_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "avx512") == 0 && __builtin_cpu_supports("avx512f")) {
+        return minPlusAvx512;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        return minPlusAvx2;
+    }
+#endif
+    return NULL;
+}
+
+// the name of the widest min-plus loop the processor supports
+static const char* pickKernel() {
+    for (size_t k = 0; k < sizeof(KERNELS) / sizeof(KERNELS[0]); k++) {
+        if (findKernel(KERNELS[k]) != NULL) return KERNELS[k];
+    }
+    return "scalar";
+}
+
+static const char* kernelName = pickKernel();
+static MinPlus minPlus = findKernel(kernelName);
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class floyd
+FloydWarshall::FloydWarshall(int t) : threads(t), size(0), width(0) {
+} // end of Constructor
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// find the shortest path between every node to every other node
+// the cost of edge i -> j is cost[i * stride + j] for i, j in 1 .. size
+void FloydWarshall::findShortestPath(int nodes, const int* cost,
+                                     int stride) {
+    size = nodes;
+    width = (size + BLOCK - 1) / BLOCK * BLOCK;
+    dist.assign((size_t)width * width, INF);
+    path.assign((size_t)width * width, -1);
+
+    // start with the edges, path[i][j] is the node before j
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            int c = cost[(size_t)(i + 1) * stride + (j + 1)];
+            if (c != 0) {
+                dist[(size_t)i * width + j] = c;
+                path[(size_t)i * width + j] = i;
+            }
+        }
+        dist[(size_t)i * width + i] = 0;
+    }
+
+    int blocks = width / BLOCK;
+    ThreadPool pool(threads);
+    for (int kb = 0; kb < blocks; kb++) {
+
+        // the diagonal tile depends only on itself
+        tile(kb, kb, kb);
+
+        // the tiles in the row and the column of the diagonal tile
+        pool.parallelFor(0, blocks, [&](int b, int) {
+            if (b == kb) return;
+            tile(kb, b, kb);
+            tile(b, kb, kb);
+        });
+
+        // every other tile, one row of tiles at a time
+        pool.parallelFor(0, blocks, [&](int ib, int) {
+            if (ib == kb) return;
+            for (int jb = 0; jb < blocks; jb++) {
+                if (jb != kb) tile(ib, jb, kb);
+            }
+        });
+    }
+} // end of findShortestPath
+
+//------------------------------- tile --------------------------------------
+// tile
+// relaxes tile (ib, jb) through the nodes of block kb
+// k is the outer loop, so the tile may be the row or column tile itself
+void FloydWarshall::tile(int ib, int jb, int kb) {
+    for (int k = kb * BLOCK; k < (kb + 1) * BLOCK; k++) {
+        const int* dkj = &dist[(size_t)k * width + jb * BLOCK];
+        const int* pkj = &path[(size_t)k * width + jb * BLOCK];
+        for (int i = ib * BLOCK; i < (ib + 1) * BLOCK; i++) {
+            int dik = dist[(size_t)i * width + k];
+            if (dik >= INF) continue;          // no path from i to k
+            minPlus(&dist[(size_t)i * width + jb * BLOCK],
+                    &path[(size_t)i * width + jb * BLOCK],
+                    dkj, pkj, dik, BLOCK);
+        }
+    }
+} // end of tile
+
+//------------------------------ fillRow ------------------------------------
+// fillRow
+// stores the distance and path from the given source to every node
+// in the given row, size+1 entries laid out like GraphM's T[source][*]
+void FloydWarshall::fillRow(int source, TableType row[]) const {
+    row[0] = TableType();
+    for (int j = 1; j <= size; j++) {
+        row[j].dist = getDist(source, j);
+        row[j].path = j == source ? 0 : getPath(source, j);
+        row[j].visited = row[j].dist != INT_MAX;
+    }
+} // end of fillRow
+
+//------------------------------ accessors ----------------------------------
+int FloydWarshall::getSize() const {
+    return size;
+}
+
+int FloydWarshall::getDist(int i, int j) const {
+    int d = dist[(size_t)(i - 1) * width + (j - 1)];
+    return d >= INF ? INT_MAX : d;
+}
+
+int FloydWarshall::getPath(int i, int j) const {
+    return path[(size_t)(i - 1) * width + (j - 1)] + 1;
+}
+
+const char* FloydWarshall::getKernelName() {
+    return kernelName;
+}
+
+//------------------------------ setKernel ----------------------------------
+// setKernel
+// uses the min-plus loop of the given name from now on
+bool FloydWarshall::setKernel(const char* name) {
+    for (size_t k = 0; k < sizeof(KERNELS) / sizeof(KERNELS[0]); k++) {
+        MinPlus kernel = findKernel(KERNELS[k]);
+        if (kernel != NULL && strcmp(name, KERNELS[k]) == 0) {
+            kernelName = KERNELS[k];
+            minPlus = kernel;
+            return true;
+        }
+    }
+    return false;
+} // end of setKernel
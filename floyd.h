@@ -0,0 +1,81 @@
+//---------------------------------------------------------------------------
+// floyd.h
+// Simple class floyd
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// floyd class:  Floyd-Warshall all pairs shortest paths
+//   for dense graphs given as an adjacency matrix
+//
+// The matrix is split into BLOCK x BLOCK tiles.  For each block of k the
+// diagonal tile is done first, then the tiles in its row and column,
+// then every other tile, so each step works on three tiles that stay in
+// cache.  The innermost min-plus loop over a tile row is picked at run
+// time: AVX-512, AVX2 or plain C++, whichever the processor supports.
+//
+// Distances are the same as Dijkstra's; when two paths tie, the path
+// kept may be a different one of the shortest paths.
+//
+// Assumptions:
+//   -- edge weights are positive, a weight of 0 means there is no edge
+//   -- every shortest distance is less than INT_MAX / 2
+//---------------------------------------------------------------------------
+#ifndef FLOYD_H
+#define FLOYD_H
+#include <vector>
+#include "tabletype.h"
+using namespace std;
+
+
+class FloydWarshall {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class floyd
+// the number of threads for the tiles, 0 uses one thread per core
+    explicit FloydWarshall(int = 1);
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// find the shortest path between every node to every other node
+// the cost of edge i -> j is cost[i * stride + j] for i, j in 1 .. size
+    void findShortestPath(int, const int*, int);
+
+//------------------------------ fillRow ------------------------------------
+// fillRow
+// stores the distance and path from the given source to every node
+// in the given row, size+1 entries laid out like GraphM's T[source][*]
+    void fillRow(int, TableType[]) const;
+
+//------------------------------ accessors ----------------------------------
+// getSize:       the number of nodes
+// getDist:       the shortest distance from i to j, INT_MAX if none
+// getPath:       the node before j in the path from i to j, 0 if none
+// getKernelName: the min-plus loop in use: "avx512", "avx2" or "scalar"
+    int getSize() const;
+    int getDist(int, int) const;
+    int getPath(int, int) const;
+    static const char* getKernelName();
+
+//------------------------------ setKernel ----------------------------------
+// setKernel
+// uses the named min-plus loop, "avx512", "avx2" or "scalar", in place of
+// the one picked at start, so that tests can run each of them
+// returns false, keeping the loop in use, if the processor lacks it
+// it changes every FloydWarshall, so no search may be running
+    static bool setKernel(const char*);
+
+    static const int BLOCK = 64;          // tile width, a multiple of 16
+
+private:
+    int threads;              // the number of threads for the tiles
+    int size;                 // the number of nodes
+    int width;                // size rounded up to a multiple of BLOCK
+    vector<int> dist;         // width x width distances, 0-based
+    vector<int> path;         // width x width previous nodes, 0-based
+
+//------------------------------- tile --------------------------------------
+// tile
+// relaxes tile (ib, jb) through the nodes of block kb
+    void tile(int, int, int);
+};
+#endif
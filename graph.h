@@ -0,0 +1,395 @@
+//---------------------------------------------------------------------------
+// graph.h
+// Simple class graph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graph class:  a graph whose layout, weight type, direction and node
+//   information are template arguments, with Dijkstra's shortest paths
+//
+// Graph<Storage, Weight, Directed, Payload>:
+//   -- Storage is ListStorage (an edge list per node, as GraphL),
+//      MatrixStorage (an adjacency matrix on the heap, as GraphM) or
+//      FixedStorage<N> (an adjacency matrix of at most N nodes held in the
+//      object itself, so a small graph never allocates)
+//   -- Weight is the type of a weight, 0 meaning no edge
+//   -- Directed is false for a graph whose edges go both ways
+//   -- Payload is the node information, NoPayload for none
+// Every choice is made when the template is instantiated, so the search
+// loops carry no test of layout or direction.  A distance is of type
+// Graph::Distance, Weight + Weight, so narrow weights add up in an int.
+//
+// With C++14 the members used by FixedStorage graphs are constexpr, so a
+// constexpr function may build a small graph and search it, e.g. to check
+// a distance in a static_assert.  With C++11 the same code runs at run
+// time, still without touching the heap.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- weights are above 0, and distances fit in Distance
+//   -- shortest paths with ListStorage use a heap and may break a tie
+//      of distance another way than GraphM; the distances are the same
+//---------------------------------------------------------------------------
+#ifndef GRAPH_H
+#define GRAPH_H
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+#if __cplusplus >= 201402L
+#define GRAPH_CONSTEXPR constexpr
+#else
+#define GRAPH_CONSTEXPR
+#endif
+
+// the layouts of a Graph
+struct ListStorage {};
+struct MatrixStorage {};
+template <int N> struct FixedStorage {};
+
+// the node information of a Graph without any
+struct NoPayload {};
+
+// an edge in a list of ListStorage
+template <class Weight>
+struct GraphEdge {
+    int to;
+    Weight weight;
+};
+
+
+//------------------------------ GraphStorage -------------------------------
+// the edges and node information of a Graph, one specialization per layout
+// each has resize, getSize, getWeight, setWeight, forEachEdge and payload;
+// dense is true for a matrix, which the search scans by row, and
+// Array<T> is the type of the search's scratch array of T per node
+template <class Storage, class Weight, class Payload>
+class GraphStorage;
+
+template <class Weight, class Payload>
+class GraphStorage<ListStorage, Weight, Payload> {
+public:
+    static const bool dense = false;
+    template <class T> using Array = vector<T>;
+
+    GraphStorage() : size(0) {}
+
+    bool resize(int n) {
+        size = n;
+        lists.assign(n + 1, vector<GraphEdge<Weight> >());
+        data.assign(n + 1, Payload());
+        return true;
+    }
+
+    int getSize() const { return size; }
+
+    Weight getWeight(int i, int j) const {
+        for (size_t e = 0; e < lists[i].size(); e++) {
+            if (lists[i][e].to == j) return lists[i][e].weight;
+        }
+        return Weight();
+    }
+
+    // a weight of 0 removes the edge
+    void setWeight(int i, int j, Weight weight) {
+        vector<GraphEdge<Weight> >& list = lists[i];
+        for (size_t e = 0; e < list.size(); e++) {
+            if (list[e].to == j) {
+                if (weight == Weight()) list.erase(list.begin() + e);
+                else list[e].weight = weight;
+                return;
+            }
+        }
+        if (weight != Weight()) {
+            GraphEdge<Weight> edge = { j, weight };
+            list.push_back(edge);
+        }
+    }
+
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        for (size_t e = 0; e < lists[i].size(); e++) {
+            f(lists[i][e].to, lists[i][e].weight);
+        }
+    }
+
+    const vector<GraphEdge<Weight> >& edges(int i) const { return lists[i]; }
+    Payload& payload(int i) { return data[i]; }
+    const Payload& payload(int i) const { return data[i]; }
+
+private:
+    int size;                                  // the number of nodes
+    vector<vector<GraphEdge<Weight> > > lists; // the edges of each node
+    vector<Payload> data;                      // the node information
+};
+
+template <class Weight, class Payload>
+class GraphStorage<MatrixStorage, Weight, Payload> {
+public:
+    static const bool dense = true;
+    template <class T> using Array = vector<T>;
+
+    GraphStorage() : size(0) {}
+
+    bool resize(int n) {
+        size = n;
+        cells.assign((size_t)(n + 1) * (n + 1), Weight());
+        data.assign(n + 1, Payload());
+        return true;
+    }
+
+    int getSize() const { return size; }
+
+    Weight getWeight(int i, int j) const {
+        return cells[(size_t)i * (size + 1) + j];
+    }
+
+    void setWeight(int i, int j, Weight weight) {
+        cells[(size_t)i * (size + 1) + j] = weight;
+    }
+
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        const Weight* row = cells.data() + (size_t)i * (size + 1);
+        for (int j = 1; j <= size; j++) {
+            if (row[j] != Weight()) f(j, row[j]);
+        }
+    }
+
+    Payload& payload(int i) { return data[i]; }
+    const Payload& payload(int i) const { return data[i]; }
+
+private:
+    int size;                          // the number of nodes
+    vector<Weight> cells;              // row i is cells[i * (size + 1)] ..
+    vector<Payload> data;              // the node information
+};
+
+// the scratch array of a search on FixedStorage<N>, on the stack
+template <class T, int N>
+struct FixedArray {
+    T item[N + 1];
+
+    GRAPH_CONSTEXPR explicit FixedArray(int) : item() {}
+    GRAPH_CONSTEXPR T& operator[](int i) { return item[i]; }
+    GRAPH_CONSTEXPR const T& operator[](int i) const { return item[i]; }
+};
+
+template <int N, class Weight, class Payload>
+class GraphStorage<FixedStorage<N>, Weight, Payload> {
+public:
+    static const bool dense = true;
+    template <class T> using Array = FixedArray<T, N>;
+
+    GRAPH_CONSTEXPR GraphStorage() : size(0), cells(), data() {}
+
+    // returns false, leaving the graph as it was, for more than N nodes
+    GRAPH_CONSTEXPR bool resize(int n) {
+        if (n < 0 || n > N) return false;
+        size = n;
+        for (int i = 0; i <= N; i++) {
+            for (int j = 0; j <= N; j++) cells[i][j] = Weight();
+            data[i] = Payload();
+        }
+        return true;
+    }
+
+    GRAPH_CONSTEXPR int getSize() const { return size; }
+
+    GRAPH_CONSTEXPR Weight getWeight(int i, int j) const {
+        return cells[i][j];
+    }
+
+    GRAPH_CONSTEXPR void setWeight(int i, int j, Weight weight) {
+        cells[i][j] = weight;
+    }
+
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        for (int j = 1; j <= size; j++) {
+            if (cells[i][j] != Weight()) f(j, cells[i][j]);
+        }
+    }
+
+    GRAPH_CONSTEXPR Payload& payload(int i) { return data[i]; }
+    GRAPH_CONSTEXPR const Payload& payload(int i) const { return data[i]; }
+
+private:
+    int size;                          // the number of nodes, at most N
+    Weight cells[N + 1][N + 1];        // the adjacency matrix
+    Payload data[N + 1];               // the node information
+};
+
+
+template <class Storage, class Weight = int, bool Directed = true,
+          class Payload = NoPayload>
+class Graph {
+public:
+    typedef GraphStorage<Storage, Weight, Payload> StorageType;
+    typedef decltype(Weight() + Weight()) Distance;
+
+    static GRAPH_CONSTEXPR Distance infinity() {
+        return numeric_limits<Distance>::max();
+    }
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class graph, a graph of no nodes
+    GRAPH_CONSTEXPR Graph() : store() {}
+
+//------------------------------ resize -------------------------------------
+// resize
+// a graph of the given number of nodes and no edges
+// returns false if the layout cannot hold that many
+    GRAPH_CONSTEXPR bool resize(int n) {
+        return store.resize(n);
+    }
+
+//---------------------------- insertEdge -----------------------------------
+// insertEdge
+// insert an edge into graph between two given nodes, or set its weight,
+// both ways for an undirected graph
+// returns false for a node outside 1 .. size or a weight not above 0
+    GRAPH_CONSTEXPR bool insertEdge(int i, int j, Weight weight) {
+        if (!inRange(i) || !inRange(j) || !(Weight() < weight)) return false;
+        store.setWeight(i, j, weight);
+        if (!Directed) store.setWeight(j, i, weight);
+        return true;
+    }
+
+//---------------------------- removeEdge -----------------------------------
+// removeEdge
+// remove an edge from graph between two given nodes
+// returns false for a node outside 1 .. size
+    GRAPH_CONSTEXPR bool removeEdge(int i, int j) {
+        if (!inRange(i) || !inRange(j)) return false;
+        store.setWeight(i, j, Weight());
+        if (!Directed) store.setWeight(j, i, Weight());
+        return true;
+    }
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// the shortest path from the source to every node: dist[v] is the
+// distance, infinity() if v cannot be reached, and path[v] the previous
+// node, 0 if none; both arrays are indexed 1 .. size
+// a matrix is searched as GraphM does, scanning for the nearest node;
+// a list is searched with a heap
+    GRAPH_CONSTEXPR void findShortestPath(int source, Distance dist[],
+                                          int path[]) const {
+        search(source, dist, path,
+               integral_constant<bool, StorageType::dense>());
+    }
+
+//---------------------------- forEachEdge ----------------------------------
+// forEachEdge
+// calls f(node, weight) for every edge leaving the given node
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        store.forEachEdge(i, f);
+    }
+
+//------------------------------ accessors ----------------------------------
+// getSize:    the number of nodes
+// getWeight:  the weight of the edge between two nodes, 0 if none
+// getData:    the node information of the given node
+// setData:    set the node information of the given node
+// isDirected: whether an edge goes one way only
+    GRAPH_CONSTEXPR int getSize() const { return store.getSize(); }
+    GRAPH_CONSTEXPR Weight getWeight(int i, int j) const {
+        return store.getWeight(i, j);
+    }
+    GRAPH_CONSTEXPR const Payload& getData(int i) const {
+        return store.payload(i);
+    }
+    GRAPH_CONSTEXPR void setData(int i, const Payload& data) {
+        store.payload(i) = data;
+    }
+    static GRAPH_CONSTEXPR bool isDirected() { return Directed; }
+
+private:
+    StorageType store;                 // the edges and node information
+
+    GRAPH_CONSTEXPR bool inRange(int i) const {
+        return i >= 1 && i <= store.getSize();
+    }
+
+//------------------------------- search ------------------------------------
+// search
+// Dijkstra's algorithm on a matrix: the nearest node not yet visited is
+// found by a scan, ties go to the smaller node, and its row is relaxed
+// in order of node, so the result equals GraphM's T
+// key is dist for the nodes not yet visited and infinity() for the rest,
+// so the scan reads one array and has no test of visited
+    GRAPH_CONSTEXPR void search(int source, Distance dist[], int path[],
+                                true_type) const {
+        int size = store.getSize();
+        typename StorageType::template Array<Distance> key(size + 1);
+        for (int v = 1; v <= size; v++) {
+            dist[v] = key[v] = infinity();
+            path[v] = 0;
+        }
+        if (!inRange(source)) return;
+        dist[source] = key[source] = Distance();
+
+        for (int step = 1; step <= size; step++) {
+            int v = 0;
+            Distance nearest = infinity();
+            for (int u = 1; u <= size; u++) {
+                if (key[u] < nearest) {
+                    nearest = key[u];
+                    v = u;
+                }
+            }
+            if (v == 0) break;           // the rest cannot be reached
+            key[v] = infinity();
+
+            // a visited node is no farther than nearest, so with weights
+            // above 0 it is never lowered and need not be skipped
+            for (int w = 1; w <= size; w++) {
+                Weight weight = store.getWeight(v, w);
+                if (weight != Weight() && nearest + weight < dist[w]) {
+                    dist[w] = key[w] = nearest + weight;
+                    path[w] = v;
+                }
+            }
+        }
+    }
+
+//------------------------------- search ------------------------------------
+// search
+// Dijkstra's algorithm on lists, with a binary heap of (distance, node);
+// an entry whose distance is out of date is skipped when it comes out
+    void search(int source, Distance dist[], int path[], false_type) const {
+        int size = store.getSize();
+        for (int v = 1; v <= size; v++) {
+            dist[v] = infinity();
+            path[v] = 0;
+        }
+        if (!inRange(source)) return;
+        dist[source] = Distance();
+
+        typedef pair<Distance, int> Entry;
+        priority_queue<Entry, vector<Entry>, greater<Entry> > heap;
+        heap.push(Entry(Distance(), source));
+        while (!heap.empty()) {
+            Entry top = heap.top();
+            heap.pop();
+            int v = top.second;
+            if (top.first != dist[v]) continue;
+            const vector<GraphEdge<Weight> >& list = store.edges(v);
+            for (size_t e = 0; e < list.size(); e++) {
+                int w = list[e].to;
+                Distance through = top.first + list[e].weight;
+                if (through < dist[w]) {
+                    dist[w] = through;
+                    path[w] = v;
+                    heap.push(Entry(through, w));
+                }
+            }
+        }
+    }
+};
+#endif
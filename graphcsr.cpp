@@ -0,0 +1,280 @@
+//---------------------------------------------------------------------------
+// graphcsr.cpp
+// Simple class graphcsr
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphcsr class:  the graph implementation
+//   for depth-first search and Dijkstra's shortest path algorithm
+//   by using compressed sparse row storage (offsets and neighbor arrays)
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size, no fixed limit on the number of nodes
+//   -- edges with an end outside 1 .. size are ignored
+//---------------------------------------------------------------------------
+#include <sstream>
+#include "graphcsr.h"
+#include "nodedata.h"
+#include "depthfirst.h"
+#include "resultwriter.h"
+#include "stats.h"
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class graphcsr
+GraphCSR::GraphCSR() : size(0) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class graphcsr
+GraphCSR::~GraphCSR() {
+    makeEmpty();
+} // end of Destructor
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up graph node information and
+// the offsets and neighbor arrays reading from a data file
+// the edges are collected first so the arrays can be sized exactly
+void GraphCSR::buildGraph(istream& infile) {
+    STATS_TIMER(BUILD_GRAPH);
+    int fromNode, toNode;            // from and to node ends of edge
+    int nodes;                       // the number of nodes
+
+    makeEmpty();                     // clear the graph of memory
+
+    infile >> nodes;                 // read the number of nodes
+    if (infile.eof()) return;        // stop if no more data
+    string s;                        // used to read through to end of line
+    getline(infile, s);
+
+    // read graph node information
+    vector<NodeData> nodeData(nodes + 1);
+    for (int i = 1; i <= nodes; i++) {
+        getline(infile, s);
+        nodeData[i].setData(s);
+    }
+
+    // read the edge data
+    vector<int> from, to;
+    for (;;) {
+        infile >> fromNode >> toNode;
+        if (infile.fail() || (fromNode == 0 && toNode == 0)) {
+            break;      // end of edge data
+        }
+        from.push_back(fromNode);
+        to.push_back(toNode);
+    }
+
+    assign(nodes, from, to);
+    data.swap(nodeData);
+} // end of buildGraph
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader,
+// weighted if the loader read the GraphM format (zero weights dropped)
+void GraphCSR::buildGraph(const GraphLoader& loader) {
+    STATS_TIMER(BUILD_GRAPH);
+    int nodes = loader.getSize();
+    const vector<int>& weight = loader.getWeight();
+    if (weight.empty()) {
+        assign(nodes, loader.getFrom(), loader.getTo());
+    }
+    else {
+        vector<int> from, to, cost;
+        for (size_t e = 0; e < weight.size(); e++) {
+            if (weight[e] <= 0) continue;
+            from.push_back(loader.getFrom()[e]);
+            to.push_back(loader.getTo()[e]);
+            cost.push_back(weight[e]);
+        }
+        assign(nodes, from, to, cost);
+    }
+    for (int i = 1; i <= nodes; i++) {
+        TextSlice line = loader.getDescription(i);
+        data[i].setData(string(line.text, line.length));
+    }
+} // end of buildGraph
+
+//------------------------- buildWeightedGraph ------------------------------
+// buildWeightedGraph
+// builds up graph node information and
+// the offsets, neighbor and weight arrays reading from a data file
+// (same format as GraphM::buildGraph, a zero weight means no edge)
+void GraphCSR::buildWeightedGraph(istream& infile) {
+    STATS_TIMER(BUILD_GRAPH);
+    int fromNode, toNode, weight;    // from and to node ends of edge
+    int nodes;                       // the number of nodes
+
+    makeEmpty();                     // clear the graph of memory
+
+    infile >> nodes;                 // read the number of nodes
+    if (infile.eof()) return;        // stop if no more data
+    string s;                        // used to read through to end of line
+    getline(infile, s);
+
+    // read graph node information
+    vector<NodeData> nodeData(nodes + 1);
+    for (int i = 1; i <= nodes; i++) {
+        getline(infile, s);
+        nodeData[i].setData(s);
+    }
+
+    // read the edge data
+    vector<int> from, to, cost;
+    for (;;) {
+        infile >> fromNode >> toNode >> weight;
+        if (infile.fail() || (fromNode == 0 && toNode == 0 && weight == 0)) {
+            break;      // end of edge data
+        }
+        if (weight <= 0) continue;
+        from.push_back(fromNode);
+        to.push_back(toNode);
+        cost.push_back(weight);
+    }
+
+    assign(nodes, from, to, cost);
+    data.swap(nodeData);
+} // end of buildWeightedGraph
+
+//------------------------------ assign -------------------------------------
+// assign
+// builds the offsets and neighbor arrays from a list of edges
+// in two passes: count the out-degree of each node, then place each edge
+// edges of one node are stored in reverse input order, like GraphL
+void GraphCSR::assign(int nodes, const vector<int>& from,
+                      const vector<int>& to) {
+    assign(nodes, from, to, vector<int>());
+} // end of assign
+
+//------------------------------ assign -------------------------------------
+// assign
+// as above, also placing the weight of each edge
+// an empty weight list builds an unweighted graph
+void GraphCSR::assign(int nodes, const vector<int>& from,
+                      const vector<int>& to, const vector<int>& weight) {
+    makeEmpty();
+    size = nodes;
+    data.resize(size + 1);
+    offsets.assign(size + 2, 0);
+    bool weighted = !weight.empty();
+
+    // first pass: count the edges leaving each node
+    for (size_t e = 0; e < from.size(); e++) {
+        if (from[e] >= 1 && from[e] <= size && to[e] >= 1 && to[e] <= size) {
+            offsets[from[e] + 1]++;
+        }
+    }
+    for (int i = 1; i <= size; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // second pass: fill each row from its end, so the last edge read
+    // comes first, the same order as inserting at the head of a list
+    neighbors.resize(offsets[size + 1]);
+    if (weighted) weights.resize(offsets[size + 1]);
+    vector<long long> next(offsets.begin() + 1, offsets.end());
+    for (size_t e = 0; e < from.size(); e++) {
+        if (from[e] >= 1 && from[e] <= size && to[e] >= 1 && to[e] <= size) {
+            long long pos = --next[from[e]];
+            neighbors[pos] = to[e];
+            if (weighted) weights[pos] = weight[e];
+        }
+    }
+    STATS_ADD(BYTES_ALLOCATED,
+              (long long)(offsets.size() * sizeof(long long)
+                          + (neighbors.size() + weights.size()) * sizeof(int)));
+} // end of assign
+
+//--------------------------- displayGraph ----------------------------------
+// displayGraph
+// display each node information and edge in the graph
+// written to cout through a ResultWriter, in large blocks
+void GraphCSR::displayGraph() const {
+    STATS_TIMER(DISPLAY);
+    ResultWriter out(cout);
+    out.put("Graph:\n");
+    for (int i = 1; i <= size; i++) {
+
+        // display the gernal information of the node
+        ostringstream description;
+        description << data[i];
+        out.put("Node");
+        out.putInt(i);
+        out.put("        ");
+        out.put(description.str());
+        out.put('\n');
+        for (const int* e = edgeBegin(i); e != edgeEnd(i); e++) {
+            out.put("  edge ");
+            out.putInt(i);
+            out.put("  ");
+            out.putInt(*e);
+            out.put('\n');
+        }
+    }
+    out.put('\n');
+} // end of displayGraph
+
+//-------------------------- depthFirstSearch -------------------------------
+// depthFirstSearch
+// displays each node in depth-first order
+// uses the DepthFirst class, which keeps its own stack and visited
+// flags, so deep graphs cannot overflow the call stack
+void GraphCSR::depthFirstSearch() const {
+    ResultWriter out(cout);
+    out.put("Depth-first ordering:");
+    DepthFirst search(*this);
+    const vector<int>& order = search.preorder();
+    for (size_t i = 0; i < order.size(); i++) {
+        out.put("  ");
+        out.putInt(order[i]);
+    }
+    out.put("\n\n");
+} // end of depthFirstSearch
+
+//------------------------------ makeEmpty ----------------------------------
+// makeEmpty
+// Empty the graph, deallocate all the memory
+void GraphCSR::makeEmpty() {
+    vector<long long>().swap(offsets);
+    vector<int>().swap(neighbors);
+    vector<int>().swap(weights);
+    vector<NodeData>().swap(data);
+    size = 0;
+} // end of makeEmpty
+
+//------------------------------ accessors ----------------------------------
+int GraphCSR::getSize() const {
+    return size;
+}
+
+long long GraphCSR::getEdgeCount() const {
+    return neighbors.size();
+}
+
+int GraphCSR::degree(int i) const {
+    return (int)(offsets[i + 1] - offsets[i]);
+}
+
+const int* GraphCSR::edgeBegin(int i) const {
+    return neighbors.data() + offsets[i];
+}
+
+const int* GraphCSR::edgeEnd(int i) const {
+    return neighbors.data() + offsets[i + 1];
+}
+
+const int* GraphCSR::weightBegin(int i) const {
+    return weights.empty() ? NULL : weights.data() + offsets[i];
+}
+
+bool GraphCSR::isWeighted() const {
+    return !weights.empty();
+}
+
+const NodeData& GraphCSR::getData(int i) const {
+    return data[i];
+}
+
+void GraphCSR::setData(int i, const NodeData& nd) {
+    data[i] = nd;
+}
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------
+// graphcsr.h
+// Simple class graphcsr
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphcsr class:  the graph implementation
+//   for depth-first search and Dijkstra's shortest path algorithm
+//   by using compressed sparse row storage (offsets and neighbor arrays)
+//
+// The edges of node i are neighbors[offsets[i]] .. neighbors[offsets[i+1]-1]
+// so a traversal walks one contiguous array instead of chasing EdgeNodes.
+// Reads the same data file format as GraphL and displays the same output.
+// A weighted graph reads the GraphM format and keeps a weights array
+// parallel to the neighbor array; an unweighted graph has weight 1 edges.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size, no fixed limit on the number of nodes
+//   -- edges with an end outside 1 .. size are ignored
+//---------------------------------------------------------------------------
+#ifndef GRAPHCSR_H
+#define GRAPHCSR_H
+#include <vector>
+#include "nodedata.h"
+#include "graphloader.h"
+
+
+class GraphCSR {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class graphcsr
+    GraphCSR();
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class graphcsr
+    ~GraphCSR();
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up graph node information and
+// the offsets and neighbor arrays reading from a data file
+// (same format as GraphL::buildGraph)
+    void buildGraph(istream&);
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader,
+// weighted if the loader read the GraphM format
+    void buildGraph(const GraphLoader&);
+
+//------------------------- buildWeightedGraph ------------------------------
+// buildWeightedGraph
+// builds up graph node information and
+// the offsets, neighbor and weight arrays reading from a data file
+// (same format as GraphM::buildGraph, a zero weight means no edge)
+    void buildWeightedGraph(istream&);
+
+//------------------------------ assign -------------------------------------
+// assign
+// builds the offsets and neighbor arrays from a list of edges
+// in two passes: count the out-degree of each node, then place each edge
+// edges of one node are stored in reverse input order, like GraphL
+    void assign(int, const vector<int>&, const vector<int>&);
+    void assign(int, const vector<int>&, const vector<int>&,
+                const vector<int>&);
+
+//--------------------------- displayGraph ----------------------------------
+// displayGraph
+// display each node information and edge in the graph
+    void displayGraph() const;
+
+//-------------------------- depthFirstSearch -------------------------------
+// depthFirstSearch
+// displays each node in depth-first order
+    void depthFirstSearch() const;
+
+//------------------------------ makeEmpty ----------------------------------
+// makeEmpty
+// Empty the graph, deallocate all the memory
+    void makeEmpty();
+
+//------------------------------ accessors ----------------------------------
+// getSize:      the number of nodes
+// getEdgeCount: the number of edges
+// degree:       the number of edges leaving the given node
+// edgeBegin:    pointer to the first neighbor of the given node
+// edgeEnd:      pointer past the last neighbor of the given node
+// weightBegin:  pointer to the weight of the first edge of the given node,
+//               parallel to edgeBegin, NULL when the graph is unweighted
+// isWeighted:   whether the graph keeps edge weights
+// getData:      the node information of the given node
+// setData:      set the node information of the given node
+    int getSize() const;
+    long long getEdgeCount() const;
+    int degree(int) const;
+    const int* edgeBegin(int) const;
+    const int* edgeEnd(int) const;
+    const int* weightBegin(int) const;
+    bool isWeighted() const;
+    const NodeData& getData(int) const;
+    void setData(int, const NodeData&);
+
+private:
+    int size;                    // the number of nodes
+    vector<long long> offsets;   // offsets[i] is the first edge of node i
+    vector<int> neighbors;       // adjacent nodes of every edge, by node
+    vector<int> weights;         // weight of every edge, empty if unweighted
+    vector<NodeData> data;       // data information about each node
+
+    friend class CSRView;        // reads the arrays in place
+};
+#endif
@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------
+// graphgen.cpp
+// Simple class graphgen
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphgen class:  synthetic graphs in the data file format, for
+//   benchmarks and for trying the graphs on inputs larger than the labs'
+//
+// Assumptions:
+//   -- no edge goes from a node to itself; an edge may be repeated
+//---------------------------------------------------------------------------
+#include "graphgen.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class graphgen
+GraphGen::GraphGen(unsigned long long seed, int largest)
+    : state(seed), maxWeight(largest < 1 ? 1 : largest), size(0) {
+} // end of Constructor
+
+//------------------------------- rmat --------------------------------------
+// rmat
+// an R-MAT graph: for each edge, halve the rows and the columns once per
+// bit of the node numbers, choosing a quarter each time; an edge landing
+// outside 1 .. size or on its own node is drawn again
+void GraphGen::rmat(int nodes, long long edges, double a, double b,
+                    double c) {
+    clear(nodes);
+    if (nodes < 2) return;
+    int bits = 0;
+    while ((1LL << bits) < nodes) bits++;
+
+    while ((long long)from.size() < edges) {
+        long long row = 0, column = 0;
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            double r = uniform();
+            if (r < a) {
+                // upper left, neither bit set
+            }
+            else if (r < a + b) {
+                column |= 1LL << bit;
+            }
+            else if (r < a + b + c) {
+                row |= 1LL << bit;
+            }
+            else {
+                row |= 1LL << bit;
+                column |= 1LL << bit;
+            }
+        }
+        if (row >= nodes || column >= nodes || row == column) continue;
+        addEdge((int)row + 1, (int)column + 1);
+    }
+
+    // number the nodes in a random order, so the nodes of high degree
+    // are not all at the front
+    vector<int> order(nodes + 1);
+    for (int i = 0; i <= nodes; i++) order[i] = i;
+    for (int i = nodes; i > 1; i--) {
+        int j = 1 + (int)uniform(i);
+        int t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (size_t e = 0; e < from.size(); e++) {
+        from[e] = order[from[e]];
+        to[e] = order[to[e]];
+    }
+} // end of rmat
+
+//------------------------------- grid --------------------------------------
+// grid
+// node (r, c) is r * columns + c + 1; each link to the right and down is
+// kept with the given probability and then goes both ways
+void GraphGen::grid(int rows, int columns, double keep) {
+    clear(rows * columns);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            int node = r * columns + c + 1;
+            if (c + 1 < columns && uniform() < keep) {
+                addEdge(node, node + 1);
+                addEdge(node + 1, node);
+            }
+            if (r + 1 < rows && uniform() < keep) {
+                addEdge(node, node + columns);
+                addEdge(node + columns, node);
+            }
+        }
+    }
+} // end of grid
+
+//---------------------------- erdosRenyi -----------------------------------
+// erdosRenyi
+// each edge between two different nodes chosen uniformly
+void GraphGen::erdosRenyi(int nodes, long long edges) {
+    clear(nodes);
+    if (nodes < 2) return;
+    while ((long long)from.size() < edges) {
+        int i = 1 + (int)uniform(nodes);
+        int j = 1 + (int)uniform(nodes);
+        if (i != j) addEdge(i, j);
+    }
+} // end of erdosRenyi
+
+//------------------------------- write -------------------------------------
+// write
+// the graph in the data file format, to the stream
+void GraphGen::write(ostream& out, bool weighted) const {
+    ResultWriter writer(out);
+    put(writer, weighted);
+} // end of write
+
+//------------------------------- write -------------------------------------
+// write
+// the graph in the data file format, to the named file
+bool GraphGen::write(const char* name, bool weighted) const {
+    ResultWriter writer;
+    if (!writer.open(name)) return false;
+    put(writer, weighted);
+    return writer.close();
+} // end of write
+
+//------------------------------- put ---------------------------------------
+// put
+// writes the graph to the writer
+void GraphGen::put(ResultWriter& out, bool weighted) const {
+    out.putInt(size);
+    out.put('\n');
+    for (int i = 1; i <= size; i++) {
+        out.put("node ");
+        out.putInt(i);
+        out.put('\n');
+    }
+    for (size_t e = 0; e < from.size(); e++) {
+        out.putInt(from[e]);
+        out.put(' ');
+        out.putInt(to[e]);
+        if (weighted) {
+            out.put(' ');
+            out.putInt(weight[e]);
+        }
+        out.put('\n');
+    }
+    out.put(weighted ? "0 0 0\n" : "0 0\n");
+} // end of put
+
+//------------------------------- next --------------------------------------
+// next
+// the next random number of splitmix64
+unsigned long long GraphGen::next() {
+    unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+} // end of next
+
+//------------------------------ uniform ------------------------------------
+// uniform
+// the top 53 bits of a random number as a double in [0, 1)
+double GraphGen::uniform() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+} // end of uniform
+
+//------------------------------ uniform ------------------------------------
+// uniform
+// a random number in 0 .. n-1, the high half of a 128-bit product
+long long GraphGen::uniform(long long n) {
+    return (long long)(((unsigned __int128)next() * (unsigned long long)n)
+                       >> 64);
+} // end of uniform
+
+//----------------------------- addEdge -------------------------------------
+// addEdge
+// adds an edge with a random weight in 1 .. maxWeight
+void GraphGen::addEdge(int i, int j) {
+    from.push_back(i);
+    to.push_back(j);
+    weight.push_back(1 + (int)uniform(maxWeight));
+} // end of addEdge
+
+//------------------------------- clear -------------------------------------
+// clear
+// no nodes and no edges
+void GraphGen::clear(int nodes) {
+    size = nodes < 0 ? 0 : nodes;
+    from.clear();
+    to.clear();
+    weight.clear();
+} // end of clear
+
+//------------------------------ accessors ----------------------------------
+int GraphGen::getSize() const {
+    return size;
+}
+
+long long GraphGen::getEdgeCount() const {
+    return from.size();
+}
+
+const vector<int>& GraphGen::getFrom() const {
+    return from;
+}
+
+const vector<int>& GraphGen::getTo() const {
+    return to;
+}
+
+const vector<int>& GraphGen::getWeight() const {
+    return weight;
+}
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------
+// graphgen.h
+// Simple class graphgen
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphgen class:  synthetic graphs in the data file format, for
+//   benchmarks and for trying the graphs on inputs larger than the labs'
+//
+// Three kinds of graph:
+//   -- rmat:       R-MAT, each edge placed by choosing one quarter of the
+//                  matrix at a time with probabilities a, b, c and d,
+//                  which gives the skewed degrees of a social network;
+//                  the nodes are then numbered in a random order
+//   -- grid:       rows by columns, each node joined both ways to its
+//                  right and lower neighbors, with some of the links left
+//                  out at random, like a road map
+//   -- erdosRenyi: the given number of edges between nodes chosen
+//                  uniformly at random
+// Each edge gets a weight in 1 .. maxWeight.  The random numbers come
+// from a splitmix64 generator of the given seed, and every number drawn
+// from it is computed by hand, so the same seed gives the same graph on
+// every platform and library.  write gives the format read by
+// GraphL::buildGraph, or the format of GraphM::buildGraph if weighted.
+//
+// Assumptions:
+//   -- no edge goes from a node to itself; an edge may be repeated
+//---------------------------------------------------------------------------
+#ifndef GRAPHGEN_H
+#define GRAPHGEN_H
+#include <iostream>
+#include <vector>
+#include "resultwriter.h"
+using namespace std;
+
+
+class GraphGen {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class graphgen
+// the seed of the random numbers and the largest weight
+    explicit GraphGen(unsigned long long = 1, int = 100);
+
+//------------------------------- rmat --------------------------------------
+// rmat
+// an R-MAT graph of the given numbers of nodes and edges, with the
+// probabilities a, b and c of the upper left, upper right and lower left
+// quarters (d is the rest); the defaults are those of Graph500
+    void rmat(int, long long, double = 0.57, double = 0.19, double = 0.19);
+
+//------------------------------- grid --------------------------------------
+// grid
+// a grid of the given numbers of rows and columns, each link between
+// neighbors kept with the given probability
+    void grid(int, int, double = 0.9);
+
+//---------------------------- erdosRenyi -----------------------------------
+// erdosRenyi
+// the given numbers of nodes and edges, each edge between two different
+// nodes chosen uniformly
+    void erdosRenyi(int, long long);
+
+//------------------------------- write -------------------------------------
+// write
+// the graph in the data file format: the number of nodes, a line
+// "node i" for each, then the edges and the all-zero edge; with weights
+// (the GraphM format) if the second argument is true
+    void write(ostream&, bool) const;
+
+//------------------------------- write -------------------------------------
+// write
+// as above, to the named file; returns false if it cannot be written
+    bool write(const char*, bool) const;
+
+//------------------------------ accessors ----------------------------------
+// getSize:      the number of nodes
+// getEdgeCount: the number of edges
+// getFrom, getTo, getWeight: the ends and the weight of every edge
+    int getSize() const;
+    long long getEdgeCount() const;
+    const vector<int>& getFrom() const;
+    const vector<int>& getTo() const;
+    const vector<int>& getWeight() const;
+
+private:
+    unsigned long long state;     // the state of the random numbers
+    int maxWeight;                // weights are 1 .. maxWeight
+    int size;                     // the number of nodes
+    vector<int> from, to, weight; // the edges
+
+//------------------------------- next --------------------------------------
+// next
+// the next random number of splitmix64
+    unsigned long long next();
+
+//------------------------------ uniform ------------------------------------
+// uniform
+// a random number in [0, 1), or in 0 .. n-1
+    double uniform();
+    long long uniform(long long);
+
+//----------------------------- addEdge -------------------------------------
+// addEdge
+// adds an edge with a random weight
+    void addEdge(int, int);
+
+//------------------------------- put ---------------------------------------
+// put
+// writes the graph to the writer, as write
+    void put(ResultWriter&, bool) const;
+
+//------------------------------- clear -------------------------------------
+// clear
+// no nodes and no edges, ready for a graph of the given size
+    void clear(int);
+};
+#endif
@@ -8,10 +8,16 @@
 //   by using adjacency list (array of lists)
 //
 // Assumptions:
-//   -- no more than 100 nodes
+//   -- nodes are numbered 1 .. size; the array of lists is made in the
+//      arena with size+1 entries, so any number of nodes fits
 //---------------------------------------------------------------------------
 #include "graphl.h"
 #include "nodedata.h"
+#include "depthfirst.h"
+#include "resultwriter.h"
+#include "stats.h"
+#include <algorithm>
+#include <sstream>
 // Uses getline from string class, included in nodedata.h .
 // Be sure to include nodedata.h which includes <string> .
 // If you use dynamic memory (you don't use STL list), the makeEmpty()
@@ -20,7 +26,7 @@
 
 //-------------------------- Constructor ------------------------------------
 // Default constructor for class graphl
-GraphL::GraphL() {
+GraphL::GraphL() : size(0) {
     //adjList = new GraphNode[size]{ NULL };
 } // end of Constructor
 
@@ -37,23 +43,28 @@ GraphL::~GraphL() {
 // adjacency list of edges between each node reading from a data file
 // the edgenode is inserted at the beginnig of adjacency list
 void GraphL::buildGraph(istream& infile) {
+    STATS_TIMER(BUILD_GRAPH);
     int fromNode, toNode;            // from and to node ends of edge
 
     makeEmpty();                     // clear the graph of memory 
 
     infile >> size;                  // read the number of nodes
-    if (infile.eof()) return;        // stop if no more data
+    if (infile.eof()) {              // stop if no more data
+        size = 0;
+        return;
+    }
     string s;                        // used to read through to end of line
     getline(infile, s);
+    makeList();
 
     // read graph node information
     for (int i = 1; i <= size; i++) {
         getline(infile, s);
-        GraphNode* ptr = new GraphNode(); // create a GraphNode
+        GraphNode* ptr = arena.make<GraphNode>(); // create a GraphNode
 
         // initialized the adjacency list head to null
         ptr -> edgeHead = NULL;           
-        ptr->data.setData(s);
+        ptr->description = descriptions.intern(s);
         adjList[i] = ptr;
 
         //(*adjList[i]).data.setData(s);
@@ -68,13 +79,16 @@ void GraphL::buildGraph(istream& infile) {
     for (;;) {
         infile >> fromNode >> toNode;
         if (fromNode == 0 && toNode == 0) {
+            STATS_ADD(BYTES_ALLOCATED,
+                      (long long)(arena.getUsed() + descriptions.getBytes()));
+            buildSearch();
             return;     // end of edge data
         }
 
         // insert the edge into the adjacency list for fromNode
         // if the adjacency list is empty
         if (adjList[fromNode]->edgeHead == NULL) {
-            EdgeNode* edgePtr = new EdgeNode();
+            EdgeNode* edgePtr = arena.make<EdgeNode>();
             edgePtr->nextEdge = NULL;
             edgePtr->adjGraphNode = toNode;
             adjList[fromNode]->edgeHead = edgePtr;
@@ -84,7 +98,7 @@ void GraphL::buildGraph(istream& infile) {
         // insert EdgeNodes at the beginning of the adjacency list
         else {
             EdgeNode* current = adjList[fromNode]->edgeHead;
-            EdgeNode* edgePtr = new EdgeNode();
+            EdgeNode* edgePtr = arena.make<EdgeNode>();
             edgePtr->nextEdge = current;
             edgePtr->adjGraphNode = toNode;
             adjList[fromNode]->edgeHead = edgePtr;
@@ -93,94 +107,173 @@ void GraphL::buildGraph(istream& infile) {
 } // end of buildGraph
 
 
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader (GraphL format)
+// the edgenode is inserted at the beginnig of adjacency list
+// the edges with a node outside 1 .. size are ignored
+void GraphL::buildGraph(const GraphLoader& loader) {
+    STATS_TIMER(BUILD_GRAPH);
+    makeEmpty();                     // clear the graph of memory 
+    size = loader.getSize();
+    makeList();
+
+    // read graph node information
+    for (int i = 1; i <= size; i++) {
+        GraphNode* ptr = arena.make<GraphNode>(); // create a GraphNode
+        TextSlice line = loader.getDescription(i);
+        ptr->edgeHead = NULL;
+        ptr->description = descriptions.intern(line.text, line.length);
+        adjList[i] = ptr;
+    }
+
+    // add the edges to the adjacency list
+    const vector<int>& from = loader.getFrom();
+    const vector<int>& to = loader.getTo();
+    for (size_t e = 0; e < from.size(); e++) {
+        if (from[e] < 1 || from[e] > size || to[e] < 1 || to[e] > size) {
+            continue;
+        }
+        EdgeNode* edgePtr = arena.make<EdgeNode>();
+        edgePtr->nextEdge = adjList[from[e]]->edgeHead;
+        edgePtr->adjGraphNode = to[e];
+        adjList[from[e]]->edgeHead = edgePtr;
+    }
+    STATS_ADD(BYTES_ALLOCATED,
+              (long long)(arena.getUsed() + descriptions.getBytes()));
+    buildSearch();
+} // end of buildGraph
+
+
 //--------------------------- displayGraph ----------------------------------
 // displayGraph
 // display each node information and edge in the graph
+// written to cout through a ResultWriter, in large blocks instead of one
+// flush per line
 void GraphL::displayGraph() const {
-    cout << "Graph:" << endl;
+    STATS_TIMER(DISPLAY);
+    ResultWriter out(cout);
+    out.put("Graph:\n");
     for (int i = 1; i <= size; i++) {
 
         // display the gernal information of GraphNode
-        cout << "Node" << i << "        " << adjList[i]->data << endl;
-        EdgeNode* current = adjList[i]->edgeHead;
-        //if (current != NULL) {
-        //    displayGraphHelper(current, i);
-        //}
-        
+        ostringstream description;
+        description << getData(i);
+        out.put("Node");
+        out.putInt(i);
+        out.put("        ");
+        out.put(description.str());
+        out.put('\n');
+
         // when the adjacency list is not end, display it
-        while(current != NULL) {
-            cout << "  edge " << i << "  " << current->adjGraphNode<< endl;
-            current = current->nextEdge;
+        for (EdgeNode* current = adjList[i]->edgeHead; current != NULL;
+                current = current->nextEdge) {
+            out.put("  edge ");
+            out.putInt(i);
+            out.put("  ");
+            out.putInt(current->adjGraphNode);
+            out.put('\n');
         }
     }
-    cout << endl;
-
+    out.put('\n');
 } // end of displayGraph
 
 //-------------------------- depthFirstSearch -------------------------------
 // depthFirstSearch
-// makes a depth-first search by using depthFirstSearchHelper
 // displays each node in depth-first order
+// searches the GraphCSR copy of the edges with the kept DepthFirst, whose
+// visited stamps start a new search in O(1); the lock lets threads take
+// turns on it, and the order goes to cout through a ResultWriter
 void GraphL::depthFirstSearch() const {
-    cout << "Depth-first ordering:";
-
-    for (int i = 1; i <= size; i++) {  // go through each GraphNode
-        if ( !adjList[i]->visited) {   // if it's not visited
-            depthFirstSearchHelper(i); // perform depthFirstSearch
+    lock_guard<mutex> hold(searchLock);
+    ResultWriter out(cout);
+    out.put("Depth-first ordering:");
+    if (search) {
+        const vector<int>& order = search->preorder();
+        for (size_t i = 0; i < order.size(); i++) {
+            out.put("  ");
+            out.putInt(order[i]);
         }
     }
-    cout << endl << endl;
+    out.put("\n\n");
 } // end of depthFirstSearch
 
+//------------------------------ buildCSR -----------------------------------
+// buildCSR
+// copies the node information and the edges into a GraphCSR,
+// keeping the order of each adjacency list
+void GraphL::buildCSR(GraphCSR& graph) const {
+    buildEdges(graph);
+    for (int i = 1; i <= size; i++) {
+        graph.setData(i, getData(i));
+    }
+} // end of buildCSR
 
-//----------------------- depthFirstSearchHelper ----------------------------
-// depthFirstSearchHelper
-// a helper function to perform depth-first search
-// displays each node in depth-first order
-void GraphL::depthFirstSearchHelper(int i) const {
-    adjList[i]->visited = true;   // set the GraphNode to visited
-    cout << "  " << i;
-    EdgeNode* current = adjList[i]->edgeHead;
-    
-    // go through the adjacency node
-    while (current != NULL) {     
-        int adjNode = current->adjGraphNode;
-
-        // if the adjacency node is not visited
-        if (!adjList[adjNode]->visited) {  
-            // perform depth-first search
-            return depthFirstSearchHelper(adjNode);
+
+//------------------------------ buildEdges ---------------------------------
+// buildEdges
+// copies only the edges into a GraphCSR, in the order of each list
+// GraphCSR::assign reverses the order of each row, so the edges
+// are given to it last list entry first
+void GraphL::buildEdges(GraphCSR& graph) const {
+    vector<int> from, to;
+    for (int i = 1; i <= size; i++) {
+        for (EdgeNode* e = adjList[i]->edgeHead; e != NULL; e = e->nextEdge) {
+            from.push_back(i);
+            to.push_back(e->adjGraphNode);
         }
-        break;
     }
-} // end of depthFirstSearchHelper
+    reverse(from.begin(), from.end());
+    reverse(to.begin(), to.end());
+    graph.assign(size, from, to);
+} // end of buildEdges
+
+
+//----------------------------- buildSearch ---------------------------------
+// buildSearch
+// copies the edges into graph and makes the DepthFirst on it
+void GraphL::buildSearch() {
+    buildEdges(graph);
+    search.reset(new DepthFirst(graph));
+} // end of buildSearch
+
+
+//------------------------------- getData -----------------------------------
+// getData
+// the node information of the given node, from the string pool
+NodeData GraphL::getData(int i) const {
+    return NodeData(descriptions.getString(adjList[i]->description));
+} // end of getData
+
+
+//------------------------------- makeList ----------------------------------
+// makeList
+// makes adjList in the arena with an entry for each of nodes 0 .. size,
+// all NULL until the GraphNodes are made
+void GraphL::makeList() {
+    size = max(size, 0);
+    adjList = static_cast<GraphNode**>(arena.allocate(
+        (size_t)(size + 1) * sizeof(GraphNode*), alignof(GraphNode*)));
+    for (int i = 0; i <= size; i++) {
+        adjList[i] = NULL;
+    }
+} // end of makeList
+
 
 //------------------------------ makeEmpty ----------------------------------
 // makeEmpty
 // Empty the adjacency list, deallocate all the memory
 void GraphL::makeEmpty() {
 
-    // go through GraphNode by GraphNode
-    for (int i = 1; i <= size; i++) {
+    // the GraphNodes and EdgeNodes are all in the arena, and the node
+    // information in the string pool, so they are freed at once and
+    // their memory is reused by the next buildGraph
+    adjList = NULL;
+    arena.reset();
+    descriptions.clear();
+    search.reset();
+    graph.makeEmpty();
 
-        // when there's adjacency node
-        if (adjList[i]->edgeHead != NULL) {
-            EdgeNode* current = adjList[i]->edgeHead;
-            
-            // make the list empty
-            while (current->nextEdge != NULL) {
-                adjList[i]->edgeHead = current->nextEdge;
-				// delete the EdgeNode
-                delete current;
-                current = adjList[i]->edgeHead;
-            }
-            delete current;
-            adjList[i]->edgeHead = NULL;
-        }
-		// delete the GraphNode
-        delete adjList[i];
-        adjList[i] = NULL;
-    }
 	// set the size to zero
     size = 0;
     return;
@@ -8,21 +8,30 @@
 //   by using adjacency list (array of lists)
 //
 // Assumptions:
-//   -- no more than 100 nodes
+//   -- nodes are numbered 1 .. size; the array of lists is made in the
+//      arena with size+1 entries, so any number of nodes fits
+//   -- buildGraph and makeEmpty are not called while another thread uses
+//      the graph; the const functions may run on several threads at once,
+//      depthFirstSearch taking turns on the one DepthFirst of the graph
 //---------------------------------------------------------------------------
 #ifndef GRAPHL_H
 #define GRAPHL_H
 #include "nodedata.h"
+#include "graphloader.h"
+#include <memory>
+#include <mutex>
+#include "graphcsr.h"
+#include "depthfirst.h"
+#include "arena.h"
+#include "stringpool.h"
 
 
 struct EdgeNode;      // store edge info
 
 struct GraphNode {
     EdgeNode* edgeHead;   // head of the list of edges
-    NodeData data;        // data information about each node
-
-	// for depth-first search to see wheather the node is visited
-    bool visited = false; 
+    int description;      // data information about each node,
+                          // its number in the string pool
 };
 
 
@@ -52,6 +61,11 @@ public:
 // the edgenode is inserted at the beginnig of adjacency list 
     void buildGraph(istream&);
 
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader (GraphL format)
+    void buildGraph(const GraphLoader&);
+
 //--------------------------- displayGraph ----------------------------------
 // displayGraph
 // display each node information and edge in the graph
@@ -59,28 +73,56 @@ public:
 
 //-------------------------- depthFirstSearch -------------------------------
 // depthFirstSearch
-// makes a depth-first search by using depthFirstSearchHelper
 // displays each node in depth-first order
+// searches the GraphCSR of the edges that buildGraph makes, with a
+// DepthFirst kept from one search to the next
     void depthFirstSearch() const;
 
 
+//------------------------------ buildCSR -----------------------------------
+// buildCSR
+// copies the node information and the edges into a GraphCSR,
+// keeping the order of each adjacency list
+    void buildCSR(GraphCSR&) const;
+
 //------------------------------ makeEmpty ----------------------------------
 // makeEmpty
 // Empty the adjacency list, deallocate all the memory
+// the nodes are in an arena, so this does not walk the lists
     void makeEmpty();
 
     //void displayGraphHelper(EdgeNode*, int &);
 
 private:
     int size;                         // the number of nodes
-    GraphNode *adjList[100]{ NULL };  // array of GraphNodes
-
+    GraphNode **adjList = NULL;       // array of GraphNodes, in arena
+    Arena arena;                      // the GraphNodes and EdgeNodes
+    StringPool descriptions;          // the node information
+    GraphCSR graph;                   // the edges, made by buildGraph
+    unique_ptr<DepthFirst> search;    // searches graph, NULL when empty
+    mutable mutex searchLock;         // one depthFirstSearch at a time
+
+//------------------------------- getData -----------------------------------
+// getData
+// the node information of the given node, from the string pool
+    NodeData getData(int) const;
+
+//------------------------------- makeList ----------------------------------
+// makeList
+// makes adjList in the arena with an entry for each of nodes 0 .. size
+    void makeList();
+
+//------------------------------ buildEdges ---------------------------------
+// buildEdges
+// copies only the edges into a GraphCSR, in the order of each list
+    void buildEdges(GraphCSR&) const;
+
+//----------------------------- buildSearch ---------------------------------
+// buildSearch
+// copies the edges into graph and makes the DepthFirst on it, at the
+// end of buildGraph
+    void buildSearch();
 
-//----------------------- depthFirstSearchHelper ----------------------------
-// depthFirstSearchHelper
-// a helper function to perform depth-first search
-// displays each node in depth-first order
-    void depthFirstSearchHelper(int) const;
 
 };
 #endif
\ No newline at end of file
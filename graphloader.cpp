@@ -0,0 +1,257 @@
+//---------------------------------------------------------------------------
+// graphloader.cpp
+// Simple class graphloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphloader class:  reads a graph data file without streams
+//
+// Assumptions:
+//   -- for more than one thread, each edge is on a line of its own
+//      (otherwise the edges are parsed by one thread)
+//   -- POSIX mmap; a file that cannot be mapped is read into memory
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "graphloader.h"
+#include "stats.h"
+#include "threadpool.h"
+
+//---------------------------------------------------------------------------
+// Scanning helpers; p never moves past end.
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r'
+        || c == '\v' || c == '\f';
+}
+
+// skips white space, then reads an integer into value
+// returns 1 if read, 0 at the end of the text, -1 if it is not a number
+static int scanInt(const char*& p, const char* end, int& value) {
+    while (p < end && isSpace(*p)) p++;
+    if (p == end) return 0;
+
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+    }
+    const char* digits = p;
+    long long n = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        n = n * 10 + (*p - '0');
+        if (n > (long long)INT_MAX + 1) return -1;
+        p++;
+    }
+    if (p == digits || (p < end && !isSpace(*p))) return -1;
+    if (negative) n = -n;
+    if (n > INT_MAX || n < INT_MIN) return -1;
+    value = (int)n;
+    return 1;
+}
+
+// the start of the line after p, or end
+static const char* nextLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') p++;
+    return p < end ? p + 1 : end;
+}
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class graphloader
+GraphLoader::GraphLoader()
+    : data(NULL), length(0), mapped(false), size(0) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class graphloader
+// unmaps the file
+GraphLoader::~GraphLoader() {
+    close();
+} // end of Destructor
+
+//------------------------------- load --------------------------------------
+// load
+// maps the named file and parses it; weighted is true for the GraphM
+// format; the number of threads for the edges, 0 for one per core
+// returns false if the file cannot be read or is not in the format
+bool GraphLoader::load(const char* filename, bool weighted, int threads) {
+    STATS_TIMER(LOAD_FILE);
+    close();
+
+    // map the file, or read it if it cannot be mapped (e.g. a pipe)
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* p = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, info.st_size, MADV_SEQUENTIAL);
+            data = (const char*)p;
+            length = info.st_size;
+            mapped = true;
+        }
+    }
+    if (!mapped) {
+        vector<char> buffer;
+        char block[1 << 16];
+        ssize_t n;
+        while ((n = ::read(fd, block, sizeof(block))) > 0) {
+            buffer.insert(buffer.end(), block, block + n);
+        }
+        if (!buffer.empty()) {
+            char* copy = new char[buffer.size()];
+            copy_n(buffer.begin(), buffer.size(), copy);
+            data = copy;
+            length = buffer.size();
+        }
+    }
+    ::close(fd);
+    STATS_ADD(BYTES_PARSED, (long long)length);
+
+    const char* p = data;
+    const char* end = data + length;
+
+    // the number of nodes, then the rest of its line
+    if (scanInt(p, end, size) != 1 || size < 0) {
+        size = 0;
+        return false;
+    }
+    p = nextLine(p, end);
+
+    // the description lines, as slices of the file
+    descriptions.resize(size + 1);
+    descriptions[0].text = p;
+    descriptions[0].length = 0;
+    for (int i = 1; i <= size; i++) {
+        const char* line = nextLine(p, end);
+        descriptions[i].text = p;
+        descriptions[i].length = (int)(line - p);
+        if (line > p && line[-1] == '\n') descriptions[i].length--;
+        p = line;
+    }
+
+    // the edges, in chunks of whole lines, one chunk per thread
+    if (threads == 1 || end - p < (1 << 20)) {
+        bool parsed = parseEdges(p, end, weighted, from, to, weight) >= 0;
+        STATS_ADD(EDGES_PARSED, (long long)from.size());
+        return parsed;
+    }
+    ThreadPool pool(threads);
+    int chunks = pool.getThreadCount();
+
+    vector<const char*> starts(chunks + 1, end);
+    starts[0] = p;
+    for (int c = 1; c < chunks; c++) {
+        const char* q = p + (end - p) * c / chunks;
+        starts[c] = max(nextLine(q, end), starts[c - 1]);
+    }
+    vector<vector<int> > froms(chunks), tos(chunks), weights(chunks);
+    vector<int> result(chunks);
+    pool.parallelFor(0, chunks, [&](int c, int) {
+        result[c] = parseEdges(starts[c], starts[c + 1], weighted,
+                               froms[c], tos[c], weights[c]);
+    });
+
+    // put the chunks together up to the all-zero edge; a chunk that ends
+    // inside an edge means the edges are not one per line, unless it is
+    // the last one, where it means the file ends inside an edge
+    size_t total = 0;
+    int last = chunks - 1;
+    for (int c = 0; c < chunks; c++) {
+        if (result[c] == -2 && c < chunks - 1) {
+            bool parsed =
+                parseEdges(p, end, weighted, from, to, weight) >= 0;
+            STATS_ADD(EDGES_PARSED, (long long)from.size());
+            return parsed;
+        }
+        if (result[c] < 0) return false;
+        total += froms[c].size();
+        if (result[c] == 1) {
+            last = c;
+            break;
+        }
+    }
+    from.reserve(total);
+    to.reserve(total);
+    if (weighted) weight.reserve(total);
+    for (int c = 0; c <= last; c++) {
+        from.insert(from.end(), froms[c].begin(), froms[c].end());
+        to.insert(to.end(), tos[c].begin(), tos[c].end());
+        weight.insert(weight.end(), weights[c].begin(), weights[c].end());
+    }
+    STATS_ADD(EDGES_PARSED, (long long)from.size());
+    return true;
+} // end of load
+
+//---------------------------- parseEdges -----------------------------------
+// parseEdges
+// parses edges from [begin, end) into the given arrays until the
+// all-zero edge; returns -1 on bad data, 1 if the all-zero edge was
+// found, 0 if the text ended after a whole edge, -2 inside an edge
+int GraphLoader::parseEdges(const char* begin, const char* end,
+                            bool weighted, vector<int>& from,
+                            vector<int>& to, vector<int>& weight) {
+    int width = weighted ? 3 : 2;
+    int value[3] = { 0, 0, 0 };
+    const char* p = begin;
+    for (;;) {
+        for (int k = 0; k < width; k++) {
+            int found = scanInt(p, end, value[k]);
+            if (found == -1) return -1;
+            if (found == 0) return k == 0 ? 0 : -2;
+        }
+        if (value[0] == 0 && value[1] == 0 && value[2] == 0) return 1;
+        from.push_back(value[0]);
+        to.push_back(value[1]);
+        if (weighted) weight.push_back(value[2]);
+    }
+} // end of parseEdges
+
+//------------------------------- close -------------------------------------
+// close
+// unmaps the file and forgets the graph; the descriptions are gone
+void GraphLoader::close() {
+    if (mapped) {
+        munmap((void*)data, length);
+    }
+    else {
+        delete[] data;
+    }
+    data = NULL;
+    length = 0;
+    mapped = false;
+    size = 0;
+    descriptions.clear();
+    from.clear();
+    to.clear();
+    weight.clear();
+} // end of close
+
+//------------------------------ accessors ----------------------------------
+int GraphLoader::getSize() const {
+    return size;
+}
+
+long long GraphLoader::getEdgeCount() const {
+    return from.size();
+}
+
+TextSlice GraphLoader::getDescription(int i) const {
+    return descriptions[i];
+}
+
+const vector<int>& GraphLoader::getFrom() const {
+    return from;
+}
+
+const vector<int>& GraphLoader::getTo() const {
+    return to;
+}
+
+const vector<int>& GraphLoader::getWeight() const {
+    return weight;
+}
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------
+// graphloader.h
+// Simple class graphloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// graphloader class:  reads a graph data file without streams
+//
+// The file is mapped into memory and scanned in place: the numbers are
+// parsed by hand, and each node description is kept as a pointer and a
+// length into the mapped file instead of a string.  The edges go into
+// three arrays that grow once per load, not once per line.  With more
+// than one thread, the edge lines are split into one chunk per thread
+// and parsed at the same time.
+//
+// The format is the one read by GraphL::buildGraph (two numbers per
+// edge) and GraphM::buildGraph (three numbers per edge):
+//   -- the number of nodes, then one description line per node
+//   -- then the edges, ending with an edge of all zeros
+//
+// Assumptions:
+//   -- for more than one thread, each edge is on a line of its own
+//      (otherwise the edges are parsed by one thread)
+//   -- POSIX mmap; a file that cannot be mapped is read into memory
+//---------------------------------------------------------------------------
+#ifndef GRAPHLOADER_H
+#define GRAPHLOADER_H
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// a piece of text inside the loaded file, not terminated by '\0'
+struct TextSlice {
+    const char* text;
+    int length;
+};
+
+
+class GraphLoader {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class graphloader
+    GraphLoader();
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class graphloader
+// unmaps the file
+    ~GraphLoader();
+
+//------------------------------- load --------------------------------------
+// load
+// maps the named file and parses it; weighted is true for the GraphM
+// format; the number of threads for the edges, 0 for one per core
+// returns false if the file cannot be read or is not in the format
+    bool load(const char*, bool, int = 1);
+
+//------------------------------- close -------------------------------------
+// close
+// unmaps the file and forgets the graph; the descriptions are gone
+    void close();
+
+//------------------------------ accessors ----------------------------------
+// getSize:        the number of nodes
+// getEdgeCount:   the number of edges
+// getDescription: the description line of node 1 .. size
+// getFrom, getTo: the ends of every edge, in file order
+// getWeight:      the weight of every edge, empty if not weighted
+    int getSize() const;
+    long long getEdgeCount() const;
+    TextSlice getDescription(int) const;
+    const vector<int>& getFrom() const;
+    const vector<int>& getTo() const;
+    const vector<int>& getWeight() const;
+
+private:
+    const char* data;             // the file contents
+    size_t length;                // the length of the file
+    bool mapped;                  // data is mapped, not allocated
+    int size;                     // the number of nodes
+    vector<TextSlice> descriptions;
+    vector<int> from, to, weight;
+
+//---------------------------- parseEdges -----------------------------------
+// parseEdges
+// parses edges from [begin, end) into the given arrays until the
+// all-zero edge; returns -1 on bad data, 1 if the all-zero edge was
+// found, 0 if the text ended after a whole edge, -2 if it ended inside
+// an edge
+    static int parseEdges(const char*, const char*, bool, vector<int>&,
+                          vector<int>&, vector<int>&);
+
+    // not copyable, it owns the mapping
+    GraphLoader(const GraphLoader&);
+    GraphLoader& operator=(const GraphLoader&);
+};
+#endif
@@ -11,8 +11,17 @@
 //   -- no more than 100 nodes
 //---------------------------------------------------------------------------
 
+#include <algorithm>
+#include <sstream>
 #include "graphm.h"
 #include "nodedata.h"
+#include "graphcsr.h"
+#include "dijkstra.h"
+#include "threadpool.h"
+#include "floyd.h"
+#include "pathsearch.h"
+#include "dynamicpaths.h"
+#include "stats.h"
 
 //-------------------------- Constructor ------------------------------------
 // Default constructor for class graphm
@@ -35,9 +44,13 @@ GraphM::GraphM() {
 // builds up graph node information and 
 // adjacency matrix of edges between each node reading from a data file
 void GraphM::buildGraph(istream & infile) {
+    STATS_TIMER(BUILD_GRAPH);
     int fromNode, toNode, weight;      // from and to node ends of edge
 
     infile >> size;                   // read the number of nodes
+    graphChanged = true;
+    tableReady = false;
+    cache.clear();
     if (infile.eof()) return;         // stop if no more data
 
     string s;                         // used to read through to end of line
@@ -67,16 +80,41 @@ void GraphM::buildGraph(istream & infile) {
 } // end of buildGraph
 
 
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader (GraphM format)
+// the edges with a node outside 1 .. size are ignored
+void GraphM::buildGraph(const GraphLoader& loader) {
+    STATS_TIMER(BUILD_GRAPH);
+    size = min(loader.getSize(), MAXNODES - 1);
+    graphChanged = true;
+    tableReady = false;
+    cache.clear();
+
+    // read graph node information
+    for (int i = 1; i <= size; i++) {
+        TextSlice line = loader.getDescription(i);
+        data[i].setData(string(line.text, line.length));
+    }
+
+    // add the edges to the adjacency matrix
+    const vector<int>& from = loader.getFrom();
+    const vector<int>& to = loader.getTo();
+    const vector<int>& weight = loader.getWeight();
+    for (size_t e = 0; e < from.size() && e < weight.size(); e++) {
+        if (from[e] >= 1 && from[e] <= size && to[e] >= 1 && to[e] <= size) {
+            C[from[e]][to[e]] = weight[e];
+        }
+    }
+} // end of buildGraph
+
+
 //---------------------------- insertEdge -----------------------------------
 // insertEdge
 // insert an edge into graph between two given nodes
 void GraphM::insertEdge(int i, int j, int weight) {
-    // if the node is not exist in the graph
-
-    if (i > size || j > size) {
-        return;
-    }
-    C[i][j] = weight;
+    EdgeChange change = { i, j, weight, 0 };
+    updateEdges(vector<EdgeChange>(1, change));
 } // end of insertEdge
 
 
@@ -85,68 +123,150 @@ void GraphM::insertEdge(int i, int j, int weight) {
 // removeEdge
 // remove an edge from graph between two given nodes
 void GraphM::removeEdge(int i, int j) {
-	C[i][j] = 0;
+    EdgeChange change = { i, j, 0, 0 };
+    updateEdges(vector<EdgeChange>(1, change));
 } // end of removeEdge
 
 
 
+//---------------------------- updateEdges ----------------------------------
+// updateEdges
+// sets the weight of every given edge, 0 removes it
+// the changes with a node outside 1 .. size are ignored
+// if T is kept up to date, each row of T is repaired by DynamicPaths
+// with the whole batch at once
+void GraphM::updateEdges(const vector<EdgeChange>& changes) {
+    vector<EdgeChange> applied;
+    for (size_t k = 0; k < changes.size(); k++) {
+        EdgeChange c = changes[k];
+        // if the node is not exist in the graph
+        if (c.from < 1 || c.to < 1 || c.from > size || c.to > size) {
+            continue;
+        }
+        c.oldWeight = C[c.from][c.to];
+        cache.edgeChanged(c.from, c.to, c.oldWeight, c.weight);
+        C[c.from][c.to] = c.weight;
+        if (tableReady) dynamic.setWeight(c.from, c.to, c.weight);
+        applied.push_back(c);
+    }
+    if (applied.empty()) return;
+    graphChanged = true;
+
+    if (tableReady) {
+        DynamicPaths paths(dynamic);
+        for (int source = 1; source <= size; source++) {
+            paths.update(source, T[source], applied);
+        }
+    }
+} // end of updateEdges
+
+
+
 
 //---------------------------- displayAll -----------------------------------
 // displayAll
-// It uses displayPath as a helper function to display the path
+// It uses a PathTree of each row to display the path
 // use couts to demonstrate that the algorithm works properly
+// the output goes through writeAll in TEXT format, so it is written to
+// cout in large blocks instead of one flush per line
 void GraphM::displayAll() const{
-    cout << "Description         ";
-    cout << "From node   To node   Dijkstra\'s     ";
-    cout << "Path      " << endl;
-    for (int i = 1; i <=size; i++) {
-        cout << data[i] << endl;
-        for (int j = 1; j <= size; j++) {
+    ResultWriter out(cout);
+    writeAll(out, ResultWriter::TEXT);
+} // end of displayAll
 
-            if (i!=j) {
-                if (T[i][j].dist != INT_MAX) {
-		    cout << setw(25) << i;
-		    cout << setw(10) << j << setw(10) << T[i][j].dist;
-                    if (T[i][j].path == i) {
-                        cout << setw(13) << i << " " << j<< endl;
-
-                    }
-                    else {
-                        int pathArray[MAXNODES] = { 0 };
-                        int count = 0;
-                        displayPath(i, j, count, pathArray);
-                        cout << j << endl;
-                    }
+
+//----------------------------- writeAll -----------------------------------
+// writeAll
+// writes every shortest path in T to the writer in the given format
+// one PathTree is reused for every source, and each path is read
+// from it in a loop, so nothing is allocated per path
+void GraphM::writeAll(ResultWriter& out, ResultWriter::Format format) const {
+    STATS_TIMER(DISPLAY);
+    if (format == ResultWriter::BINARY) {
+        int header[2] = { 1, size };
+        out.put("GRAPHRES", 8);
+        out.put(header, sizeof(header));
+
+        // the columns of one source are gathered, then written at once
+        vector<int> dist(size), path(size);
+        for (int i = 1; i <= size; i++) {
+            for (int j = 1; j <= size; j++) {
+                dist[j - 1] = T[i][j].dist;
+                path[j - 1] = T[i][j].path;
+            }
+            out.put(&i, sizeof(i));
+            out.put(dist.data(), size * sizeof(int));
+            out.put(path.data(), size * sizeof(int));
+        }
+        return;
+    }
+
+    if (format == ResultWriter::TEXT) {
+        out.put("Description         ");
+        out.put("From node   To node   Dijkstra's     ");
+        out.put("Path      \n");
+    }
+    else {
+        out.put("from,to,dist,path\n");
+    }
+    PathTree tree;
+    for (int i = 1; i <= size; i++) {
+        if (format == ResultWriter::TEXT) {
+            ostringstream description;
+            description << data[i];
+            out.put(description.str());
+            out.put('\n');
+        }
+        tree.assign(i, T[i], size);
+        for (int j = 1; j <= size; j++) {
+            if (i == j) continue;
+            bool reached = T[i][j].dist != INT_MAX;
+            if (format == ResultWriter::TEXT) {
+                out.putInt(i, 25);
+                out.putInt(j, 10);
+                if (!reached) {
+                    out.putText("----", 10);
+                    out.put('\n');
+                    continue;
                 }
-                else {
-		    cout << setw(25) << i;
-		    cout << setw(10) << j << setw(10) << "----" << endl;
+                out.putInt(T[i][j].dist, 10);
+                PathSlice path = tree.getPath(j);
+                out.putInt(path.nodes[0], 13);
+                for (int k = 1; k < path.length; k++) {
+                    out.put(' ');
+                    out.putInt(path.nodes[k]);
                 }
             }
+            else {
+                out.putInt(i);
+                out.put(',');
+                out.putInt(j);
+                out.put(',');
+                if (!reached) {
+                    out.put(",\n");
+                    continue;
+                }
+                out.putInt(T[i][j].dist);
+                out.put(',');
+                PathSlice path = tree.getPath(j);
+                for (int k = 0; k < path.length; k++) {
+                    if (k > 0) out.put(' ');
+                    out.putInt(path.nodes[k]);
+                }
+            }
+            out.put('\n');
         }
     }
-    cout << endl;
-} // end of displayAll
+    if (format == ResultWriter::TEXT) out.put('\n');
+} // end of writeAll
 
 
-//---------------------------- displayPath ----------------------------------
-// displayPath
-// a helper function to display the path for displayAll
-// display the path recursively
-void GraphM::displayPath(int i, int j, int& count, int pathArray[]) const {
-	if (T[i][j].path == i) {
-	    cout << setw(13) << T[i][j].path << " ";
-	    pathArray[count] = T[i][j].path;
-	    count++;
-	}
-	else {
-	    displayPath(i, T[i][j].path, count, pathArray);
-	    cout << T[i][j].path << " ";
-	    pathArray[count] = T[i][j].path;
-	    count++;
-	}
-} // end of displayPath
-
+//---------------------------- getPathTree ---------------------------------
+// getPathTree
+// copies the paths from the given source in T into a PathTree
+void GraphM::getPathTree(int source, PathTree& tree) const {
+    tree.assign(source, T[source], size);
+} // end of getPathTree
 
 
 
@@ -156,65 +276,135 @@ void GraphM::displayPath(int i, int j, int& count, int pathArray[]) const {
 // perform the Dijkstra's algorithm
 // find the shortest path between 
 // every node to every other node in the graph
-// uses findShortestPathHelper to find the shortest path 
-// in one part of the algorithm
+// copies the edges into a GraphCSR once, then runs the heap-based
+// Dijkstra from each source into its row of T
 void GraphM::findShortestPath() {
+    STATS_TIMER(SHORTEST_PATH);
+    Dijkstra dijkstra(currentCSR());
 
 	// find the shortest distance for each source
     for (int source = 1; source <= size; source++) {
-        T[source][source].dist = 0;
-        T[source][source].visited = true;
-
-
-        for (int i = 1; i <= size; i++) {
-            if (C[source][i] != 0) {
-                T[source][i].dist = C[source][i];
-                T[source][i].path = source;
-            }
-        }
-
-	// find the shortest distance from source to all other nodes
-        for (int i = 1; i <= size; i++) {
+        dijkstra.findShortestPath(source, T[source]);
+    }
+    trackTable();
+} // end of findShortestPath
 
-	    // find v, which is the not visited, 
-	    // shortest distance at this point 
-            int v = findShortestPathHelper(source);
 
-			// mark v visited
-            T[source][v].visited = true;
+//--------------------- findShortestPathParallel ---------------------------
+// findShortestPathParallel
+// same result as findShortestPath, with the sources shared between
+// the given number of threads (0 uses one thread per core)
+// each source writes only its own row T[source][*], so the rows are
+// the same as the serial ones no matter which thread runs them
+void GraphM::findShortestPathParallel(int threads) {
+    STATS_TIMER(SHORTEST_PATH);
+    const GraphCSR& graph = currentCSR();
+    ThreadPool pool(threads);
+
+    // one Dijkstra, with its own heap, for each thread
+    vector<Dijkstra> dijkstra(pool.getThreadCount(), Dijkstra(graph));
+    pool.parallelFor(1, size + 1, [&](int source, int thread) {
+        dijkstra[thread].findShortestPath(source, T[source]);
+    });
+    trackTable();
+} // end of findShortestPathParallel
+
+
+//----------------------- findShortestPathFloyd ----------------------------
+// findShortestPathFloyd
+// fills T like findShortestPath, by using the cache-blocked
+// Floyd-Warshall class on C
+void GraphM::findShortestPathFloyd(int threads) {
+    STATS_TIMER(SHORTEST_PATH);
+    FloydWarshall floyd(threads);
+    floyd.findShortestPath(size, &C[0][0], MAXNODES);
+    for (int source = 1; source <= size; source++) {
+        floyd.fillRow(source, T[source]);
+    }
+    trackTable();
+} // end of findShortestPathFloyd
+
+
+//----------------------- findShortestPathFrom -----------------------------
+// findShortestPathFrom
+// the shortest path tree from the given source, size+1 entries laid out
+// like T[source][*], computed the first time the source is asked for
+const TableType* GraphM::findShortestPathFrom(int source) {
+    return cache.getTree(currentCSR(), source);
+} // end of findShortestPathFrom
+
+
+//------------------------ displayShortestPath -----------------------------
+// displayShortestPath
+// same output as display, using findShortestPathFrom instead of T
+void GraphM::displayShortestPath(int i, int j) {
+    if (i < 1 || i > size || j < 1 || j > size) return;
+    displayRow(findShortestPathFrom(i), i, j);
+} // end of displayShortestPath
+
+
+//---------------------------- shortestPath --------------------------------
+// shortestPath
+// the nodes of the shortest path from the first node to the second,
+// both ends included, empty if there is none
+vector<int> GraphM::shortestPath(int i, int j) {
+    const GraphCSR& graph = currentCSR();
+    if (!search) search.reset(new PathSearch(graph));
+    return search->shortestPath(i, j);
+} // end of shortestPath
+
+
+//--------------------------- setCacheBudget -------------------------------
+// setCacheBudget
+// the memory in bytes the cached trees of findShortestPathFrom may use
+void GraphM::setCacheBudget(size_t bytes) {
+    cache.setBudget(bytes);
+} // end of setCacheBudget
+
+
+//----------------------------- trackTable ---------------------------------
+// trackTable
+// called once T holds every shortest path; keeps a copy of the edges
+// with the edges entering each node, which DynamicPaths needs
+void GraphM::trackTable() {
+    dynamic.assign(currentCSR());
+    tableReady = true;
+} // end of trackTable
+
+
+//----------------------------- currentCSR ---------------------------------
+// currentCSR
+// graph, rebuilt first if C changed since it was last built; the
+// PathSearch of shortestPath is dropped with the old graph
+const GraphCSR& GraphM::currentCSR() {
+    if (graphChanged) {
+        search.reset();
+        buildCSR(graph);
+        graphChanged = false;
+    }
+    return graph;
+} // end of currentCSR
 
-	    // for each w adjacent to v
-            for (int w = 1; w <= size; w++) {
 
-		//for each w adjacent to v and w is not visited
-                if (!T[source][w].visited && C[v][w]!=0) { 
-                    if (T[source][w].dist > (T[source][v].dist + C[v][w])) {
-                        T[source][w].dist = T[source][v].dist + C[v][w];
-                        T[source][w].path = v;                        
-                    }
-                }
+//------------------------------ buildCSR ----------------------------------
+// buildCSR
+// copies the node information and the weighted edges into a GraphCSR
+void GraphM::buildCSR(GraphCSR& graph) const {
+    vector<int> from, to, weight;
+    for (int i = 1; i <= size; i++) {
+        for (int j = 1; j <= size; j++) {
+            if (C[i][j] != 0) {
+                from.push_back(i);
+                to.push_back(j);
+                weight.push_back(C[i][j]);
             }
         }
     }
-} // end of findShortestPath
-
-
-//---------------------- findShortestPathHelper ----------------------------
-// findShortestPathHelper
-// a helper function to fint v
-// which is the not visited, shortest distance at this point 
-int GraphM::findShortestPathHelper(int source) {
-    int shortest = INT_MAX;
-    int v = 0;
+    graph.assign(size, from, to, weight);
     for (int i = 1; i <= size; i++) {
-        if (T[source][i].dist < shortest 
-			&& T[source][i].dist>0 && ! T[source][i].visited) {
-            shortest = T[source][i].dist;
-            v = i;
-        }
+        graph.setData(i, data[i]);
     }
-    return v;
-} // end of findShortestPathHelper
+} // end of buildCSR
 
 
 
@@ -226,18 +416,36 @@ int GraphM::findShortestPathHelper(int source) {
 // uses couts to display the shortest distance with path info 
 // between the fromNode to toNode  
 void GraphM::display(int i, int j) const{
+    STATS_TIMER(DISPLAY);
+    displayRow(T[i], i, j);
+} // end of display
+
+
+//----------------------------- displayRow ---------------------------------
+// displayRow
+// a helper function for display, using the given row of the table
+void GraphM::displayRow(const TableType row[], int i, int j) const{
     int pathArray[MAXNODES] = { 0 };
     int count = 0;
 
-    if (T[i][j].dist != INT_MAX) {
-        cout << setw(5) << i << setw(10) << j << setw(10) << T[i][j].dist;
-        if (T[i][j].path == i) {
-            cout << setw(13) << i << " " << j << endl;
+    if (row[j].dist != INT_MAX) {
+        cout << setw(5) << i << setw(10) << j << setw(10) << row[j].dist;
+
+        // follow the previous nodes back from j, then print them forward
+        for (int v = row[j].path; v != 0 && count < MAXNODES; v = row[v].path) {
+            pathArray[count++] = v;
+            if (v == i) break;
+        }
+        reverse(pathArray, pathArray + count);
+        if (count == 0) {
+            cout << setw(13) << j << endl;   // j is the source itself
         }
         else {
-            displayPath(i, j, count, pathArray);
-            cout << j << endl;
-
+            cout << setw(13) << pathArray[0];
+            for (int k = 1; k < count; k++) {
+                cout << " " << pathArray[k];
+            }
+            cout << " " << j << endl;
         }
         printLocation(pathArray, count);
         cout << data[j] << endl << endl;
@@ -246,7 +454,7 @@ void GraphM::display(int i, int j) const{
 	cout << setw(5) << i << setw(10);
 	cout << j << setw(10) << "----" << endl << endl;
     }
-} // end of display
+} // end of displayRow
 
 
 //--------------------------- printLocation --------------------------------
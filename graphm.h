@@ -9,24 +9,29 @@
 //
 // Assumptions:
 //   -- no more than 100 nodes
+//   -- used by one thread at a time: even the queries that leave T alone
+//      (shortestPath, findShortestPathFrom, displayShortestPath) build
+//      the GraphCSR, the PathSearch and the cached trees on first use,
+//      with no lock; SharedGraph is for many threads reading at once
 //---------------------------------------------------------------------------
 #ifndef GRAPHM_H
 #define GRAPHM_H
 
 #include"limits.h"
 #include <iomanip>
+#include <memory>
 #include "nodedata.h"
+#include "tabletype.h"
+#include "graphcsr.h"
+#include "pathcache.h"
+#include "dynamicgraph.h"
+#include "pathtree.h"
+#include "pathsearch.h"
+#include "resultwriter.h"
+#include "densegraph.h"
 
 const int MAXNODES = 101;  // maximum number of nodes
 
-// the struct to keep the current shortest distance 
-// and associated path info known at any point in the algorithm
-struct TableType {
-    bool visited = false; // whether node has been visited
-    int dist = INT_MAX;   // the shortest distance from source known so far
-    int path = 0;         // previous node in path of min dist
-};
-
 
 class GraphM {
 public:
@@ -41,22 +46,51 @@ public:
 // adjacency matrix of edges between each node reading from a data file
     void buildGraph(istream&);
 
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// builds up the graph from a file parsed by GraphLoader (GraphM format)
+    void buildGraph(const GraphLoader&);
+
 //---------------------------- insertEdge -----------------------------------
 // insertEdge
 // insert and edge into graph between two given nodes
+// drops only the cached trees that the new edge can change
+// and repairs T if findShortestPath has been run, see updateEdges
     void insertEdge(int, int, int);
 
 //---------------------------- removeEdge -----------------------------------
 // removeEdge
-// insert and edge into graph between two given nodes
+// remove an edge from graph between two given nodes
     void removeEdge(int, int);
 
+//---------------------------- updateEdges ----------------------------------
+// updateEdges
+// sets the weight of every given edge, 0 removes it; once T has been
+// filled by one of the findShortestPath functions, only the entries of T
+// the changes affect are recomputed, all the changes in one pass per
+// source, so T stays right without running findShortestPath again
+    void updateEdges(const vector<EdgeChange>&);
+
 //---------------------------- displayAll -----------------------------------
 // displayAll
-// It uses displayPath as a helper function to display the path
+// It uses a PathTree of each row to display the path
 // use couts to demonstrate that the algorithm works properly
+// the output goes through writeAll in TEXT format
     void displayAll() const;
 
+//----------------------------- writeAll ------------------------------------
+// writeAll
+// writes every shortest path in T to the writer in the given format:
+//   TEXT    the output of displayAll
+//   CSV     a line "from,to,dist,path" for every pair of different nodes,
+//           the path nodes separated by spaces; dist and path are empty
+//           when there is no path
+//   BINARY  "GRAPHRES", the int version 1 and the int number of nodes,
+//           then for each source its int number followed by two columns
+//           of ints for nodes 1 .. size: dist (INT_MAX if not reachable)
+//           and the previous node in the path (0 if none)
+    void writeAll(ResultWriter&, ResultWriter::Format) const;
+
 //------------------------------ display ------------------------------------
 // display
 // It uses printLocation as a helper function to display the location
@@ -69,10 +103,71 @@ public:
 // perform the Dijkstra's algorithm
 // find the shortest path between 
 // every node to every other node in the graph
-// uses findShortestPathHelper to find the shortest path 
-// in one part of the algorithm
+// uses the heap-based Dijkstra class on a GraphCSR copy of the edges
     void findShortestPath();
 
+//--------------------- findShortestPathParallel ----------------------------
+// findShortestPathParallel
+// same result as findShortestPath, with the sources shared between
+// the given number of threads (0 uses one thread per core)
+// each thread keeps its own Dijkstra scratch and writes only its own rows
+    void findShortestPathParallel(int = 0);
+
+//----------------------- findShortestPathFrom ------------------------------
+// findShortestPathFrom
+// the shortest path tree from the given source, size+1 entries laid out
+// like T[source][*], computed the first time the source is asked for and
+// kept in a cache bounded by setCacheBudget; T itself is not touched
+// the pointer is valid until the next call that changes the graph or cache
+// it writes the cache, so two threads may not call it at once
+    const TableType* findShortestPathFrom(int);
+
+//------------------------ displayShortestPath ------------------------------
+// displayShortestPath
+// same output as display, using findShortestPathFrom instead of T
+// so findShortestPath does not have to be run first (one thread at a time)
+    void displayShortestPath(int, int);
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// the nodes of the shortest path from the first node to the second,
+// both ends included, empty if there is none; uses the bidirectional
+// search of the PathSearch class, so nothing has to be computed first;
+// the PathSearch is kept for later queries until the graph changes, and
+// is shared by them, so queries from several threads need SharedGraph
+    vector<int> shortestPath(int, int);
+
+//--------------------------- setCacheBudget --------------------------------
+// setCacheBudget
+// the memory in bytes the cached trees of findShortestPathFrom may use
+    void setCacheBudget(size_t);
+
+//----------------------- findShortestPathFloyd -----------------------------
+// findShortestPathFloyd
+// fills T like findShortestPath, by using the cache-blocked
+// Floyd-Warshall class on C, which suits graphs with many edges
+// the given number of threads (0 uses one thread per core)
+    void findShortestPathFloyd(int = 1);
+
+//---------------------------- getPathTree ----------------------------------
+// getPathTree
+// copies the paths from the given source in T into a PathTree, which
+// gives each path without recursion (findShortestPath must be run first)
+    void getPathTree(int, PathTree&) const;
+
+//----------------------------- buildDense ----------------------------------
+// buildDense
+// copies the edges into a DenseGraph with narrower weights, e.g.
+// DenseGraph<unsigned char> for weights up to 255 or DenseGraph<bool>
+// to drop the weights; returns false if a weight does not fit
+    template <class Weight>
+    bool buildDense(DenseGraph<Weight>&) const;
+
+//------------------------------ buildCSR -----------------------------------
+// buildCSR
+// copies the node information and the weighted edges into a GraphCSR
+    void buildCSR(GraphCSR&) const;
+
 
 
 private:
@@ -83,22 +178,51 @@ private:
     // a 2-D array of structs to store visitedm distance, and path
     TableType T[MAXNODES][MAXNODES]; 
 
-//---------------------------- displayPath ----------------------------------
-// displayPath
-// a helper function to display the path for displayAll
-    void displayPath(int, int, int&, int[]) const;
+    GraphCSR graph;              // the edges of C as a GraphCSR
+    bool graphChanged = true;    // whether C changed since graph was built
+    unique_ptr<PathSearch> search;  // searches graph, null until needed
+    PathCache cache;             // trees of findShortestPathFrom
+    DynamicGraph dynamic;        // the edges of C while T is kept up to date
+    bool tableReady = false;     // whether T holds every shortest path
+
+//----------------------------- displayRow ----------------------------------
+// displayRow
+// a helper function for display, using the given row of the table
+    void displayRow(const TableType[], int, int) const;
+
+//----------------------------- trackTable ----------------------------------
+// trackTable
+// called once T holds every shortest path, so that later edge changes
+// repair T instead of leaving it stale
+    void trackTable();
+
+//----------------------------- currentCSR ----------------------------------
+// currentCSR
+// graph, rebuilt first if C changed since it was last built
+    const GraphCSR& currentCSR();
 
 //--------------------------- printLocation --------------------------------
 // printLocation
 // a helper function for display to display the location of the output
     void printLocation(const int[], const int) const;
-
-//---------------------- findShortestPathHelper ----------------------------
-// findShortestPathHelper
-// a helper function to fint v
-// which is the not visited, shortest distance at this point 
-    int findShortestPathHelper(int);
 };
 
+//----------------------------- buildDense ----------------------------------
+// buildDense
+// copies the edges into a DenseGraph with narrower weights
+template <class Weight>
+bool GraphM::buildDense(DenseGraph<Weight>& dense) const {
+    dense.resize(size);
+    for (int i = 1; i <= size; i++) {
+        for (int j = 1; j <= size; j++) {
+            if (C[i][j] != 0 && !dense.setEdge(i, j, C[i][j])) {
+                dense.resize(0);
+                return false;
+            }
+        }
+    }
+    return true;
+} // end of buildDense
+
 #endif
 
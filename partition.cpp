@@ -0,0 +1,228 @@
+//---------------------------------------------------------------------------
+// partition.cpp
+// Simple class partition
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// partition class:  splits a GraphCSR into k parts of about the same
+//   number of nodes with few edges between them
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph must outlive the partition object and not change
+//---------------------------------------------------------------------------
+#include <unordered_map>
+#include "partition.h"
+
+static const int MAX_ROUNDS = 10;      // label propagation rounds of split
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class partition
+// keeps every edge in both directions, so a node sees the parts of the
+// nodes it has edges from as well as those it has edges to
+Partition::Partition(const GraphCSR& g) : graph(g), count(1), cut(0) {
+    int size = graph.getSize();
+    vector<int> from, to;
+    for (int v = 1; v <= size; v++) {
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            from.push_back(v);
+            to.push_back(*w);
+            from.push_back(*w);
+            to.push_back(v);
+        }
+    }
+    both.assign(size, from, to);
+    part.assign(size + 1, 0);
+    number();
+} // end of Constructor
+
+//------------------------------- split -------------------------------------
+// split
+// starts from blocks of a breadth-first order, then moves nodes by label
+// propagation until a round moves none or MAX_ROUNDS are done
+long long Partition::split(int parts, double imbalance) {
+    int size = graph.getSize();
+    count = parts < 1 ? 1 : parts;
+    if (count > size) count = size > 0 ? size : 1;
+    if (imbalance < 0) imbalance = 0;
+
+    startBlocks();
+    vector<int> sizes(count, 0);
+    for (int v = 1; v <= size; v++) sizes[part[v]]++;
+    int capacity = (int)((double)size / count * (1 + imbalance));
+    if (capacity < (size + count - 1) / count) {
+        capacity = (size + count - 1) / count;
+    }
+    for (int round = 0; round < MAX_ROUNDS; round++) {
+        if (propagate(sizes, capacity) == 0) break;
+    }
+    number();
+    return cut;
+} // end of split
+
+//---------------------------- buildShard -----------------------------------
+// buildShard
+// the nodes, edges and boundary table of the given part; an unweighted
+// graph gives weight 1 edges; a node of another part becomes a ghost the
+// first time an edge reaches it
+void Partition::buildShard(int p, Shard& shard) const {
+    shard.part = p;
+    shard.nodes = members[p];
+    shard.crossFrom.clear();
+    shard.crossTo.clear();
+    shard.crossWeight.clear();
+    shard.ghostPart.clear();
+    shard.ghostLocal.clear();
+    shard.ghostNode.clear();
+
+    unordered_map<int, int> ghostOf;   // global node -> ghost
+    vector<int> from, to, weight;
+    int n = (int)shard.nodes.size();
+    for (int i = 1; i <= n; i++) {
+        int v = shard.nodes[i - 1];
+        const int* adj = graph.edgeBegin(v);
+        const int* cost = graph.weightBegin(v);
+        for (int e = 0; e < graph.degree(v); e++) {
+            int w = adj[e];
+            int c = cost ? cost[e] : 1;
+            if (part[w] == p) {
+                from.push_back(i);
+                to.push_back(local[w]);
+                weight.push_back(c);
+                continue;
+            }
+            unordered_map<int, int>::iterator g = ghostOf.find(w);
+            if (g == ghostOf.end()) {
+                g = ghostOf.insert(make_pair(w, (int)shard.ghostNode.size()))
+                        .first;
+                shard.ghostPart.push_back(part[w]);
+                shard.ghostLocal.push_back(local[w]);
+                shard.ghostNode.push_back(w);
+            }
+            shard.crossFrom.push_back(i);
+            shard.crossTo.push_back(g->second);
+            shard.crossWeight.push_back(c);
+        }
+    }
+    shard.graph.assign(n, from, to, weight);
+} // end of buildShard
+
+//------------------------------ accessors ----------------------------------
+int Partition::getSize() const {
+    return graph.getSize();
+}
+
+int Partition::getCount() const {
+    return count;
+}
+
+long long Partition::getCut() const {
+    return cut;
+}
+
+int Partition::getPart(int v) const {
+    return part[v];
+}
+
+int Partition::getLocal(int v) const {
+    return local[v];
+}
+
+const vector<int>& Partition::getNodes(int p) const {
+    return members[p];
+}
+
+bool Partition::isBoundary(int v) const {
+    return boundary[v];
+}
+
+//---------------------------- startBlocks ----------------------------------
+// startBlocks
+// puts the nodes in blocks of consecutive nodes of a breadth-first order
+// over the edges in both directions; each node not yet reached starts a
+// new search, so the order covers every node; the node at position i of
+// the order goes to block i * count / size
+void Partition::startBlocks() {
+    int size = graph.getSize();
+    vector<int> order;
+    order.reserve(size);
+    vector<bool> reached(size + 1, false);
+    for (int s = 1; s <= size; s++) {
+        if (reached[s]) continue;
+        reached[s] = true;
+        order.push_back(s);
+        for (size_t next = order.size() - 1; next < order.size(); next++) {
+            int v = order[next];
+            for (const int* w = both.edgeBegin(v); w != both.edgeEnd(v);
+                 w++) {
+                if (!reached[*w]) {
+                    reached[*w] = true;
+                    order.push_back(*w);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        part[order[i]] = (int)((long long)i * count / size);
+    }
+} // end of startBlocks
+
+//------------------------------ propagate ----------------------------------
+// propagate
+// each node in turn counts its edges into each part and moves to the
+// part with the most, if that is more than its own part has, the part
+// has room and its own part keeps another node; returns the number of
+// nodes moved
+int Partition::propagate(vector<int>& sizes, int capacity) {
+    int size = graph.getSize();
+    vector<int> score(count, 0);
+    vector<int> touched;
+    int moved = 0;
+    for (int v = 1; v <= size; v++) {
+        for (const int* w = both.edgeBegin(v); w != both.edgeEnd(v); w++) {
+            if (*w == v) continue;
+            if (score[part[*w]]++ == 0) touched.push_back(part[*w]);
+        }
+        int own = part[v];
+        int best = own;
+        for (size_t t = 0; t < touched.size(); t++) {
+            int p = touched[t];
+            if (score[p] > score[best] && (p == own || sizes[p] < capacity)) {
+                best = p;
+            }
+        }
+        for (size_t t = 0; t < touched.size(); t++) score[touched[t]] = 0;
+        touched.clear();
+
+        if (best != own && sizes[own] > 1) {
+            sizes[own]--;
+            sizes[best]++;
+            part[v] = best;
+            moved++;
+        }
+    }
+    return moved;
+} // end of propagate
+
+//------------------------------- number ------------------------------------
+// number
+// fills members, local, boundary and cut from part
+void Partition::number() {
+    int size = graph.getSize();
+    members.assign(count, vector<int>());
+    local.assign(size + 1, 0);
+    boundary.assign(size + 1, false);
+    cut = 0;
+    for (int v = 1; v <= size; v++) {
+        members[part[v]].push_back(v);
+        local[v] = (int)members[part[v]].size();
+    }
+    for (int v = 1; v <= size; v++) {
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            if (part[*w] != part[v]) {
+                cut++;
+                boundary[v] = true;
+                boundary[*w] = true;
+            }
+        }
+    }
+} // end of number
@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------
+// partition.h
+// Simple class partition
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// partition class:  splits a GraphCSR into k parts of about the same
+//   number of nodes with few edges between them, and makes the shard of
+//   each part, e.g. for ShardedSearch
+//
+// split is label propagation: the nodes start in k blocks of consecutive
+// nodes of a breadth-first order, so each block starts close together,
+// then a few rounds move each node to the part most of its neighbors are
+// in, as long as that part has room.  A part never grows beyond
+// (1 + imbalance) times the even share and never becomes empty.
+//
+// A shard numbers the nodes of its part 1 .. n in the order of their
+// global numbers and keeps the edges between them as a GraphCSR.  The
+// edges leaving the part go to ghosts: the boundary table of the shard,
+// one entry for each node of another part that an edge reaches, with the
+// part it is in and its local number there.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph must outlive the partition object and not change
+//---------------------------------------------------------------------------
+#ifndef PARTITION_H
+#define PARTITION_H
+#include <vector>
+#include "graphcsr.h"
+
+// the nodes of one part and their edges, in local numbers;
+// local node i is the global node nodes[i-1]
+struct Shard {
+    int part;                    // 0 .. count-1
+    vector<int> nodes;           // the global number of each local node
+    GraphCSR graph;              // the edges inside the part, weighted
+    vector<int> crossFrom;       // the local node of each edge leaving
+                                 // the part, in order of node
+    vector<int> crossTo;         // the ghost it goes to, 0 .. ghosts-1
+    vector<int> crossWeight;     // its weight
+    vector<int> ghostPart;       // the part of each ghost
+    vector<int> ghostLocal;      // its local number in that part
+    vector<int> ghostNode;       // its global number
+};
+
+
+class Partition {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class partition
+// one part holding every node
+    explicit Partition(const GraphCSR&);
+
+//------------------------------- split -------------------------------------
+// split
+// splits the nodes into the given number of parts, at most one per node,
+// each at most the given fraction larger than the even share;
+// returns the number of edges between different parts
+    long long split(int, double = 0.03);
+
+//---------------------------- buildShard -----------------------------------
+// buildShard
+// the nodes, edges and boundary table of the given part
+    void buildShard(int, Shard&) const;
+
+//------------------------------ accessors ----------------------------------
+// getSize:    the number of nodes
+// getCount:   the number of parts
+// getCut:     the number of edges between different parts
+// getPart:    the part of the given node, 0 .. getCount()-1
+// getLocal:   the number of the given node in its part, 1 .. its size
+// getNodes:   the nodes of the given part, in order of node
+// isBoundary: whether the given node has an edge to or from another part
+    int getSize() const;
+    int getCount() const;
+    long long getCut() const;
+    int getPart(int) const;
+    int getLocal(int) const;
+    const vector<int>& getNodes(int) const;
+    bool isBoundary(int) const;
+
+private:
+    const GraphCSR& graph;             // the graph to split
+    GraphCSR both;                     // every edge in both directions
+    int count;                         // the number of parts
+    long long cut;                     // the edges between parts
+    vector<int> part;                  // part[v] is the part of v
+    vector<int> local;                 // local[v] is v's number in its part
+    vector<vector<int> > members;      // the nodes of each part
+    vector<bool> boundary;             // boundary[v] if v has a cut edge
+
+//---------------------------- startBlocks ----------------------------------
+// startBlocks
+// puts the nodes in blocks of consecutive nodes of a breadth-first order
+    void startBlocks();
+
+//------------------------------ propagate ----------------------------------
+// propagate
+// one round of moving nodes to the part of most of their neighbors;
+// returns the number of nodes moved
+    int propagate(vector<int>&, int);
+
+//------------------------------- number ------------------------------------
+// number
+// fills members, local, boundary and cut from part
+    void number();
+};
+#endif
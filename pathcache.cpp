@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+// pathcache.cpp
+// Simple class pathcache
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathcache class:  shortest path trees computed on demand
+//
+// Assumptions:
+//   -- the graph passed to getTree reflects every change reported
+//      through edgeChanged
+//   -- a weight of 0 means there is no edge
+//---------------------------------------------------------------------------
+#include "pathcache.h"
+#include "dijkstra.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathcache
+PathCache::PathCache(size_t bytes) : budget(bytes), memory(0) {
+} // end of Constructor
+
+//------------------------------ getTree ------------------------------------
+// getTree
+// the shortest path tree from the given source, size+1 entries
+// computes it on the given graph if it is not cached
+const TableType* PathCache::getTree(const GraphCSR& graph, int source) {
+    unordered_map<int, Entry>::iterator it = trees.find(source);
+
+    // a cached tree becomes the most recently used
+    if (it != trees.end()) {
+        recent.splice(recent.begin(), recent, it->second.order);
+        return it->second.row.data();
+    }
+
+    Entry& entry = trees[source];
+    entry.row.resize(graph.getSize() + 1);
+    Dijkstra dijkstra(graph);
+    dijkstra.findShortestPath(source, entry.row.data());
+    recent.push_front(source);
+    entry.order = recent.begin();
+    memory += entryBytes(entry.row.size());
+
+    evict();
+    return entry.row.data();
+} // end of getTree
+
+//---------------------------- edgeChanged ----------------------------------
+// edgeChanged
+// drops the trees that the change of edge from -> to can alter
+// a tree can only change if it uses the edge and the edge got worse,
+// or if the edge got better and now reaches "to" at least as early,
+// a tie can change which node comes before "to" in the path
+void PathCache::edgeChanged(int from, int to, int oldWeight, int newWeight) {
+    if (oldWeight == newWeight) return;
+    bool worse = oldWeight != 0 && (newWeight == 0 || newWeight > oldWeight);
+    bool better = newWeight != 0 && (oldWeight == 0 || newWeight < oldWeight);
+
+    unordered_map<int, Entry>::iterator it = trees.begin();
+    while (it != trees.end()) {
+        const vector<TableType>& row = it->second.row;
+        bool stale = false;
+        if (from >= (int)row.size() || to >= (int)row.size()) {
+            stale = true;            // the tree is older than the node
+        }
+        else if (worse && row[to].path == from) {
+            stale = true;
+        }
+        else if (better && row[from].dist != INT_MAX &&
+                 (long long)row[from].dist + newWeight <= row[to].dist) {
+            stale = true;
+        }
+
+        if (stale) {
+            unordered_map<int, Entry>::iterator next = it;
+            ++next;
+            erase(it);
+            it = next;
+        }
+        else {
+            ++it;
+        }
+    }
+} // end of edgeChanged
+
+//------------------------------- clear -------------------------------------
+// clear
+// drops every tree
+void PathCache::clear() {
+    trees.clear();
+    recent.clear();
+    memory = 0;
+} // end of clear
+
+//------------------------------ accessors ----------------------------------
+void PathCache::setBudget(size_t bytes) {
+    budget = bytes;
+    evict();
+}
+
+size_t PathCache::getBudget() const {
+    return budget;
+}
+
+size_t PathCache::getMemory() const {
+    return memory;
+}
+
+int PathCache::getTreeCount() const {
+    return (int)trees.size();
+}
+
+bool PathCache::hasTree(int source) const {
+    return trees.count(source) != 0;
+}
+
+//------------------------------ entryBytes ---------------------------------
+// entryBytes
+// the bytes counted against the budget for a tree of the given row length
+// the row itself plus the map node and the list node that track it
+size_t PathCache::entryBytes(size_t length) {
+    return length * sizeof(TableType) + sizeof(Entry) + 4 * sizeof(void*);
+} // end of entryBytes
+
+//------------------------------- evict -------------------------------------
+// evict
+// drops the least recently used trees until the budget is met,
+// always keeping the most recently used one
+void PathCache::evict() {
+    while (memory > budget && recent.size() > 1) {
+        erase(trees.find(recent.back()));
+    }
+} // end of evict
+
+//------------------------------- erase -------------------------------------
+// erase
+// drops the given tree
+void PathCache::erase(unordered_map<int, Entry>::iterator it) {
+    memory -= entryBytes(it->second.row.size());
+    recent.erase(it->second.order);
+    trees.erase(it);
+} // end of erase
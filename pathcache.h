@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+// pathcache.h
+// Simple class pathcache
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathcache class:  shortest path trees computed on demand
+//
+// A tree (one row of TableType, like T[source][*] in GraphM) is computed
+// with Dijkstra the first time its source is asked for and kept until
+// the memory budget is used up; then the least recently used trees are
+// dropped.  When an edge changes, only the trees that the change can
+// alter are dropped:
+//   -- a removed or heavier edge, if the tree goes through it
+//   -- a new or lighter edge, if it reaches its end no later than the tree
+//
+// Assumptions:
+//   -- the graph passed to getTree reflects every change reported
+//      through edgeChanged
+//   -- a weight of 0 means there is no edge
+//---------------------------------------------------------------------------
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "graphcsr.h"
+#include "tabletype.h"
+
+
+class PathCache {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathcache
+// the memory budget in bytes for the cached trees
+    explicit PathCache(size_t = 64 << 20);
+
+//------------------------------ getTree ------------------------------------
+// getTree
+// the shortest path tree from the given source, size+1 entries
+// computes it on the given graph if it is not cached
+// the pointer is valid until the next getTree, edgeChanged or clear
+    const TableType* getTree(const GraphCSR&, int);
+
+//---------------------------- edgeChanged ----------------------------------
+// edgeChanged
+// drops the trees that the change of edge from -> to can alter
+// the old and the new weight, 0 for no edge
+    void edgeChanged(int, int, int, int);
+
+//------------------------------- clear -------------------------------------
+// clear
+// drops every tree
+    void clear();
+
+//------------------------------ accessors ----------------------------------
+// setBudget:    change the memory budget, dropping trees if needed
+// getBudget:    the memory budget in bytes
+// getMemory:    the bytes used by the cached trees
+// getTreeCount: the number of cached trees
+// hasTree:      whether the tree of the given source is cached
+    void setBudget(size_t);
+    size_t getBudget() const;
+    size_t getMemory() const;
+    int getTreeCount() const;
+    bool hasTree(int) const;
+
+private:
+    // a cached tree and its place in the least recently used order
+    struct Entry {
+        vector<TableType> row;
+        list<int>::iterator order;
+    };
+
+    size_t budget;                      // the memory budget in bytes
+    size_t memory;                      // the bytes used by the trees
+    list<int> recent;                   // sources, most recently used first
+    unordered_map<int, Entry> trees;    // cached trees by source
+
+//------------------------------ entryBytes ---------------------------------
+// entryBytes
+// the bytes counted against the budget for a tree of the given row length
+    static size_t entryBytes(size_t);
+
+//------------------------------- evict -------------------------------------
+// evict
+// drops the least recently used trees until the budget is met,
+// always keeping the most recently used one
+    void evict();
+
+//------------------------------- erase -------------------------------------
+// erase
+// drops the given tree
+    void erase(unordered_map<int, Entry>::iterator);
+};
+#endif
@@ -0,0 +1,331 @@
+//---------------------------------------------------------------------------
+// pathsearch.cpp
+// Simple class pathsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathsearch class:  point-to-point shortest path queries on a GraphCSR
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- a heuristic never overestimates and h(v) <= w(v, u) + h(u)
+//   -- the graph must outlive the pathsearch object and not change
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "pathsearch.h"
+#include "dijkstra.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathsearch
+// builds the reversed graph used by the backward search
+PathSearch::PathSearch(CSRView g)
+    : graph(g), reverse(reversed), query(0), lastDist(INT_MAX),
+      settledCount(0) {
+    buildReverse(graph, reversed);
+    reverse = CSRView(reversed);
+    initialize();
+} // end of Constructor
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathsearch
+// uses the given reversed graph
+PathSearch::PathSearch(CSRView g, CSRView r)
+    : graph(g), reverse(r), query(0), lastDist(INT_MAX), settledCount(0) {
+    initialize();
+} // end of Constructor
+
+//---------------------------- buildReverse ---------------------------------
+// buildReverse
+// the edges entering each node, with weight 1 if the graph has none
+void PathSearch::buildReverse(CSRView graph, GraphCSR& reverse) {
+    int size = graph.getSize();
+    vector<int> from, to, weight;
+    for (int v = 1; v <= size; v++) {
+        const int* cost = graph.weightBegin(v);
+        for (int e = 0; e < graph.degree(v); e++) {
+            from.push_back(graph.edgeBegin(v)[e]);
+            to.push_back(v);
+            weight.push_back(cost ? cost[e] : 1);
+        }
+    }
+    reverse.assign(size, from, to, weight);
+} // end of buildReverse
+
+//------------------------------ initialize ---------------------------------
+// initialize
+// nothing is reached yet: every stamp is 0, before the first query
+void PathSearch::initialize() {
+    int size = graph.getSize();
+    Side* sides[2] = { &forward, &backward };
+    for (int s = 0; s < 2; s++) {
+        sides[s]->stamp.assign(size + 1, 0);
+        sides[s]->dist.assign(size + 1, INT_MAX);
+        sides[s]->path.assign(size + 1, 0);
+        sides[s]->settled.assign(size + 1, false);
+    }
+} // end of initialize
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// bidirectional Dijkstra from the first node to the second node
+// each step settles a node on the side with the smaller heap; every edge
+// that reaches a node seen by the other side is a candidate path, and the
+// search stops once the two heap tops add up to at least the best one
+vector<int> PathSearch::shortestPath(int start, int end) {
+    startQuery();
+    int size = graph.getSize();
+    if (start < 1 || start > size || end < 1 || end > size) {
+        return vector<int>();
+    }
+
+    greater<pair<int, int> > later;
+    reach(forward, start, 0, 0, 0);
+    reach(backward, end, 0, 0, 0);
+    long long best = start == end ? 0 : INT_MAX;
+    int meet = start == end ? start : 0;
+
+    while (!forward.heap.empty() && !backward.heap.empty()) {
+        if ((long long)forward.heap.front().first
+                + backward.heap.front().first >= best) {
+            break;
+        }
+
+        bool isForward = forward.heap.size() <= backward.heap.size();
+        Side& side = isForward ? forward : backward;
+        Side& other = isForward ? backward : forward;
+        const CSRView& g = isForward ? graph : reverse;
+
+        pop_heap(side.heap.begin(), side.heap.end(), later);
+        int v = side.heap.back().second;
+        side.heap.pop_back();
+        if (side.settled[v]) continue;
+        side.settled[v] = true;
+        settledCount++;
+
+        const int* adj = g.edgeBegin(v);
+        const int* cost = g.weightBegin(v);
+        for (int e = 0; e < g.degree(v); e++) {
+            int w = adj[e];
+            long long dist = (long long)side.dist[v] + (cost ? cost[e] : 1);
+            if (side.stamp[w] != query || dist < side.dist[w]) {
+                reach(side, w, (int)dist, v, (int)dist);
+            }
+            if (other.stamp[w] == query
+                    && (long long)side.dist[w] + other.dist[w] < best) {
+                best = (long long)side.dist[w] + other.dist[w];
+                meet = w;
+            }
+        }
+    }
+
+    if (meet == 0) return vector<int>();
+    lastDist = (int)best;
+    return makePath(start, meet, end);
+} // end of shortestPath
+
+//-------------------------- shortestPathAStar ------------------------------
+// shortestPathAStar
+// A* from the first node to the second node with the given heuristic
+// the heap key is the distance so far plus the heuristic of the node
+vector<int> PathSearch::shortestPathAStar(int start, int end,
+                                          const function<int(int)>& h) {
+    startQuery();
+    int size = graph.getSize();
+    if (start < 1 || start > size || end < 1 || end > size) {
+        return vector<int>();
+    }
+
+    greater<pair<int, int> > later;
+    int bound = h(start);
+    if (bound == INT_MAX) return vector<int>();
+    reach(forward, start, 0, 0, bound);
+
+    while (!forward.heap.empty()) {
+        pop_heap(forward.heap.begin(), forward.heap.end(), later);
+        int v = forward.heap.back().second;
+        forward.heap.pop_back();
+        if (forward.settled[v]) continue;
+        forward.settled[v] = true;
+        settledCount++;
+
+        if (v == end) {
+            lastDist = forward.dist[v];
+            return makePath(start, end, end);
+        }
+
+        const int* adj = graph.edgeBegin(v);
+        const int* cost = graph.weightBegin(v);
+        for (int e = 0; e < graph.degree(v); e++) {
+            int w = adj[e];
+            long long dist = (long long)forward.dist[v] + (cost ? cost[e] : 1);
+            if (forward.stamp[w] == query && dist >= forward.dist[w]) {
+                continue;
+            }
+            int hw = h(w);
+            if (hw == INT_MAX) continue;       // w cannot reach the end
+            long long key = dist + hw;
+            if (key >= INT_MAX) continue;
+            reach(forward, w, (int)dist, v, (int)key);
+        }
+    }
+    return vector<int>();
+} // end of shortestPathAStar
+
+//-------------------------- buildLandmarks ---------------------------------
+// buildLandmarks
+// picks the given number of landmarks, each as far as possible from the
+// ones picked before, and stores the distances to and from each of them
+// the first landmark is the node farthest from node 1
+void PathSearch::buildLandmarks(int count) {
+    int size = graph.getSize();
+    landmarks.clear();
+    if (size == 0 || count <= 0) {
+        toLandmark.clear();
+        fromLandmark.clear();
+        return;
+    }
+    count = min(count, size);
+
+    Dijkstra forwardSearch(graph);
+    Dijkstra backwardSearch(reverse);
+    vector<TableType> row(size + 1);
+    vector<vector<int> > from(count), to(count);
+
+    // how far each node is from the landmarks picked so far
+    vector<long long> nearest(size + 1, (long long)INT_MAX + 1);
+    forwardSearch.findShortestPath(1, row.data());
+    for (int v = 1; v <= size; v++) {
+        nearest[v] = row[v].dist == INT_MAX ? -1 : row[v].dist;
+    }
+
+    for (int l = 0; l < count; l++) {
+        int pick = 1;
+        for (int v = 2; v <= size; v++) {
+            if (nearest[v] > nearest[pick]) pick = v;
+        }
+        landmarks.push_back(pick);
+
+        forwardSearch.findShortestPath(pick, row.data());
+        from[l].resize(size + 1);
+        for (int v = 1; v <= size; v++) {
+            from[l][v] = row[v].dist;
+            if (l == 0 || row[v].dist < nearest[v]) {
+                nearest[v] = row[v].dist;
+            }
+        }
+        nearest[pick] = -1;             // never pick it again
+
+        backwardSearch.findShortestPath(pick, row.data());
+        to[l].resize(size + 1);
+        for (int v = 1; v <= size; v++) {
+            to[l][v] = row[v].dist;
+        }
+    }
+
+    // store the landmarks of each node next to each other
+    toLandmark.assign((size_t)(size + 1) * count, INT_MAX);
+    fromLandmark.assign((size_t)(size + 1) * count, INT_MAX);
+    for (int v = 1; v <= size; v++) {
+        for (int l = 0; l < count; l++) {
+            toLandmark[(size_t)v * count + l] = to[l][v];
+            fromLandmark[(size_t)v * count + l] = from[l][v];
+        }
+    }
+} // end of buildLandmarks
+
+//------------------------ shortestPathLandmarks ----------------------------
+// shortestPathLandmarks
+// A* with the landmark (ALT) heuristic, buildLandmarks must be run first
+// (without landmarks the bound is 0 and it searches like Dijkstra)
+vector<int> PathSearch::shortestPathLandmarks(int start, int end) {
+    return shortestPathAStar(start, end, [this, end](int v) {
+        return landmarkBound(v, end);
+    });
+} // end of shortestPathLandmarks
+
+//------------------------------ landmarkBound ------------------------------
+// landmarkBound
+// the ALT lower bound of the distance from the first node to the second:
+// by the triangle inequality, for every landmark L
+//   d(v, t) >= d(v, L) - d(t, L)   and   d(v, t) >= d(L, t) - d(L, v)
+// a term is skipped when one of its distances is not known; 0 if
+// buildLandmarks has not been run
+int PathSearch::landmarkBound(int v, int t) const {
+    int count = (int)landmarks.size();
+    if (count == 0) return 0;
+    const int* toV = &toLandmark[(size_t)v * count];
+    const int* toT = &toLandmark[(size_t)t * count];
+    const int* fromV = &fromLandmark[(size_t)v * count];
+    const int* fromT = &fromLandmark[(size_t)t * count];
+    int bound = 0;
+    for (int l = 0; l < count; l++) {
+        if (toV[l] != INT_MAX && toT[l] != INT_MAX) {
+            bound = max(bound, toV[l] - toT[l]);
+        }
+        if (fromT[l] != INT_MAX && fromV[l] != INT_MAX) {
+            bound = max(bound, fromT[l] - fromV[l]);
+        }
+    }
+    return bound;
+} // end of landmarkBound
+
+//------------------------------ accessors ----------------------------------
+int PathSearch::getDist() const {
+    return lastDist;
+}
+
+int PathSearch::getSettledCount() const {
+    return settledCount;
+}
+
+const vector<int>& PathSearch::getLandmarks() const {
+    return landmarks;
+}
+
+//------------------------------ startQuery ---------------------------------
+// startQuery
+// moves to a new query stamp, clearing the stamps when they wrap around
+void PathSearch::startQuery() {
+    if (++query == 0) {
+        fill(forward.stamp.begin(), forward.stamp.end(), 0);
+        fill(backward.stamp.begin(), backward.stamp.end(), 0);
+        query = 1;
+    }
+    forward.heap.clear();
+    backward.heap.clear();
+    lastDist = INT_MAX;
+    settledCount = 0;
+} // end of startQuery
+
+//------------------------------- reach -------------------------------------
+// reach
+// records a new distance of a node in one side and pushes it on the heap
+// a node reached for the first time in this query is also unsettled
+void PathSearch::reach(Side& side, int v, int dist, int prev, int key) {
+    if (side.stamp[v] != query) {
+        side.stamp[v] = query;
+        side.settled[v] = false;
+    }
+    side.dist[v] = dist;
+    side.path[v] = prev;
+    side.heap.push_back(make_pair(key, v));
+    push_heap(side.heap.begin(), side.heap.end(),
+              greater<pair<int, int> >());
+} // end of reach
+
+//------------------------------ makePath -----------------------------------
+// makePath
+// the nodes from the first node to the meeting node, then on to the
+// second node through the backward search
+vector<int> PathSearch::makePath(int start, int meet, int end) const {
+    vector<int> path;
+    for (int v = meet; v != start; v = forward.path[v]) {
+        path.push_back(v);
+    }
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    for (int v = meet; v != end; ) {
+        v = backward.path[v];
+        path.push_back(v);
+    }
+    return path;
+} // end of makePath
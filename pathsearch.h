@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+// pathsearch.h
+// Simple class pathsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathsearch class:  point-to-point shortest path queries on a GraphCSR
+//
+// Instead of finding the paths from a source to every node, a query
+// stops as soon as the path between its two nodes is known:
+//   -- shortestPath searches forward from the start and backward from the
+//      end at the same time and stops when the two searches meet
+//   -- shortestPathAStar searches forward only, visiting first the nodes
+//      whose distance so far plus the heuristic is the smallest
+//   -- shortestPathLandmarks is A* with the ALT heuristic, which uses the
+//      distances to and from a few landmark nodes (see buildLandmarks)
+// The scratch arrays are stamped with a query number, so a query only
+// touches the nodes it visits and never clears the whole graph.
+//
+// Assumptions:
+//   -- edge weights are positive
+//   -- a heuristic never overestimates and h(v) <= w(v, u) + h(u)
+//   -- the graph must outlive the pathsearch object and not change
+//   -- a reversed graph given to it matches the graph
+//---------------------------------------------------------------------------
+#ifndef PATHSEARCH_H
+#define PATHSEARCH_H
+#include <functional>
+#include <vector>
+#include "csrview.h"
+#include "graphcsr.h"
+
+
+class PathSearch {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathsearch
+// builds the reversed graph used by the backward search; the graph
+// may be a GraphCSR or a GraphSnapshot
+    explicit PathSearch(CSRView);
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class pathsearch
+// searches backward on the given reversed graph (see buildReverse)
+// instead of building one, so searches of the same graph can share it;
+// both must outlive the pathsearch object
+    PathSearch(CSRView, CSRView);
+
+//---------------------------- buildReverse ---------------------------------
+// buildReverse
+// the graph with every edge of the first one reversed, weighted
+    static void buildReverse(CSRView, GraphCSR&);
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// bidirectional Dijkstra from the first node to the second node
+// returns the nodes of the path, both ends included, empty if none
+    vector<int> shortestPath(int, int);
+
+//-------------------------- shortestPathAStar ------------------------------
+// shortestPathAStar
+// A* from the first node to the second node with the given heuristic,
+// a lower bound of the distance from a node to the second node
+// (INT_MAX if the node cannot reach it)
+    vector<int> shortestPathAStar(int, int, const function<int(int)>&);
+
+//-------------------------- buildLandmarks ---------------------------------
+// buildLandmarks
+// picks the given number of landmarks, each as far as possible from the
+// ones picked before, and stores the distances to and from each of them
+    void buildLandmarks(int);
+
+//------------------------ shortestPathLandmarks ----------------------------
+// shortestPathLandmarks
+// A* with the landmark (ALT) heuristic, buildLandmarks must be run first
+// (without landmarks the bound is 0 and it searches like Dijkstra)
+    vector<int> shortestPathLandmarks(int, int);
+
+//------------------------------ accessors ----------------------------------
+// getDist:         the distance of the last path found, INT_MAX if none
+// getSettledCount: the number of nodes settled by the last query
+// getLandmarks:    the landmark nodes
+    int getDist() const;
+    int getSettledCount() const;
+    const vector<int>& getLandmarks() const;
+
+private:
+    // the state of one search direction, valid where stamp == query
+    struct Side {
+        vector<unsigned> stamp;          // query that reached the node
+        vector<int> dist;                // distance from the search start
+        vector<int> path;                // previous node in the search
+        vector<bool> settled;            // distance is final
+        vector<pair<int, int> > heap;    // (key, node), smallest first
+    };
+
+    CSRView graph;                   // the graph to search
+    GraphCSR reversed;               // built when no reverse is given
+    CSRView reverse;                 // graph with every edge reversed
+    Side forward;                    // search from the first node
+    Side backward;                   // search from the second node
+    unsigned query;                  // stamp of the current query
+    int lastDist;                    // distance found by the last query
+    int settledCount;                // nodes settled by the last query
+
+    vector<int> landmarks;           // the landmark nodes
+    vector<int> toLandmark;          // [v * count + l] dist v -> landmark
+    vector<int> fromLandmark;        // [v * count + l] dist landmark -> v
+
+//------------------------------ initialize ---------------------------------
+// initialize
+// sizes the scratch arrays of both sides
+    void initialize();
+
+//------------------------------ startQuery ---------------------------------
+// startQuery
+// moves to a new query stamp, clearing the stamps when they wrap around
+    void startQuery();
+
+//------------------------------- reach -------------------------------------
+// reach
+// records a new distance of a node in one side and pushes it on the heap
+    void reach(Side&, int, int, int, int);
+
+//------------------------------ landmarkBound ------------------------------
+// landmarkBound
+// the ALT lower bound of the distance from the first node to the second
+    int landmarkBound(int, int) const;
+
+//------------------------------ makePath -----------------------------------
+// makePath
+// the nodes from the first node to the meeting node, then on to the
+// second node through the backward search
+    vector<int> makePath(int, int, int) const;
+
+    // not copyable, reverse may point into reversed
+    PathSearch(const PathSearch&);
+    PathSearch& operator=(const PathSearch&);
+};
+#endif
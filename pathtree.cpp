@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------
+// pathtree.cpp
+// Simple class pathtree
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathtree class:  the shortest path tree from one source, stored as
+//   plain int arrays of the previous node and distance of each node
+//
+// Assumptions:
+//   -- the row is a tree, as filled by Dijkstra, Floyd or DynamicPaths
+//   -- a path is valid until the next call on the same tree
+//---------------------------------------------------------------------------
+#include <climits>
+#include <cstddef>
+#include "pathtree.h"
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class pathtree
+PathTree::PathTree() : source(0), size(0) {
+} // end of Constructor
+
+//------------------------------ assign -------------------------------------
+// assign
+// copies the tree from the given source out of a row of TableType
+// the children of each node are grouped by counting them first
+void PathTree::assign(int from, const TableType row[], int nodes) {
+    source = from;
+    size = nodes;
+    parent.assign(size + 1, 0);
+    dist.assign(size + 1, INT_MAX);
+    childOffsets.assign(size + 2, 0);
+    for (int v = 1; v <= size; v++) {
+        dist[v] = row[v].dist;
+        if (v != source && row[v].dist != INT_MAX) {
+            parent[v] = row[v].path;
+            childOffsets[parent[v] + 1]++;
+        }
+    }
+    for (int v = 1; v <= size; v++) {
+        childOffsets[v + 1] += childOffsets[v];
+    }
+    children.resize(childOffsets[size + 1]);
+    next.assign(childOffsets.begin(), childOffsets.end() - 1);
+    for (int v = 1; v <= size; v++) {
+        if (parent[v] != 0) children[next[parent[v]]++] = v;
+    }
+    buffer.resize(size + 1);
+} // end of assign
+
+//------------------------------ getPath ------------------------------------
+// getPath
+// the path from the source to the given node, length 0 if not reached
+// written from the back of the buffer while walking up to the source
+PathSlice PathTree::getPath(int target) {
+    PathSlice path = { NULL, 0 };
+    if (target < 1 || target > size || dist[target] == INT_MAX) return path;
+
+    int at = size + 1;
+    for (int v = target; v != 0 && at > 0; v = parent[v]) {
+        buffer[--at] = v;
+    }
+    path.nodes = buffer.data() + at;
+    path.length = size + 1 - at;
+    return path;
+} // end of getPath
+
+//---------------------------- forEachPath ----------------------------------
+// forEachPath
+// calls visit(node, path) for every node reached other than the source
+// the buffer holds the path to the node on top of the stack and next
+// holds, for each node on it, the next of its children to go down to
+void PathTree::forEachPath(const function<void(int, PathSlice)>& visit) {
+    if (source < 1 || source > size) return;
+    next.assign(1, childOffsets[source]);
+    buffer[0] = source;
+
+    while (!next.empty()) {
+        int depth = (int)next.size();
+        int v = buffer[depth - 1];
+        if (next.back() == childOffsets[v + 1]) {
+            next.pop_back();             // all children are done
+            continue;
+        }
+        int w = children[next.back()++];
+        buffer[depth] = w;
+        PathSlice path = { buffer.data(), depth + 1 };
+        visit(w, path);
+        next.push_back(childOffsets[w]);
+    }
+} // end of forEachPath
+
+//------------------------------ accessors ----------------------------------
+int PathTree::getSource() const {
+    return source;
+}
+
+int PathTree::getSize() const {
+    return size;
+}
+
+int PathTree::getDist(int v) const {
+    return dist[v];
+}
+
+int PathTree::getParent(int v) const {
+    return parent[v];
+}
@@ -0,0 +1,78 @@
+//---------------------------------------------------------------------------
+// pathtree.h
+// Simple class pathtree
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// pathtree class:  the shortest path tree from one source, stored as
+//   plain int arrays of the previous node and distance of each node
+//
+// getPath reads a path by following the previous nodes from the target
+// back to the source, writing it from the back of a buffer the tree owns,
+// so it costs the length of the path and allocates nothing.
+// forEachPath gives the path to every node in one depth-first pass down
+// the tree: the path to a node is the stack of that pass, so each path is
+// only extended by one node from the path to its parent.
+//
+// Assumptions:
+//   -- the row is a tree, as filled by Dijkstra, Floyd or DynamicPaths
+//   -- a path is valid until the next call on the same tree
+//---------------------------------------------------------------------------
+#ifndef PATHTREE_H
+#define PATHTREE_H
+#include <functional>
+#include <vector>
+#include "tabletype.h"
+using namespace std;
+
+// the nodes of a path from the source, both ends included
+struct PathSlice {
+    const int* nodes;
+    int length;
+};
+
+
+class PathTree {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class pathtree
+    PathTree();
+
+//------------------------------ assign -------------------------------------
+// assign
+// copies the tree from the given source out of a row of TableType
+// with the given number of nodes
+    void assign(int, const TableType[], int);
+
+//------------------------------ getPath ------------------------------------
+// getPath
+// the path from the source to the given node, length 0 if not reached
+    PathSlice getPath(int);
+
+//---------------------------- forEachPath ----------------------------------
+// forEachPath
+// calls visit(node, path) for every node reached other than the source,
+// in depth-first order of the tree
+    void forEachPath(const function<void(int, PathSlice)>&);
+
+//------------------------------ accessors ----------------------------------
+// getSource: the source of the tree
+// getSize:   the number of nodes
+// getDist:   the distance from the source, INT_MAX if not reached
+// getParent: the previous node in the path, 0 for the source
+    int getSource() const;
+    int getSize() const;
+    int getDist(int) const;
+    int getParent(int) const;
+
+private:
+    int source;                        // the root of the tree
+    int size;                          // the number of nodes
+    vector<int> parent;                // previous node, 0 if none
+    vector<int> dist;                  // distance from the source
+    vector<int> childOffsets;          // first child of each node
+    vector<int> children;              // the children of every node
+    vector<int> buffer;                // the path being read
+    vector<int> next;                  // next child of each node on a path
+};
+#endif
@@ -0,0 +1,353 @@
+//---------------------------------------------------------------------------
+// reorder.cpp
+// Simple class reorder
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// reorder class:  numbers the nodes of a GraphCSR again so that nodes
+//   used together are close together in memory
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph must outlive the reorder object and not change
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "reorder.h"
+
+// breadth-first searches of byRcm looking for a node far from the rest
+static const int PERIPHERAL_ROUNDS = 8;
+
+namespace {
+
+//---------------------------------------------------------------------------
+// the nodes 1 .. n kept by an integer key, with the largest key found in
+// constant time when keys only go up and down by small steps: one list
+// for each key, and the largest key with a list not empty
+class KeyBuckets {
+public:
+    // every node starts with key 0, node 1 first in its list
+    explicit KeyBuckets(int n)
+        : key(n + 1, 0), next(n + 1, 0), prev(n + 1, 0), in(n + 1, true),
+          head(1, 0), top(0) {
+        for (int v = n; v >= 1; v--) link(v);
+        in[0] = false;
+    }
+
+    // changes the key of a node still kept
+    void add(int v, int change) {
+        if (!in[v]) return;
+        unlink(v);
+        key[v] += change;
+        link(v);
+    }
+
+    // takes a node out
+    void remove(int v) {
+        if (!in[v]) return;
+        unlink(v);
+        in[v] = false;
+    }
+
+    // takes out the node with the largest key, 0 when none is left
+    int pop() {
+        while (top > 0 && head[top] == 0) top--;
+        int v = head[top];
+        if (v != 0) remove(v);
+        return v;
+    }
+
+private:
+    vector<int> key;                   // the key of each node
+    vector<int> next;                  // the next node in its list, or 0
+    vector<int> prev;                  // the one before it, or 0
+    vector<bool> in;                   // whether the node is still kept
+    vector<int> head;                  // the first node with each key
+    int top;                           // no list above it has a node
+
+    void link(int v) {
+        int k = key[v];
+        if (k >= (int)head.size()) head.resize(k + 1, 0);
+        prev[v] = 0;
+        next[v] = head[k];
+        if (head[k] != 0) prev[head[k]] = v;
+        head[k] = v;
+        if (k > top) top = k;
+    }
+
+    void unlink(int v) {
+        if (prev[v] != 0) next[prev[v]] = next[v];
+        else head[key[v]] = next[v];
+        if (next[v] != 0) prev[next[v]] = prev[v];
+    }
+};
+
+//------------------------------ levels -------------------------------------
+// levels
+// a breadth-first search of the nodes reached from start that are not yet
+// placed; gives the nodes of the last level and returns the number of
+// levels; level is -1 for every node before and after
+int levels(const GraphCSR& both, const vector<bool>& placed, int start,
+           vector<int>& level, vector<int>& queue, vector<int>& last) {
+    queue.assign(1, start);
+    level[start] = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (const int* w = both.edgeBegin(v); w != both.edgeEnd(v); w++) {
+            if (placed[*w] || level[*w] >= 0) continue;
+            level[*w] = level[v] + 1;
+            queue.push_back(*w);
+        }
+    }
+    int deepest = level[queue.back()];
+    last.clear();
+    for (size_t i = 0; i < queue.size(); i++) {
+        if (level[queue[i]] == deepest) last.push_back(queue[i]);
+        level[queue[i]] = -1;
+    }
+    return deepest + 1;
+} // end of levels
+
+} // namespace
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class reorder
+Reorder::Reorder(const GraphCSR& g) : graph(g), method(ORIGINAL) {
+    findOrder(ORIGINAL);
+} // end of Constructor
+
+//----------------------------- findOrder -----------------------------------
+// findOrder
+// numbers the nodes again by the given method
+void Reorder::findOrder(Method m) {
+    method = m;
+    order.clear();
+    if (m == DEGREE) byDegree();
+    else if (m == RCM) byRcm();
+    else if (m == GORDER) byGorder();
+    else {
+        method = ORIGINAL;
+        for (int v = 1; v <= graph.getSize(); v++) order.push_back(v);
+    }
+    number();
+} // end of findOrder
+
+//------------------------------- apply -------------------------------------
+// apply
+// each node's edges are given to assign last to first, as it stores the
+// edges of a node in reverse, so they end up in the same order
+void Reorder::apply(GraphCSR& result) const {
+    int size = graph.getSize();
+    vector<int> from, to, weight;
+    from.reserve(graph.getEdgeCount());
+    to.reserve(graph.getEdgeCount());
+    for (int i = 1; i <= size; i++) {
+        int v = order[i - 1];
+        const int* adj = graph.edgeBegin(v);
+        const int* cost = graph.weightBegin(v);
+        for (int e = graph.degree(v) - 1; e >= 0; e--) {
+            from.push_back(i);
+            to.push_back(newNumber[adj[e]]);
+            if (cost) weight.push_back(cost[e]);
+        }
+    }
+    if (graph.isWeighted()) result.assign(size, from, to, weight);
+    else result.assign(size, from, to);
+    for (int i = 1; i <= size; i++) {
+        result.setData(i, graph.getData(order[i - 1]));
+    }
+} // end of apply
+
+//---------------------------- restoreRow -----------------------------------
+// restoreRow
+// entry i of the reordered row is entry toOld(i) of the old one
+void Reorder::restoreRow(const TableType reordered[], TableType row[]) const {
+    row[0] = reordered[0];
+    for (int i = 1; i <= graph.getSize(); i++) {
+        TableType& entry = row[order[i - 1]];
+        entry = reordered[i];
+        entry.path = entry.path != 0 ? order[entry.path - 1] : 0;
+    }
+} // end of restoreRow
+
+//---------------------------- averageGap -----------------------------------
+// averageGap
+// 0 for a graph with no edges
+double Reorder::averageGap(const GraphCSR& g) {
+    long long total = 0;
+    for (int v = 1; v <= g.getSize(); v++) {
+        for (const int* w = g.edgeBegin(v); w != g.edgeEnd(v); w++) {
+            total += abs(*w - v);
+        }
+    }
+    return g.getEdgeCount() > 0 ? (double)total / g.getEdgeCount() : 0;
+} // end of averageGap
+
+//------------------------------ accessors ----------------------------------
+int Reorder::getSize() const {
+    return graph.getSize();
+}
+
+Reorder::Method Reorder::getMethod() const {
+    return method;
+}
+
+int Reorder::toNew(int v) const {
+    return newNumber[v];
+}
+
+int Reorder::toOld(int i) const {
+    return order[i - 1];
+}
+
+const vector<int>& Reorder::getOrder() const {
+    return order;
+}
+
+//------------------------------ byDegree -----------------------------------
+// byDegree
+// the nodes by edges in and out, most first, then by old number
+void Reorder::byDegree() {
+    int size = graph.getSize();
+    vector<int> degree(size + 1, 0);
+    for (int v = 1; v <= size; v++) {
+        degree[v] += graph.degree(v);
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            degree[*w]++;
+        }
+    }
+    for (int v = 1; v <= size; v++) order.push_back(v);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return degree[a] > degree[b];
+    });
+} // end of byDegree
+
+//------------------------------- byRcm -------------------------------------
+// byRcm
+// each part of the graph not yet placed starts at its node of fewest
+// edges; a few searches then move the start to a node of fewest edges in
+// the last level, while that makes more levels (George and Liu), and the
+// search from there places the part, each node's neighbors by degree
+void Reorder::byRcm() {
+    int size = graph.getSize();
+    vector<int> from, to;
+    for (int v = 1; v <= size; v++) {
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            if (*w == v) continue;
+            from.push_back(v);
+            to.push_back(*w);
+            from.push_back(*w);
+            to.push_back(v);
+        }
+    }
+    GraphCSR both;
+    both.assign(size, from, to);
+    vector<int>().swap(from);
+    vector<int>().swap(to);
+
+    // fewest edges first, then by number
+    auto fewer = [&](int a, int b) {
+        return both.degree(a) != both.degree(b)
+                   ? both.degree(a) < both.degree(b) : a < b;
+    };
+    vector<int> starts;
+    for (int v = 1; v <= size; v++) starts.push_back(v);
+    sort(starts.begin(), starts.end(), fewer);
+
+    vector<bool> placed(size + 1, false);
+    vector<int> level(size + 1, -1), queue, last, next;
+    for (size_t s = 0; s < starts.size(); s++) {
+        int start = starts[s];
+        if (placed[start]) continue;
+        int depth = levels(both, placed, start, level, queue, last);
+        for (int round = 1; round < PERIPHERAL_ROUNDS; round++) {
+            int far = *min_element(last.begin(), last.end(), fewer);
+            vector<int> farLast;
+            int farDepth = levels(both, placed, far, level, queue, farLast);
+            if (farDepth <= depth) break;
+            start = far;
+            depth = farDepth;
+            last.swap(farLast);
+        }
+
+        size_t head = order.size();
+        order.push_back(start);
+        placed[start] = true;
+        for (; head < order.size(); head++) {
+            int v = order[head];
+            next.clear();
+            for (const int* w = both.edgeBegin(v); w != both.edgeEnd(v);
+                 w++) {
+                if (placed[*w]) continue;
+                placed[*w] = true;
+                next.push_back(*w);
+            }
+            sort(next.begin(), next.end(), fewer);
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    reverse(order.begin(), order.end());
+} // end of byRcm
+
+//------------------------------ byGorder -----------------------------------
+// byGorder
+// the key of a node not yet placed is what it has in common with the
+// nodes in the window: one for each edge between them in either direction
+// and one for each node with edges to both; placing a node adds its share
+// to the keys and the node leaving the window takes its share back
+void Reorder::byGorder() {
+    int size = graph.getSize();
+    if (size == 0) return;
+    vector<int> from, to;
+    for (int v = 1; v <= size; v++) {
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            from.push_back(*w);
+            to.push_back(v);
+        }
+    }
+    GraphCSR incoming;
+    incoming.assign(size, from, to);
+    vector<int>().swap(from);
+    vector<int>().swap(to);
+    int hub = max(1, (int)sqrt((double)size));
+
+    KeyBuckets keys(size);
+    auto share = [&](int v, int change) {
+        for (const int* w = graph.edgeBegin(v); w != graph.edgeEnd(v); w++) {
+            keys.add(*w, change);
+        }
+        for (const int* u = incoming.edgeBegin(v);
+             u != incoming.edgeEnd(v); u++) {
+            keys.add(*u, change);
+            if (graph.degree(*u) > hub) continue;
+            for (const int* w = graph.edgeBegin(*u);
+                 w != graph.edgeEnd(*u); w++) {
+                if (*w != v) keys.add(*w, change);
+            }
+        }
+    };
+
+    // the first node is the one with the most edges in
+    int first = 1;
+    for (int v = 2; v <= size; v++) {
+        if (incoming.degree(v) > incoming.degree(first)) first = v;
+    }
+    keys.remove(first);
+    for (int v = first; v != 0; v = keys.pop()) {
+        order.push_back(v);
+        share(v, 1);
+        if (order.size() > (size_t)WINDOW) {
+            share(order[order.size() - 1 - WINDOW], -1);
+        }
+    }
+} // end of byGorder
+
+//------------------------------ number -------------------------------------
+// number
+// fills newNumber from order
+void Reorder::number() {
+    newNumber.assign(graph.getSize() + 1, 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        newNumber[order[i]] = (int)i + 1;
+    }
+} // end of number
@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------
+// reorder.h
+// Simple class reorder
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// reorder class:  numbers the nodes of a GraphCSR again so that nodes
+//   used together are close together in memory, and keeps the
+//   permutation to go back to the numbers of the data file
+//
+// The nodes of a data file are numbered in the order they are listed, so
+// the neighbors of a node can be anywhere in the arrays of a search.
+// findOrder gives each node a new number by one of:
+//   DEGREE   the nodes by the number of edges in and out, most first, so
+//            the nodes most searches pass through share a few cache lines
+//   RCM      reverse Cuthill-McKee over the edges in both directions:
+//            a breadth-first order from a node far from the rest, each
+//            node's neighbors by degree, then the whole order reversed;
+//            every edge joins nodes with close numbers
+//   GORDER   the greedy order of Wei et al.: each next node is the one
+//            with the most in common with the last WINDOW placed, counted
+//            as the edges between them and the nodes with an edge to
+//            both (a node with more than sqrt(size) edges out is not
+//            counted as one in common, as in the paper); much slower to
+//            find than the others on a graph with hubs
+//   ORIGINAL the numbers of the data file, to compare with
+// apply then makes the graph in the new numbers.  A node keeps its
+// description and its edges in the same order; new node i is old node
+// toOld(i).  Search the new graph from toNew(source); restoreRow turns a
+// row of Dijkstra::findShortestPath back into the old numbers.
+//
+// The distances are the same in both numberings.  When a node has more
+// than one shortest path, the path Dijkstra picks depends on the node
+// numbers, so it may be another path of the same length.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- the graph must outlive the reorder object and not change
+//---------------------------------------------------------------------------
+#ifndef REORDER_H
+#define REORDER_H
+#include <vector>
+#include "graphcsr.h"
+#include "tabletype.h"
+
+
+class Reorder {
+public:
+    enum Method { ORIGINAL, DEGREE, RCM, GORDER };
+
+    static const int WINDOW = 5;       // the nodes GORDER compares with
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class reorder
+// starts with the ORIGINAL order
+// the graph must outlive the reorder object
+    Reorder(const GraphCSR&);
+
+//----------------------------- findOrder -----------------------------------
+// findOrder
+// numbers the nodes again by the given method
+    void findOrder(Method);
+
+//------------------------------- apply -------------------------------------
+// apply
+// the graph in the new numbers, with the same descriptions and weights;
+// the given graph must not be the one being reordered
+    void apply(GraphCSR&) const;
+
+//---------------------------- restoreRow -----------------------------------
+// restoreRow
+// copies a row of the reordered graph, indexed by new number, into a row
+// indexed by old number, the previous nodes too; the rows are not the
+// same array
+    void restoreRow(const TableType[], TableType[]) const;
+
+//---------------------------- averageGap -----------------------------------
+// averageGap
+// the mean difference between the numbers of the two ends of an edge,
+// smaller when the neighbors of a node are close to it in memory
+    static double averageGap(const GraphCSR&);
+
+//------------------------------ accessors ----------------------------------
+// getSize:   the number of nodes
+// getMethod: the method of the last findOrder
+// toNew:     the new number of the given old node
+// toOld:     the old number of the given new node
+// getOrder:  the old nodes in their new order; getOrder()[i-1] is toOld(i)
+    int getSize() const;
+    Method getMethod() const;
+    int toNew(int) const;
+    int toOld(int) const;
+    const vector<int>& getOrder() const;
+
+private:
+    const GraphCSR& graph;             // the graph to reorder
+    Method method;                     // the method of the last findOrder
+    vector<int> order;                 // the old nodes in the new order
+    vector<int> newNumber;             // newNumber[v] is the new v
+
+//------------------------------ byDegree -----------------------------------
+// byDegree, byRcm, byGorder
+// fill order by each method
+    void byDegree();
+    void byRcm();
+    void byGorder();
+
+//------------------------------ number -------------------------------------
+// number
+// fills newNumber from order
+    void number();
+};
+#endif
@@ -0,0 +1,274 @@
+//---------------------------------------------------------------------------
+// resultwriter.cpp
+// Simple class resultwriter
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// resultwriter class:  buffered output of results, without streams
+//
+// Assumptions:
+//   -- POSIX write and mmap
+//   -- a writer is used by one thread at a time
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "resultwriter.h"
+
+// "00" "01" .. "99", so a number is formatted two digits at a time
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class resultwriter
+ResultWriter::ResultWriter()
+    : stream(NULL), fd(-1), ownsFd(false), mapped(false), failed(false),
+      begin(NULL), at(NULL), end(NULL), written(0) {
+} // end of Constructor
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class resultwriter
+// writes to the given stream
+ResultWriter::ResultWriter(ostream& out)
+    : stream(&out), fd(-1), ownsFd(false), mapped(false), failed(false),
+      buffer(BUFFER_SIZE), written(0) {
+    begin = at = buffer.data();
+    end = begin + buffer.size();
+} // end of Constructor
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class resultwriter
+// writes to the given file descriptor
+ResultWriter::ResultWriter(int file)
+    : stream(NULL), fd(file), ownsFd(false), mapped(false), failed(false),
+      buffer(BUFFER_SIZE), written(0) {
+    begin = at = buffer.data();
+    end = begin + buffer.size();
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class resultwriter
+ResultWriter::~ResultWriter() {
+    close();
+} // end of Destructor
+
+//------------------------------- open --------------------------------------
+// open
+// creates or truncates the named file and writes to it, through a
+// memory mapping if mapped is true
+bool ResultWriter::open(const char* filename, bool useMapping) {
+    close();
+    int file = ::open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) return false;
+    fd = file;
+    ownsFd = true;
+    failed = false;
+    written = 0;
+    mapped = useMapping;
+    if (mapped) {
+        mapWindow(0);
+        if (failed) {
+            close();
+            return false;
+        }
+    }
+    else {
+        buffer.resize(BUFFER_SIZE);
+        begin = at = buffer.data();
+        end = begin + buffer.size();
+    }
+    return true;
+} // end of open
+
+//------------------------------- close -------------------------------------
+// close
+// writes what is left in the buffer and closes a file the writer opened
+// a mapped file is cut to the length written
+bool ResultWriter::close() {
+    if (mapped) {
+        long long length = unmapWindow();
+        if (ftruncate(fd, length) != 0) failed = true;
+        mapped = false;
+    }
+    else {
+        flush();
+    }
+    if (ownsFd && ::close(fd) != 0) failed = true;
+    ownsFd = false;
+    fd = -1;
+    stream = NULL;
+    begin = at = end = NULL;
+    return !failed;
+} // end of close
+
+//------------------------------- flush -------------------------------------
+// flush
+// writes what is in the buffer; a mapped window needs no writing
+bool ResultWriter::flush() {
+    if (mapped || at == begin) return !failed;
+    size_t length = at - begin;
+    if (stream != NULL) {
+        stream->write(begin, length);
+        stream->flush();
+        if (stream->fail()) failed = true;
+    }
+    else if (fd >= 0) {
+        const char* p = begin;
+        while (length > 0) {
+            ssize_t n = ::write(fd, p, length);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                failed = true;
+                break;
+            }
+            p += n;
+            length -= n;
+        }
+    }
+    written += at - begin;
+    at = begin;
+    return !failed;
+} // end of flush
+
+//-------------------------------- put --------------------------------------
+// put
+// adds a character, text, or raw bytes
+void ResultWriter::put(char c) {
+    if (at == end) spill();
+    if (at != end) *at++ = c;
+}
+
+void ResultWriter::put(const char* text) {
+    put(text, strlen(text));
+}
+
+void ResultWriter::put(const string& text) {
+    put(text.data(), text.size());
+}
+
+void ResultWriter::put(const void* data, size_t length) {
+    const char* p = (const char*)data;
+    while (length > 0) {
+        if (at == end) spill();
+        if (at == end) return;           // nowhere to write
+        size_t n = min(length, (size_t)(end - at));
+        memcpy(at, p, n);
+        at += n;
+        p += n;
+        length -= n;
+    }
+} // end of put
+
+//------------------------------- putInt ------------------------------------
+// putInt
+// adds a number in decimal; the digits are made from the back of a small
+// array two at a time, then copied in after any padding
+void ResultWriter::putInt(long long value) {
+    putInt(value, 0);
+}
+
+void ResultWriter::putInt(long long value, int width) {
+    char digits[24];
+    char* p = digits + sizeof(digits);
+    unsigned long long n = value < 0 ? 0ULL - (unsigned long long)value
+                                     : (unsigned long long)value;
+    while (n >= 100) {
+        unsigned pair = (unsigned)(n % 100) * 2;
+        n /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (n >= 10) {
+        *--p = DIGIT_PAIRS[n * 2 + 1];
+        *--p = DIGIT_PAIRS[n * 2];
+    }
+    else {
+        *--p = (char)('0' + n);
+    }
+    if (value < 0) *--p = '-';
+
+    int length = (int)(digits + sizeof(digits) - p);
+    room(max(width, length));
+    if (end - at < max(width, length)) return;
+    for (int k = length; k < width; k++) *at++ = ' ';
+    memcpy(at, p, length);
+    at += length;
+} // end of putInt
+
+//------------------------------ putText ------------------------------------
+// putText
+// adds text right-aligned in the given width like setw
+void ResultWriter::putText(const char* text, int width) {
+    int length = (int)strlen(text);
+    for (int k = length; k < width; k++) put(' ');
+    put(text, length);
+} // end of putText
+
+//------------------------------- spill -------------------------------------
+// spill
+// makes room in the buffer: writes it out, or maps the next window
+void ResultWriter::spill() {
+    if (mapped) {
+        mapWindow(unmapWindow());
+    }
+    else {
+        flush();
+    }
+} // end of spill
+
+//------------------------------- room --------------------------------------
+// room
+// makes sure the buffer has room for the given number of bytes
+void ResultWriter::room(size_t length) {
+    if ((size_t)(end - at) < length) spill();
+} // end of room
+
+//---------------------------- mapWindow ------------------------------------
+// mapWindow
+// maps the window of the file holding the given offset
+// a mapping has to start on a page, so the window starts on the page
+// holding the offset; the file is grown to the end of the window first
+void ResultWriter::mapWindow(long long offset) {
+    long long page = sysconf(_SC_PAGESIZE);
+    long long start = offset - offset % page;
+    void* p = MAP_FAILED;
+    if (ftruncate(fd, start + WINDOW_SIZE) == 0) {
+        p = mmap(NULL, WINDOW_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, start);
+    }
+    if (p == MAP_FAILED) {
+        failed = true;
+        begin = at = end = NULL;
+        written = offset;
+        return;
+    }
+    begin = (char*)p;
+    end = begin + WINDOW_SIZE;
+    at = begin + (offset - start);
+    written = start;
+} // end of mapWindow
+
+//---------------------------- unmapWindow ----------------------------------
+// unmapWindow
+// unmaps the current window, returns the file offset of at
+long long ResultWriter::unmapWindow() {
+    long long offset = written + (at - begin);
+    if (begin != NULL) munmap(begin, WINDOW_SIZE);
+    begin = at = end = NULL;
+    return offset;
+} // end of unmapWindow
+
+//------------------------------ accessors ----------------------------------
+bool ResultWriter::good() const {
+    return !failed;
+}
+
+long long ResultWriter::getBytesWritten() const {
+    return written + (at - begin);
+}
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------
+// resultwriter.h
+// Simple class resultwriter
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// resultwriter class:  buffered output of results, without streams
+//
+// Text is gathered in a large buffer and numbers are formatted by hand,
+// two digits at a time, so writing a line costs no call into the stream
+// library and no flush.  The buffer goes to one of three places:
+//   -- an ostream, written in large blocks (e.g. cout)
+//   -- a file descriptor, written with write()
+//   -- a file mapped into memory, where the buffer is a window of the
+//      mapping itself; the file grows one window at a time and is cut
+//      to the written length when the writer is closed
+// The formats are TEXT (the same as the display functions), CSV with a
+// header line, and BINARY, which keeps columns of raw ints; see
+// GraphM::writeAll for the rows each format holds.
+//
+// Assumptions:
+//   -- POSIX write and mmap
+//   -- a writer is used by one thread at a time
+//---------------------------------------------------------------------------
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+class ResultWriter {
+public:
+    enum Format { TEXT, CSV, BINARY };
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class resultwriter
+// writes nothing until open is called
+    ResultWriter();
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class resultwriter
+// writes to the given stream, which must outlive the writer
+    explicit ResultWriter(ostream&);
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class resultwriter
+// writes to the given file descriptor, which the writer does not close
+    explicit ResultWriter(int);
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class resultwriter
+// writes what is left in the buffer and closes a file it opened
+    ~ResultWriter();
+
+//------------------------------- open --------------------------------------
+// open
+// creates or truncates the named file and writes to it, through a
+// memory mapping if mapped is true
+// returns false if the file cannot be opened
+    bool open(const char*, bool = false);
+
+//------------------------------- close -------------------------------------
+// close
+// writes what is left in the buffer and closes a file the writer opened
+// returns false if any write failed
+    bool close();
+
+//------------------------------- flush -------------------------------------
+// flush
+// writes what is in the buffer; returns false if any write failed
+    bool flush();
+
+//-------------------------------- put --------------------------------------
+// put
+// adds a character, text, or raw bytes
+    void put(char);
+    void put(const char*);
+    void put(const string&);
+    void put(const void*, size_t);
+
+//------------------------------- putInt ------------------------------------
+// putInt
+// adds a number in decimal, right-aligned in the given width like setw
+    void putInt(long long);
+    void putInt(long long, int);
+
+//------------------------------ putText ------------------------------------
+// putText
+// adds text right-aligned in the given width like setw
+    void putText(const char*, int);
+
+//------------------------------ accessors ----------------------------------
+// good:            whether every write so far succeeded
+// getBytesWritten: the number of bytes added so far
+    bool good() const;
+    long long getBytesWritten() const;
+
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;     // for streams and fds
+    static const size_t WINDOW_SIZE = 64 << 20;    // for a mapped file
+
+    ostream* stream;                   // the stream written to, or NULL
+    int fd;                            // the file written to, or -1
+    bool ownsFd;                       // whether close closes fd
+    bool mapped;                       // whether fd is written by mapping
+    bool failed;                       // whether a write failed
+    vector<char> buffer;               // the buffer for streams and fds
+    char* begin;                       // the buffer or the mapped window
+    char* at;                          // where the next byte goes
+    char* end;                         // the end of begin
+    long long written;                 // bytes before begin in the output
+
+//------------------------------- spill -------------------------------------
+// spill
+// makes room in the buffer: writes it out, or maps the next window
+    void spill();
+
+//------------------------------- room --------------------------------------
+// room
+// makes sure the buffer has room for the given number of bytes
+    void room(size_t);
+
+//---------------------------- mapWindow ------------------------------------
+// mapWindow
+// maps the window of the file holding the given offset
+    void mapWindow(long long);
+
+//---------------------------- unmapWindow ----------------------------------
+// unmapWindow
+// unmaps the current window, returns the file offset of at
+    long long unmapWindow();
+
+    // not copyable, it owns the buffer and maybe the file
+    ResultWriter(const ResultWriter&);
+    ResultWriter& operator=(const ResultWriter&);
+};
+#endif
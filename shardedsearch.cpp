@@ -0,0 +1,455 @@
+//---------------------------------------------------------------------------
+// shardedsearch.cpp
+// Simple class shardedsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// shardedsearch class:  Dijkstra's shortest path algorithm on a graph
+//   split by Partition, with each shard in a worker process of its own
+//
+// Assumptions:
+//   -- edge weights are positive and a distance fits an int
+//   -- start is called before this process starts other threads
+//   -- POSIX fork and Unix sockets
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "shardedsearch.h"
+
+//---------------------------------------------------------------------------
+// The messages.  Each is a command, then for some of them lists of ints,
+// each list its length as a long long and then its ints.
+//   SHARD    the shard of the worker, answered with READY
+//   START    a new search: every node unreached
+//   RUN      the offers to the worker's nodes, 4 ints each: local node,
+//            distance, previous node, distance of the previous node;
+//            answered with the offers to ghosts, 5 ints each: part, then
+//            the 4 ints of the offer there
+//   COLLECT  answered with every node reached, 3 ints each: node,
+//            distance, previous node
+//   QUIT     the worker ends
+
+enum { SHARD = 1, START, RUN, COLLECT, QUIT, READY };
+
+namespace {
+
+// writes all the bytes, even if the socket takes them a part at a time
+bool sendAll(int fd, const void* data, size_t length) {
+    const char* p = (const char*)data;
+    while (length > 0) {
+        ssize_t sent = send(fd, p, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+// reads all the bytes; false if the other end is gone
+bool receiveAll(int fd, void* data, size_t length) {
+    char* p = (char*)data;
+    while (length > 0) {
+        ssize_t got = recv(fd, p, length, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        length -= got;
+    }
+    return true;
+}
+
+bool sendCommand(int fd, int command) {
+    return sendAll(fd, &command, sizeof(command));
+}
+
+bool sendInts(int fd, const vector<int>& list) {
+    long long length = list.size();
+    return sendAll(fd, &length, sizeof(length))
+        && sendAll(fd, list.data(), list.size() * sizeof(int));
+}
+
+bool receiveInts(int fd, vector<int>& list) {
+    long long length;
+    if (!receiveAll(fd, &length, sizeof(length)) || length < 0) return false;
+    list.resize(length);
+    return receiveAll(fd, list.data(), list.size() * sizeof(int));
+}
+
+// sends a shard as its lists, the edges inside it as from, to and weight
+bool sendShard(int fd, const Shard& shard) {
+    vector<int> from, to, weight;
+    const GraphCSR& g = shard.graph;
+    for (int v = 1; v <= g.getSize(); v++) {
+        const int* cost = g.weightBegin(v);
+        for (int e = 0; e < g.degree(v); e++) {
+            from.push_back(v);
+            to.push_back(g.edgeBegin(v)[e]);
+            weight.push_back(cost ? cost[e] : 1);
+        }
+    }
+    return sendCommand(fd, SHARD)
+        && sendInts(fd, shard.nodes) && sendInts(fd, from)
+        && sendInts(fd, to) && sendInts(fd, weight)
+        && sendInts(fd, shard.crossFrom) && sendInts(fd, shard.crossTo)
+        && sendInts(fd, shard.crossWeight) && sendInts(fd, shard.ghostPart)
+        && sendInts(fd, shard.ghostLocal) && sendInts(fd, shard.ghostNode);
+}
+
+// the shard of a worker process and the state of its part of a search
+class Worker {
+public:
+    explicit Worker(int socket) : fd(socket), size(0) {}
+
+    // answers the messages until QUIT or the socket closes
+    void serve() {
+        int command;
+        while (receiveAll(fd, &command, sizeof(command))) {
+            bool ok = false;
+            if (command == SHARD) ok = receiveShard();
+            else if (command == START) ok = startSearch();
+            else if (command == RUN) ok = run();
+            else if (command == COLLECT) ok = collect();
+            if (!ok) return;
+        }
+    }
+
+private:
+    int fd;                            // the socket to the coordinator
+    int size;                          // the number of local nodes
+    GraphCSR graph;                    // the edges inside the shard
+    vector<int> nodes;                 // the global number of each node
+    vector<long long> crossStart;      // the first cross edge of a node
+    vector<int> crossTo, crossWeight;  // the ghost and weight of each
+    vector<int> ghostPart, ghostLocal, ghostNode;
+
+    vector<int> dist;                  // the distance from the source
+    vector<int> prev;                  // the previous node, global
+    vector<int> prevDist;              // the distance of the previous node
+    vector<int> expanded;              // the distance a node was expanded at
+    vector<pair<int, int> > heap;      // (distance, node), smallest first
+
+    vector<int> offerDist, offerPrev, offerPrevDist;   // best to each ghost
+    vector<int> offered;               // the ghosts offered to this round
+
+    // whether the offer (d, pd, p) beats (od, opd, op): a shorter
+    // distance, then a previous node closer to the source, then a smaller
+    // previous node, the order Dijkstra settles the previous nodes in
+    static bool beats(long long d, int pd, int p, int od, int opd, int op) {
+        if (d != od) return d < od;
+        if (pd != opd) return pd < opd;
+        return p < op;
+    }
+
+    bool receiveShard() {
+        vector<int> from, to, weight, crossFrom;
+        if (!receiveInts(fd, nodes) || !receiveInts(fd, from)
+                || !receiveInts(fd, to) || !receiveInts(fd, weight)
+                || !receiveInts(fd, crossFrom) || !receiveInts(fd, crossTo)
+                || !receiveInts(fd, crossWeight) || !receiveInts(fd, ghostPart)
+                || !receiveInts(fd, ghostLocal) || !receiveInts(fd, ghostNode)) {
+            return false;
+        }
+        size = (int)nodes.size();
+        graph.assign(size, from, to, weight);
+
+        // the cross edges come in order of node
+        crossStart.assign(size + 2, 0);
+        for (size_t e = 0; e < crossFrom.size(); e++) {
+            crossStart[crossFrom[e] + 1]++;
+        }
+        for (int v = 1; v <= size; v++) crossStart[v + 1] += crossStart[v];
+
+        size_t ghosts = ghostNode.size();
+        offerDist.assign(ghosts, INT_MAX);
+        offerPrev.assign(ghosts, 0);
+        offerPrevDist.assign(ghosts, 0);
+        return startSearch() && sendCommand(fd, READY);
+    }
+
+    bool startSearch() {
+        dist.assign(size + 1, INT_MAX);
+        prev.assign(size + 1, 0);
+        prevDist.assign(size + 1, 0);
+        expanded.assign(size + 1, -1);
+        return true;
+    }
+
+    // takes an offer to a local node
+    void offer(int v, long long d, int p, int pd) {
+        if (d >= INT_MAX) return;
+        if (!beats(d, pd, p, dist[v], prevDist[v], prev[v])) return;
+        prev[v] = p;
+        prevDist[v] = pd;
+        if (d < dist[v]) {
+            dist[v] = (int)d;
+            heap.push_back(make_pair(dist[v], v));
+            push_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+        }
+    }
+
+    // keeps the best offer to a ghost of this round
+    void offerGhost(int g, long long d, int p, int pd) {
+        if (d >= INT_MAX) return;
+        if (!beats(d, pd, p, offerDist[g], offerPrevDist[g], offerPrev[g])) {
+            return;
+        }
+        if (offerDist[g] == INT_MAX) offered.push_back(g);
+        offerDist[g] = (int)d;
+        offerPrev[g] = p;
+        offerPrevDist[g] = pd;
+    }
+
+    // takes the offers, runs Dijkstra from the nodes whose distance went
+    // down and answers with the offers to ghosts
+    bool run() {
+        vector<int> inbox;
+        if (!receiveInts(fd, inbox)) return false;
+        for (size_t k = 0; k + 3 < inbox.size(); k += 4) {
+            offer(inbox[k], inbox[k + 1], inbox[k + 2], inbox[k + 3]);
+        }
+
+        greater<pair<int, int> > later;
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), later);
+            int v = heap.back().second;
+            int d = heap.back().first;
+            heap.pop_back();
+            if (d != dist[v] || expanded[v] == d) continue;
+            expanded[v] = d;
+
+            const int* adj = graph.edgeBegin(v);
+            const int* cost = graph.weightBegin(v);
+            for (int e = 0; e < graph.degree(v); e++) {
+                offer(adj[e], (long long)d + (cost ? cost[e] : 1),
+                      nodes[v - 1], d);
+            }
+            for (long long e = crossStart[v]; e < crossStart[v + 1]; e++) {
+                offerGhost(crossTo[e], (long long)d + crossWeight[e],
+                           nodes[v - 1], d);
+            }
+        }
+
+        vector<int> outbox;
+        for (size_t k = 0; k < offered.size(); k++) {
+            int g = offered[k];
+            int record[5] = { ghostPart[g], ghostLocal[g], offerDist[g],
+                              offerPrev[g], offerPrevDist[g] };
+            outbox.insert(outbox.end(), record, record + 5);
+            offerDist[g] = INT_MAX;
+        }
+        offered.clear();
+        return sendInts(fd, outbox);
+    }
+
+    bool collect() {
+        vector<int> reached;
+        for (int v = 1; v <= size; v++) {
+            if (dist[v] == INT_MAX) continue;
+            reached.push_back(nodes[v - 1]);
+            reached.push_back(dist[v]);
+            reached.push_back(prev[v]);
+        }
+        return sendInts(fd, reached);
+    }
+};
+
+} // namespace
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class shardedsearch
+ShardedSearch::ShardedSearch()
+    : size(0), lastDist(INT_MAX), rounds(0), messages(0) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class shardedsearch
+// stops the workers
+ShardedSearch::~ShardedSearch() {
+    stop();
+} // end of Destructor
+
+//------------------------------- start -------------------------------------
+// start
+// makes a socket pair for each part, forks the workers, then builds the
+// shards one at a time and sends each to its worker, so this process
+// never holds more than one shard; a worker closes every socket but its
+// own and leaves with _exit, so it never flushes the streams or runs the
+// destructors of this process
+bool ShardedSearch::start(const Partition& partition) {
+    stop();
+    int count = partition.getCount();
+    size = partition.getSize();
+    part.assign(size + 1, 0);
+    local.assign(size + 1, 0);
+    for (int v = 1; v <= size; v++) {
+        part[v] = partition.getPart(v);
+        local[v] = partition.getLocal(v);
+    }
+
+    vector<int> other;                 // the worker's end of each socket
+    for (int s = 0; s < count; s++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0) break;
+        sockets.push_back(pair[0]);
+        other.push_back(pair[1]);
+    }
+
+    bool ok = (int)sockets.size() == count;
+    for (int s = 0; ok && s < count; s++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            for (int t = 0; t < count; t++) close(sockets[t]);
+            for (int t = s + 1; t < count; t++) close(other[t]);
+            Worker worker(other[s]);
+            worker.serve();
+            _exit(0);
+        }
+        if (pid < 0) {
+            ok = false;
+            break;
+        }
+        close(other[s]);
+        other[s] = -1;
+        workers.push_back(pid);
+    }
+    for (size_t s = 0; s < other.size(); s++) {
+        if (other[s] >= 0) close(other[s]);
+    }
+
+    for (int s = 0; ok && s < count; s++) {
+        Shard shard;
+        partition.buildShard(s, shard);
+        int answer;
+        ok = sendShard(sockets[s], shard)
+             && receiveAll(sockets[s], &answer, sizeof(answer))
+             && answer == READY;
+    }
+    if (!ok) stop();
+    return ok;
+} // end of start
+
+//------------------------------- stop --------------------------------------
+// stop
+// tells the workers to end and waits for them
+void ShardedSearch::stop() {
+    for (size_t s = 0; s < sockets.size(); s++) {
+        sendCommand(sockets[s], QUIT);
+        close(sockets[s]);
+    }
+    for (size_t s = 0; s < workers.size(); s++) {
+        while (waitpid(workers[s], NULL, 0) < 0 && errno == EINTR) {
+        }
+    }
+    sockets.clear();
+    workers.clear();
+} // end of stop
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// the source's worker gets the first offer; each round sends the offers
+// to the workers that have some, all at once so the workers search at the
+// same time, then reads what they offer to the other shards; when no
+// offers are left every worker sends the nodes it reached
+bool ShardedSearch::findShortestPath(int source, TableType row[]) {
+    for (int i = 0; i <= size; i++) {
+        row[i].visited = false;
+        row[i].dist = INT_MAX;
+        row[i].path = 0;
+    }
+    rounds = 0;
+    messages = 0;
+    if (!isRunning()) return false;
+    if (source < 1 || source > size) return true;
+
+    int count = (int)sockets.size();
+    bool ok = true;
+    for (int s = 0; ok && s < count; s++) {
+        ok = sendCommand(sockets[s], START);
+    }
+
+    vector<vector<int> > inbox(count);
+    int first[4] = { local[source], 0, 0, 0 };
+    inbox[part[source]].assign(first, first + 4);
+    vector<int> active, outbox;
+    while (ok) {
+        active.clear();
+        for (int s = 0; ok && s < count; s++) {
+            if (inbox[s].empty()) continue;
+            ok = sendCommand(sockets[s], RUN) && sendInts(sockets[s], inbox[s]);
+            inbox[s].clear();
+            active.push_back(s);
+        }
+        if (active.empty()) break;
+        rounds++;
+
+        for (size_t a = 0; ok && a < active.size(); a++) {
+            ok = receiveInts(sockets[active[a]], outbox);
+            for (size_t k = 0; ok && k + 4 < outbox.size(); k += 5) {
+                inbox[outbox[k]].insert(inbox[outbox[k]].end(),
+                                        outbox.begin() + k + 1,
+                                        outbox.begin() + k + 5);
+                messages++;
+            }
+        }
+    }
+
+    vector<int> reached;
+    for (int s = 0; ok && s < count; s++) {
+        ok = sendCommand(sockets[s], COLLECT) && receiveInts(sockets[s], reached);
+        for (size_t k = 0; ok && k + 2 < reached.size(); k += 3) {
+            int v = reached[k];
+            row[v].visited = true;
+            row[v].dist = reached[k + 1];
+            row[v].path = reached[k + 2];
+        }
+    }
+    if (!ok) stop();
+    return ok;
+} // end of findShortestPath
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// one search from the first node, then the path back from the second
+vector<int> ShardedSearch::shortestPath(int start, int end) {
+    lastDist = INT_MAX;
+    vector<int> path;
+    if (end < 1 || end > size) return path;
+    row.resize(size + 1);
+    if (!findShortestPath(start, row.data()) || row[end].dist == INT_MAX) {
+        return path;
+    }
+    lastDist = row[end].dist;
+    for (int v = end; v != 0; v = row[v].path) path.push_back(v);
+    reverse(path.begin(), path.end());
+    return path;
+} // end of shortestPath
+
+//------------------------------ accessors ----------------------------------
+bool ShardedSearch::isRunning() const {
+    return !workers.empty();
+}
+
+int ShardedSearch::getSize() const {
+    return size;
+}
+
+int ShardedSearch::getCount() const {
+    return (int)workers.size();
+}
+
+int ShardedSearch::getDist() const {
+    return lastDist;
+}
+
+int ShardedSearch::getRounds() const {
+    return rounds;
+}
+
+long long ShardedSearch::getMessages() const {
+    return messages;
+}
@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------
+// shardedsearch.h
+// Simple class shardedsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// shardedsearch class:  Dijkstra's shortest path algorithm on a graph
+//   split by Partition, with each shard in a worker process of its own
+//
+// start forks one worker per part, connected to this process by a Unix
+// socket pair, and sends each worker its shard, so a worker holds only
+// the nodes and edges of its part and the search of a large graph can use
+// the memory and the cores of several processes.  This process keeps
+// only where each node is and the row of the last search.
+//
+// A search goes in rounds.  Each round this process sends every worker
+// the distances offered to its nodes; the worker runs Dijkstra inside its
+// shard from the nodes whose distance went down, and answers with the
+// best distance it can offer to each ghost, which goes to the ghost's
+// worker in the next round.  The search ends when a round offers nothing.
+// As edge weights are positive the distances found are the shortest, and
+// of the paths of the same length a node keeps the previous node that is
+// closest to the source, then the smaller number, which is the one that
+// Dijkstra::findShortestPath keeps, so the rows are the same.
+//
+// Assumptions:
+//   -- edge weights are positive and a distance fits an int
+//   -- start is called before this process starts other threads, and
+//      the partition does not change while the workers run
+//   -- POSIX fork and Unix sockets
+//---------------------------------------------------------------------------
+#ifndef SHARDEDSEARCH_H
+#define SHARDEDSEARCH_H
+#include <vector>
+#include <sys/types.h>
+#include "partition.h"
+#include "tabletype.h"
+
+
+class ShardedSearch {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class shardedsearch
+// no workers until start
+    ShardedSearch();
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class shardedsearch
+// stops the workers
+    ~ShardedSearch();
+
+//------------------------------- start -------------------------------------
+// start
+// forks one worker for each part of the partition and gives each its
+// shard; returns false, with no workers left, if one cannot be made
+    bool start(const Partition&);
+
+//------------------------------- stop --------------------------------------
+// stop
+// tells the workers to end and waits for them
+    void stop();
+
+//------------------------- findShortestPath --------------------------------
+// findShortestPath
+// the distance and path of every node from the given source in the given
+// row, as Dijkstra::findShortestPath gives them; returns false, with the
+// workers stopped, if one of them cannot be reached
+    bool findShortestPath(int, TableType[]);
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// the nodes of the shortest path from the first node to the second, both
+// ends included, empty if none
+    vector<int> shortestPath(int, int);
+
+//------------------------------ accessors ----------------------------------
+// isRunning:   whether the workers are running
+// getSize:     the number of nodes
+// getCount:    the number of workers
+// getDist:     the distance of the last path found, INT_MAX if none
+// getRounds:   the number of rounds of the last search
+// getMessages: the number of offers sent between shards by the last search
+    bool isRunning() const;
+    int getSize() const;
+    int getCount() const;
+    int getDist() const;
+    int getRounds() const;
+    long long getMessages() const;
+
+private:
+    int size;                          // the number of nodes
+    vector<int> part;                  // part[v] is the worker of v
+    vector<int> local;                 // local[v] is v's number there
+    vector<int> sockets;               // this end of each worker's socket
+    vector<pid_t> workers;             // the process of each worker
+    vector<TableType> row;             // the row of shortestPath
+    int lastDist;                      // the distance of the last path
+    int rounds;                        // the rounds of the last search
+    long long messages;                // the offers of the last search
+
+    ShardedSearch(const ShardedSearch&);
+    ShardedSearch& operator=(const ShardedSearch&);
+};
+#endif
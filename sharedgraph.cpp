@@ -0,0 +1,288 @@
+//---------------------------------------------------------------------------
+// sharedgraph.cpp
+// Simple class sharedgraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// sharedgraph class:  a weighted graph that many threads can search while
+//   another thread changes it
+//
+// Why the epochs are enough: a reader stores the epoch in its slot before
+// it loads the current version, and a writer advances the epoch after it
+// replaces the current version.  So a reader that loaded a version which
+// was then retired in epoch e stored an epoch of at most e, and stored it
+// before the writer looked at the slots.  All of these are sequentially
+// consistent atomics.
+//
+// Assumptions:
+//   -- a Reader is used by one thread at a time; every Reader is gone
+//      before its SharedGraph
+//   -- the graph of a pinned version is valid until the pin ends
+//   -- edge weights are positive
+//---------------------------------------------------------------------------
+#include <climits>
+#include <cstdlib>
+#include <new>
+#include "sharedgraph.h"
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class reader
+// takes a free slot, or makes one
+SharedGraph::Reader::Reader(SharedGraph& graph)
+    : owner(graph), slot(NULL), pinned(NULL), depth(0), version(-1),
+      searched(-1), dist(INT_MAX) {
+    lock_guard<mutex> hold(owner.slotLock);
+    for (size_t k = 0; k < owner.slots.size(); k++) {
+        if (!owner.slots[k]->used) {
+            slot = owner.slots[k];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        slot = makeSlot();
+        owner.slots.push_back(slot);
+    }
+    slot->epoch.store(0);
+    slot->used = true;
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class reader
+SharedGraph::Reader::~Reader() {
+    depth = 1;
+    unpin();
+    lock_guard<mutex> hold(owner.slotLock);
+    slot->used = false;
+} // end of Destructor
+
+//-------------------------------- pin --------------------------------------
+// pin
+// records the epoch, then loads the current version
+const GraphCSR& SharedGraph::Reader::pin() {
+    if (depth++ > 0) return pinned->graph;
+    slot->epoch.store(owner.epoch.load());
+    pinned = owner.current.load();
+    version = pinned->number;
+    return pinned->graph;
+} // end of pin
+
+//------------------------------- unpin -------------------------------------
+// unpin
+void SharedGraph::Reader::unpin() {
+    if (depth == 0 || --depth > 0) return;
+    pinned = NULL;
+    slot->epoch.store(0);
+} // end of unpin
+
+//---------------------------- shortestPath ---------------------------------
+// shortestPath
+// a bidirectional search on the pinned version; the PathSearch is kept
+// while the version stays the same, and made again for a new one on the
+// reversed edges the version keeps
+vector<int> SharedGraph::Reader::shortestPath(int from, int to) {
+    Pin hold(*this);
+    if (!search || searched != pinned->number) {
+        search.reset(new PathSearch(pinned->graph, pinned->reverse));
+        searched = pinned->number;
+    }
+    vector<int> path = search->shortestPath(from, to);
+    dist = search->getDist();
+    return path;
+} // end of shortestPath
+
+//------------------------------ accessors ----------------------------------
+long long SharedGraph::Reader::getVersion() const {
+    return version;
+}
+
+int SharedGraph::Reader::getDist() const {
+    return dist;
+}
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class sharedgraph
+// epoch 0 means not pinned, so the epochs start at 1
+SharedGraph::SharedGraph()
+    : epoch(1), published(0), pending(0), batches(0) {
+    Version* empty = new Version;
+    empty->number = 0;
+    empty->retiredIn = 0;
+    current.store(empty);
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class sharedgraph
+SharedGraph::~SharedGraph() {
+    delete current.load();
+    for (size_t k = 0; k < retired.size(); k++) delete retired[k];
+    for (size_t k = 0; k < slots.size(); k++) freeSlot(slots[k]);
+} // end of Destructor
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// publishes a new graph read from a data file in the GraphM format
+void SharedGraph::buildGraph(istream& infile) {
+    GraphCSR graph;
+    graph.buildWeightedGraph(infile);
+    assign(graph);
+} // end of buildGraph
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// publishes a new graph from a file parsed by GraphLoader
+void SharedGraph::buildGraph(const GraphLoader& loader) {
+    GraphCSR graph;
+    graph.buildGraph(loader);
+    assign(graph);
+} // end of buildGraph
+
+//------------------------------ assign -------------------------------------
+// assign
+// publishes a copy of the given graph
+void SharedGraph::assign(const GraphCSR& graph) {
+    lock_guard<mutex> hold(writeLock);
+    edges.assign(graph);
+    data.assign(graph.getSize() + 1, NodeData());
+    for (int i = 1; i <= graph.getSize(); i++) data[i] = graph.getData(i);
+    publish();
+} // end of assign
+
+//---------------------------- insertEdge -----------------------------------
+// insertEdge
+// sets the edge in the copy of the edges; publishes unless a batch is
+// open with fewer than MAX_PENDING changes waiting
+void SharedGraph::insertEdge(int i, int j, int weight) {
+    lock_guard<mutex> hold(writeLock);
+    edges.setWeight(i, j, weight);
+    if (++pending >= MAX_PENDING || batches == 0) publish();
+} // end of insertEdge
+
+//---------------------------- removeEdge -----------------------------------
+// removeEdge
+// removes the edge like insertEdge sets it
+void SharedGraph::removeEdge(int i, int j) {
+    insertEdge(i, j, 0);
+} // end of removeEdge
+
+//----------------------------- beginBatch ----------------------------------
+// beginBatch
+// opens a batch, inside any already open
+void SharedGraph::beginBatch() {
+    lock_guard<mutex> hold(writeLock);
+    batches++;
+} // end of beginBatch
+
+//------------------------------ endBatch -----------------------------------
+// endBatch
+// closes a batch; the last one open publishes what is waiting
+void SharedGraph::endBatch() {
+    lock_guard<mutex> hold(writeLock);
+    if (batches > 0) batches--;
+    if (batches == 0 && pending > 0) publish();
+} // end of endBatch
+
+//------------------------------- flush -------------------------------------
+// flush
+// publishes the waiting changes; nothing to do if there are none
+void SharedGraph::flush() {
+    lock_guard<mutex> hold(writeLock);
+    if (pending > 0) publish();
+} // end of flush
+
+//---------------------------- updateEdges ----------------------------------
+// updateEdges
+// sets the weight of every given edge and publishes one version
+void SharedGraph::updateEdges(const vector<EdgeChange>& changes) {
+    lock_guard<mutex> hold(writeLock);
+    for (size_t k = 0; k < changes.size(); k++) {
+        edges.setWeight(changes[k].from, changes[k].to, changes[k].weight);
+    }
+    publish();
+} // end of updateEdges
+
+//------------------------------ reclaim ------------------------------------
+// reclaim
+// frees the retired versions no reader can hold any more
+int SharedGraph::reclaim() {
+    lock_guard<mutex> hold(writeLock);
+    return freeRetired();
+} // end of reclaim
+
+//------------------------------ publish ------------------------------------
+// publish
+// builds the version and its reversed edges, swaps it in, then advances
+// the epoch; the epoch before the advance is the one the old version was
+// retired in
+void SharedGraph::publish() {
+    int size = edges.getSize();
+    vector<int> from, to, weight;
+    for (int v = 1; v <= size; v++) {
+        const vector<pair<int, int> >& out = edges.outgoing(v);
+        for (size_t e = 0; e < out.size(); e++) {
+            from.push_back(v);
+            to.push_back(out[e].first);
+            weight.push_back(out[e].second);
+        }
+    }
+    Version* next = new Version;
+    next->graph.assign(size, from, to, weight);
+    for (int i = 1; i <= size; i++) next->graph.setData(i, data[i]);
+    PathSearch::buildReverse(next->graph, next->reverse);
+    next->number = ++published;
+    next->retiredIn = 0;
+    pending = 0;
+
+    const Version* old = current.exchange(next);
+    const_cast<Version*>(old)->retiredIn = epoch.fetch_add(1);
+    retired.push_back(old);
+    freeRetired();
+} // end of publish
+
+//---------------------------- freeRetired ----------------------------------
+// freeRetired
+// a version retired in epoch e is free when every pinned reader pinned
+// in an epoch after e
+int SharedGraph::freeRetired() {
+    unsigned long long oldest = ULLONG_MAX;   // the oldest pinned epoch
+    {
+        lock_guard<mutex> hold(slotLock);
+        for (size_t k = 0; k < slots.size(); k++) {
+            unsigned long long pinnedIn = slots[k]->epoch.load();
+            if (pinnedIn != 0 && pinnedIn < oldest) oldest = pinnedIn;
+        }
+    }
+    size_t kept = 0;
+    for (size_t k = 0; k < retired.size(); k++) {
+        if (retired[k]->retiredIn < oldest) delete retired[k];
+        else retired[kept++] = retired[k];
+    }
+    retired.resize(kept);
+    return (int)kept;
+} // end of freeRetired
+
+//------------------------------ makeSlot -----------------------------------
+// makeSlot
+// posix_memalign gives the alignment, the Slot is made in place
+SharedGraph::Slot* SharedGraph::makeSlot() {
+    void* memory = NULL;
+    if (posix_memalign(&memory, alignof(Slot), sizeof(Slot)) != 0) {
+        throw bad_alloc();
+    }
+    return new (memory) Slot();
+} // end of makeSlot
+
+//------------------------------ freeSlot -----------------------------------
+// freeSlot
+void SharedGraph::freeSlot(Slot* slot) {
+    slot->~Slot();
+    free(slot);
+} // end of freeSlot
+
+//------------------------------ accessors ----------------------------------
+long long SharedGraph::getVersion() const {
+    return current.load()->number;
+}
+
+int SharedGraph::getPendingCount() const {
+    lock_guard<mutex> hold(writeLock);
+    return pending;
+}
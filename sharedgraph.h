@@ -0,0 +1,275 @@
+//---------------------------------------------------------------------------
+// sharedgraph.h
+// Simple class sharedgraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// sharedgraph class:  a weighted graph that many threads can search while
+//   another thread changes it
+//
+// The graph is kept as versions, each an immutable GraphCSR.  A reader
+// pins the current version and searches it with state of its own (its
+// own PathSearch, Dijkstra or DepthFirst), so readers share nothing that
+// is written and never wait.  A writer applies its changes to a copy of
+// the edges, builds the next version and publishes it with one atomic
+// store; the version it replaces is retired, not freed.  Each version
+// also keeps its edges reversed, built once by the writer, which the
+// PathSearch of every reader of that version shares.
+//
+// Each insertEdge and removeEdge publishes a version, so a reader sees a
+// change as soon as the call returns.  Building a version is O(V + E),
+// so a writer with many single changes may put them in a batch:
+// between beginBatch and endBatch (or while a Batch is in scope) they
+// wait in the copy of the edges and are published together by endBatch,
+// flush, the next updateEdges or assign, or once MAX_PENDING of them have
+// gathered.
+//
+// The retired versions are freed by epochs: a reader records the global
+// epoch when it pins, and a writer advances the epoch when it retires a
+// version.  A retired version is freed once no reader is pinned with an
+// epoch at or before the one it was retired in, since only those readers
+// can still hold it.  Writers run one at a time; they free what they can
+// after each publish and never wait for a reader.
+//
+// Assumptions:
+//   -- a Reader is used by one thread at a time; every Reader is gone
+//      before its SharedGraph
+//   -- the graph of a pinned version is valid until the pin ends
+//   -- edge weights are positive
+//---------------------------------------------------------------------------
+#ifndef SHAREDGRAPH_H
+#define SHAREDGRAPH_H
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "nodedata.h"
+#include "graphcsr.h"
+#include "graphloader.h"
+#include "dynamicgraph.h"
+#include "pathsearch.h"
+
+
+class SharedGraph {
+    struct Version;
+    struct Slot;
+
+public:
+
+//------------------------------- Reader ------------------------------------
+// Reader
+// one thread's way into the graph: pins versions and keeps the search
+// state of that thread
+    class Reader {
+    public:
+
+    //------------------------ Constructor ---------------------------------
+    // Constructor for class reader
+    // registers the reader with the graph
+        explicit Reader(SharedGraph&);
+
+    //------------------------- Destructor ---------------------------------
+    // Destructor for class reader
+    // ends a pin still held and gives back the registration
+        ~Reader();
+
+    //----------------------------- pin ------------------------------------
+    // pin
+    // the current version, which stays valid and unchanged until unpin;
+    // pins nest, a pin inside another gets the same version
+        const GraphCSR& pin();
+
+    //---------------------------- unpin -----------------------------------
+    // unpin
+    // ends the pin; once the outermost pin ends, the version may be
+    // freed
+        void unpin();
+
+    //------------------------- shortestPath -------------------------------
+    // shortestPath
+    // the nodes of the shortest path in the current version from the
+    // first node to the second, both ends included, empty if none;
+    // pins and unpins the version around the search; the search state
+    // is made again, in O(V) on the version's reversed edges, for each
+    // new version the reader sees
+        vector<int> shortestPath(int, int);
+
+    //-------------------------- accessors ---------------------------------
+    // getVersion: the number of the version pinned last
+    // getDist:    the distance of the last path found, INT_MAX if none
+        long long getVersion() const;
+        int getDist() const;
+
+    private:
+        SharedGraph& owner;
+        Slot* slot;                      // this reader's pinned epoch
+        const Version* pinned;           // the version pinned, or NULL
+        int depth;                       // the number of pins held
+        long long version;               // the number of the last pin
+        long long searched;              // the version search was made for
+        unique_ptr<PathSearch> search;   // the search state of this thread
+        int dist;                        // the distance of the last path
+
+        Reader(const Reader&);
+        Reader& operator=(const Reader&);
+    };
+
+//------------------------------- Pin ---------------------------------------
+// Pin
+// pins the current version of a reader for as long as it is in scope
+    class Pin {
+    public:
+        explicit Pin(Reader& r) : reader(r), pinned(r.pin()) {}
+        ~Pin() { reader.unpin(); }
+        const GraphCSR& graph() const { return pinned; }
+    private:
+        Reader& reader;
+        const GraphCSR& pinned;
+        Pin(const Pin&);
+        Pin& operator=(const Pin&);
+    };
+
+//------------------------------ Batch --------------------------------------
+// Batch
+// a batch of changes for as long as it is in scope
+    class Batch {
+    public:
+        explicit Batch(SharedGraph& g) : graph(g) { graph.beginBatch(); }
+        ~Batch() { graph.endBatch(); }
+    private:
+        SharedGraph& graph;
+        Batch(const Batch&);
+        Batch& operator=(const Batch&);
+    };
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class sharedgraph
+// version 0 is a graph of no nodes
+    SharedGraph();
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class sharedgraph
+// frees every version; no reader may be left
+    ~SharedGraph();
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// publishes a new graph read from a data file in the GraphM format
+    void buildGraph(istream&);
+
+//---------------------------- buildGraph -----------------------------------
+// buildGraph
+// publishes a new graph from a file parsed by GraphLoader, with weight 1
+// edges if the loader read the GraphL format
+    void buildGraph(const GraphLoader&);
+
+//------------------------------ assign -------------------------------------
+// assign
+// publishes a copy of the given graph
+    void assign(const GraphCSR&);
+
+//---------------------------- insertEdge -----------------------------------
+// insertEdge
+// sets the edge between two given nodes and publishes the version; in
+// a batch the version waits for endBatch, flush or MAX_PENDING changes
+    void insertEdge(int, int, int);
+
+//---------------------------- removeEdge -----------------------------------
+// removeEdge
+// removes the edge between two given nodes, publishing like insertEdge
+    void removeEdge(int, int);
+
+//----------------------------- beginBatch ----------------------------------
+// beginBatch
+// starts a batch: insertEdge and removeEdge no longer publish each change
+// batches nest, and hold for every writer until the outermost one ends
+    void beginBatch();
+
+//------------------------------ endBatch -----------------------------------
+// endBatch
+// ends a batch; the outermost publishes the changes still waiting
+    void endBatch();
+
+//------------------------------- flush -------------------------------------
+// flush
+// publishes the changes of insertEdge and removeEdge still waiting, if
+// any, without ending the batch
+    void flush();
+
+//---------------------------- updateEdges ----------------------------------
+// updateEdges
+// sets the weight of every given edge, 0 removes it, and publishes one
+// version with all of them and any changes still waiting; a stream of
+// changes is best given in batches
+// the changes with a node outside 1 .. size are ignored
+    void updateEdges(const vector<EdgeChange>&);
+
+//------------------------------ reclaim ------------------------------------
+// reclaim
+// frees the retired versions no reader can hold any more; returns the
+// number still waiting for readers (every publish calls it)
+    int reclaim();
+
+//------------------------------ accessors ----------------------------------
+// getVersion:      the number of the current version
+// getPendingCount: the changes waiting for the next version
+    long long getVersion() const;
+    int getPendingCount() const;
+
+    // the changes of insertEdge and removeEdge a batch may keep waiting
+    static const int MAX_PENDING = 256;
+
+private:
+    // one published graph
+    struct Version {
+        GraphCSR graph;
+        GraphCSR reverse;                // every edge reversed
+        long long number;                // 0, 1, 2, .. in publish order
+        unsigned long long retiredIn;    // the epoch it was retired in
+    };
+
+    // the epoch a reader pinned in, 0 when not pinned; on a cache line
+    // of its own, as each is written by a different thread
+    struct alignas(64) Slot {
+        atomic<unsigned long long> epoch;
+        bool used;
+    };
+
+    atomic<const Version*> current;      // the version readers pin
+    atomic<unsigned long long> epoch;    // advanced on every retire
+
+    mutable mutex writeLock;             // one writer at a time
+    DynamicGraph edges;                  // the edges of the next version
+    vector<NodeData> data;               // the node information
+    long long published;                 // the number of the last version
+    int pending;                         // changes not yet published
+    int batches;                         // batches begun and not ended
+    vector<const Version*> retired;      // waiting for readers to leave
+
+    mutex slotLock;                      // guards slots
+    vector<Slot*> slots;                 // every reader's slot, reused
+
+//------------------------------ publish ------------------------------------
+// publish
+// builds a version from edges and data, makes it current and retires
+// the one before; writeLock must be held
+    void publish();
+
+//---------------------------- freeRetired ----------------------------------
+// freeRetired
+// frees the retired versions no reader can hold; writeLock must be held
+    int freeRetired();
+
+//------------------------------ makeSlot -----------------------------------
+// makeSlot
+// a Slot on a cache line boundary, which new only promises from C++17
+    static Slot* makeSlot();
+
+//------------------------------ freeSlot -----------------------------------
+// freeSlot
+// frees a Slot made by makeSlot
+    static void freeSlot(Slot*);
+
+    SharedGraph(const SharedGraph&);
+    SharedGraph& operator=(const SharedGraph&);
+};
+#endif
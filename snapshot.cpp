@@ -0,0 +1,463 @@
+//---------------------------------------------------------------------------
+// snapshot.cpp
+// Simple class snapshot
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// snapshot class:  a graph saved in a binary file that is used in place
+//
+// Assumptions:
+//   -- the file is read on a machine with the same byte order
+//   -- POSIX mmap
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+//---------------------------------------------------------------------------
+// The file layout.
+
+static const char SNAPSHOT_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P' };
+static const unsigned SNAPSHOT_VERSION = 1;
+static const unsigned SNAPSHOT_WEIGHTED = 1;      // flag bit
+
+struct SnapshotSection {
+    unsigned long long offset;        // from the start of the file
+    unsigned long long length;        // in bytes
+    unsigned long long checksum;      // of the bytes of the section
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    unsigned version;
+    unsigned flags;
+    long long nodes;
+    long long edges;
+    SnapshotSection sections[GraphSnapshot::SECTIONS];
+    unsigned long long checksum;      // of the header before this field
+};
+
+// the checksum of n bytes before any of them is added
+static unsigned long long startChecksum(size_t n) {
+    return 0x9E3779B97F4A7C15ULL ^ n;
+}
+
+// adds whole eight-byte words to a checksum; returns the bytes used
+static size_t addWords(unsigned long long& h, const char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long word;
+        memcpy(&word, p + i, 8);
+        h = (h ^ word) * 0x100000001B3ULL;
+        h ^= h >> 29;
+    }
+    return i;
+}
+
+// adds the last bytes, fewer than eight, and ends a checksum
+static unsigned long long endChecksum(unsigned long long h, const char* p,
+                                      size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ (unsigned char)p[i]) * 0x100000001B3ULL;
+    }
+    return h ^ (h >> 32);
+}
+
+// a checksum that reads eight bytes at a time
+static unsigned long long checksum(const char* p, size_t n) {
+    unsigned long long h = startChecksum(n);
+    size_t i = addWords(h, p, n);
+    return endChecksum(h, p + i, n - i);
+}
+
+// the number of bytes to pad a length to a multiple of 8
+static size_t padding(size_t n) {
+    return (8 - n % 8) % 8;
+}
+
+static const size_t WRITE_BLOCK = 1 << 20;   // bytes a Writer section holds
+
+// writes all the bytes at the given place in the file
+static bool writeAt(int fd, const char* p, size_t n, unsigned long long at) {
+    while (n > 0) {
+        ssize_t done = pwrite(fd, p, n, at);
+        if (done < 0 && errno == EINTR) continue;
+        if (done <= 0) return false;
+        p += done;
+        n -= done;
+        at += done;
+    }
+    return true;
+}
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class snapshot
+GraphSnapshot::GraphSnapshot()
+    : data(NULL), length(0), size(0), edges(0), offsets(NULL),
+      neighbors(NULL), weights(NULL), textOffsets(NULL), text(NULL) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class snapshot
+// unmaps the file
+GraphSnapshot::~GraphSnapshot() {
+    close();
+} // end of Destructor
+
+//------------------------------- write -------------------------------------
+// write
+// saves the given graph to the named file
+// returns false if the file cannot be written
+bool GraphSnapshot::write(const char* filename, const GraphCSR& graph) {
+    int nodes = graph.getSize();
+    long long count = graph.getEdgeCount();
+    bool weighted = graph.isWeighted();
+
+    // the offsets and the descriptions; the edge arrays of the graph
+    // are written as they are
+    vector<long long> offsetList(nodes + 2, 0);
+    vector<long long> textList(nodes + 2, 0);
+    string allText;
+    const int* first = nodes > 0 ? graph.edgeBegin(1) : NULL;
+    for (int v = 1; v <= nodes; v++) {
+        offsetList[v] = graph.edgeBegin(v) - first;
+        textList[v] = allText.size();
+        ostringstream description;
+        description << graph.getData(v);
+        allText += description.str();
+    }
+    offsetList[nodes + 1] = count;
+    textList[nodes + 1] = allText.size();
+
+    const char* parts[SECTIONS] = {
+        (const char*)offsetList.data(),
+        (const char*)first,
+        weighted ? (const char*)graph.weightBegin(1) : NULL,
+        (const char*)textList.data(),
+        allText.data()
+    };
+    size_t lengths[SECTIONS] = {
+        offsetList.size() * sizeof(long long),
+        (size_t)count * sizeof(int),
+        weighted ? (size_t)count * sizeof(int) : 0,
+        textList.size() * sizeof(long long),
+        allText.size()
+    };
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.flags = weighted ? SNAPSHOT_WEIGHTED : 0;
+    header.nodes = nodes;
+    header.edges = count;
+    unsigned long long at = sizeof(header) + padding(sizeof(header));
+    for (int s = 0; s < SECTIONS; s++) {
+        header.sections[s].offset = at;
+        header.sections[s].length = lengths[s];
+        header.sections[s].checksum = checksum(parts[s], lengths[s]);
+        at += lengths[s] + padding(lengths[s]);
+    }
+    header.checksum = checksum((const char*)&header,
+                               offsetof(SnapshotHeader, checksum));
+
+    ofstream out(filename, ios::binary | ios::trunc);
+    const char zeros[8] = { 0 };
+    out.write((const char*)&header, sizeof(header));
+    out.write(zeros, padding(sizeof(header)));
+    for (int s = 0; s < SECTIONS; s++) {
+        if (lengths[s] > 0) out.write(parts[s], lengths[s]);
+        out.write(zeros, padding(lengths[s]));
+    }
+    out.close();
+    return !out.fail();
+} // end of write
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class writer
+GraphSnapshot::Writer::Writer()
+    : fd(-1), failed(false), nodes(0), edges(0), weighted(false) {
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class writer
+// a file not closed is left without a header, so open rejects it
+GraphSnapshot::Writer::~Writer() {
+    if (fd >= 0) ::close(fd);
+} // end of Destructor
+
+//-------------------------------- open -------------------------------------
+// open
+// places the sections as write does and makes the file that long; the
+// header stays zero until close
+bool GraphSnapshot::Writer::open(const char* filename, int nodeCount,
+                                 long long edgeCount, bool isWeighted,
+                                 long long textLength) {
+    if (fd >= 0) ::close(fd);
+    nodes = nodeCount;
+    edges = edgeCount;
+    weighted = isWeighted;
+    failed = false;
+    unsigned long long lengths[SECTIONS] = {
+        (unsigned long long)(nodes + 2) * sizeof(long long),
+        (unsigned long long)edges * sizeof(int),
+        weighted ? (unsigned long long)edges * sizeof(int) : 0,
+        (unsigned long long)(nodes + 2) * sizeof(long long),
+        (unsigned long long)textLength
+    };
+    unsigned long long at = sizeof(SnapshotHeader)
+                          + padding(sizeof(SnapshotHeader));
+    for (int s = 0; s < SECTIONS; s++) {
+        Part& part = parts[s];
+        part.offset = at;
+        part.length = lengths[s];
+        part.written = 0;
+        part.sum = startChecksum(part.length);
+        part.tailLength = 0;
+        part.buffer.clear();
+        at += part.length + padding(part.length);
+    }
+
+    fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, at) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+} // end of open
+
+//------------------------------- append ------------------------------------
+// append
+// adds the bytes to the checksum, eight at a time, keeping the bytes of
+// a word not yet whole; the section holds up to WRITE_BLOCK bytes before
+// writing them, and more than that are written at once
+bool GraphSnapshot::Writer::append(Section s, const void* data, size_t n) {
+    Part& part = parts[s];
+    if (fd < 0 || failed || n > part.length - part.written) return false;
+    if (n == 0) return true;
+    const char* p = (const char*)data;
+    size_t i = 0;
+    if (part.tailLength > 0) {
+        i = min(n, (size_t)(8 - part.tailLength));
+        memcpy(part.tail + part.tailLength, p, i);
+        part.tailLength += (int)i;
+        if (part.tailLength == 8) {
+            addWords(part.sum, part.tail, 8);
+            part.tailLength = 0;
+        }
+    }
+    if (part.tailLength == 0) {
+        i += addWords(part.sum, p + i, n - i);
+        memcpy(part.tail, p + i, n - i);
+        part.tailLength = (int)(n - i);
+    }
+
+    if (part.buffer.size() + n > WRITE_BLOCK && !flush(part)) return false;
+    if (n >= WRITE_BLOCK) {
+        if (!writeAt(fd, p, n, part.offset + part.written)) {
+            failed = true;
+            return false;
+        }
+    }
+    else {
+        if (part.buffer.empty()) {
+            part.buffer.reserve(min((unsigned long long)WRITE_BLOCK,
+                                    part.length));
+        }
+        part.buffer.insert(part.buffer.end(), p, p + n);
+    }
+    part.written += n;
+    return true;
+} // end of append
+
+//------------------------------- close -------------------------------------
+// close
+// writes what is left of each section, then the header with the
+// checksums
+bool GraphSnapshot::Writer::close() {
+    if (fd < 0) return false;
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.flags = weighted ? SNAPSHOT_WEIGHTED : 0;
+    header.nodes = nodes;
+    header.edges = edges;
+
+    bool ok = !failed;
+    for (int s = 0; s < SECTIONS; s++) {
+        Part& part = parts[s];
+        ok = ok && flush(part) && part.written == part.length;
+        header.sections[s].offset = part.offset;
+        header.sections[s].length = part.length;
+        header.sections[s].checksum =
+            endChecksum(part.sum, part.tail, part.tailLength);
+    }
+    header.checksum = checksum((const char*)&header,
+                               offsetof(SnapshotHeader, checksum));
+    ok = ok && writeAt(fd, (const char*)&header, sizeof(header), 0);
+    ok = ::close(fd) == 0 && ok;
+    fd = -1;
+    return ok;
+} // end of close
+
+//------------------------------- flush -------------------------------------
+// flush
+// writes the bytes a section holds after the ones written before
+bool GraphSnapshot::Writer::flush(Part& part) {
+    unsigned long long at = part.offset + part.written - part.buffer.size();
+    if (!writeAt(fd, part.buffer.data(), part.buffer.size(), at)) {
+        failed = true;
+        return false;
+    }
+    part.buffer.clear();
+    return true;
+} // end of flush
+
+//-------------------------------- open -------------------------------------
+// open
+// maps the named snapshot file; checks the section checksums and the
+// offsets too if verify is true
+// returns false, leaving the snapshot closed, if it is not valid
+bool GraphSnapshot::open(const char* filename, bool verify) {
+    close();
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    data = (const char*)p;
+    length = info.st_size;
+
+    // the header and the size of every section
+    const SnapshotHeader& header = *(const SnapshotHeader*)data;
+    bool valid = memcmp(header.magic, SNAPSHOT_MAGIC, 8) == 0
+        && header.version == SNAPSHOT_VERSION
+        && header.checksum == checksum(data, offsetof(SnapshotHeader, checksum))
+        && header.nodes >= 0 && header.nodes < INT_MAX && header.edges >= 0;
+    bool weighted = (header.flags & SNAPSHOT_WEIGHTED) != 0;
+    unsigned long long expected[SECTIONS] = {
+        (unsigned long long)(header.nodes + 2) * sizeof(long long),
+        (unsigned long long)header.edges * sizeof(int),
+        weighted ? (unsigned long long)header.edges * sizeof(int) : 0,
+        (unsigned long long)(header.nodes + 2) * sizeof(long long),
+        header.sections[TEXT].length
+    };
+    for (int s = 0; valid && s < SECTIONS; s++) {
+        const SnapshotSection& section = header.sections[s];
+        valid = section.offset % 8 == 0 && section.length == expected[s]
+            && section.offset <= length
+            && section.length <= length - section.offset;
+        if (valid && verify) {
+            valid = section.checksum
+                == checksum(data + section.offset, section.length);
+        }
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    size = (int)header.nodes;
+    edges = header.edges;
+    offsets = (const long long*)(data + header.sections[OFFSETS].offset);
+    neighbors = (const int*)(data + header.sections[NEIGHBORS].offset);
+    weights = weighted
+        ? (const int*)(data + header.sections[WEIGHTS].offset) : NULL;
+    textOffsets = (const long long*)(data + header.sections[TEXT_OFFSETS].offset);
+    text = data + header.sections[TEXT].offset;
+
+    // the ends of the offsets, or every offset and edge when verifying
+    long long textLength = (long long)header.sections[TEXT].length;
+    valid = offsets[1] == 0 && offsets[size + 1] == edges
+        && textOffsets[1] == 0 && textOffsets[size + 1] == textLength;
+    for (int v = 1; valid && verify && v <= size; v++) {
+        valid = offsets[v] <= offsets[v + 1]
+            && textOffsets[v] <= textOffsets[v + 1];
+    }
+    for (long long e = 0; valid && verify && e < edges; e++) {
+        valid = neighbors[e] >= 1 && neighbors[e] <= size;
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+    return true;
+} // end of open
+
+//------------------------------- close -------------------------------------
+// close
+// unmaps the file
+void GraphSnapshot::close() {
+    if (data != NULL) munmap((void*)data, length);
+    data = NULL;
+    length = 0;
+    size = 0;
+    edges = 0;
+    offsets = textOffsets = NULL;
+    neighbors = weights = NULL;
+    text = NULL;
+} // end of close
+
+//--------------------------- displayGraph ----------------------------------
+// displayGraph
+// display each node information and edge in the graph, like GraphL
+void GraphSnapshot::displayGraph() const {
+    cout << "Graph:" << endl;
+    for (int i = 1; i <= size; i++) {
+        TextSlice line = getDescription(i);
+        cout << "Node" << i << "        ";
+        cout.write(line.text, line.length);
+        cout << endl;
+        for (const int* e = edgeBegin(i); e != edgeEnd(i); e++) {
+            cout << "  edge " << i << "  " << *e << endl;
+        }
+    }
+    cout << endl;
+} // end of displayGraph
+
+//------------------------------ accessors ----------------------------------
+int GraphSnapshot::getSize() const {
+    return size;
+}
+
+long long GraphSnapshot::getEdgeCount() const {
+    return edges;
+}
+
+int GraphSnapshot::degree(int i) const {
+    return (int)(offsets[i + 1] - offsets[i]);
+}
+
+const int* GraphSnapshot::edgeBegin(int i) const {
+    return neighbors + offsets[i];
+}
+
+const int* GraphSnapshot::edgeEnd(int i) const {
+    return neighbors + offsets[i + 1];
+}
+
+const int* GraphSnapshot::weightBegin(int i) const {
+    return weights ? weights + offsets[i] : NULL;
+}
+
+TextSlice GraphSnapshot::getDescription(int i) const {
+    TextSlice line;
+    line.text = text + textOffsets[i];
+    line.length = (int)(textOffsets[i + 1] - textOffsets[i]);
+    return line;
+}
@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------
+// snapshot.h
+// Simple class snapshot
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// snapshot class:  a graph saved in a binary file that is used in place
+//
+// write saves a GraphCSR (GraphL::buildCSR and GraphM::buildCSR make
+// one) as a header followed by five sections, each 8-byte aligned:
+//   offsets      long long[size + 2]   first edge of each node
+//   neighbors    int[edges]            adjacent node of each edge
+//   weights      int[edges]            only if the graph is weighted
+//   textOffsets  long long[size + 2]   first byte of each description
+//   text         char[]                the descriptions, back to back
+// The header records the position, length and checksum of each section
+// and has a checksum of its own.
+//
+// open maps the file and checks the header; the arrays are then read
+// straight from the mapping, so opening takes the same time for any
+// size of graph.  Checking the section checksums reads the whole file,
+// so open only does it when asked to.  The searches take a CSRView, so
+// they run on an open snapshot as they do on a GraphCSR.
+//
+// A Writer makes the same file from sections given a piece at a time,
+// in any order between the sections, for a graph too large to be held
+// as a GraphCSR (see StreamLoader).
+//
+// Assumptions:
+//   -- the file is read on a machine with the same byte order
+//   -- POSIX mmap
+//---------------------------------------------------------------------------
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <cstddef>
+#include <vector>
+#include "graphcsr.h"
+#include "graphloader.h"
+
+
+class GraphSnapshot {
+public:
+    // the sections of the file, in file order
+    enum Section { OFFSETS, NEIGHBORS, WEIGHTS, TEXT_OFFSETS, TEXT, SECTIONS };
+
+//------------------------------- Writer ------------------------------------
+// Writer
+// writes a snapshot file a section at a time; the sizes are given to
+// open, then each section is appended to in order until it is full
+    class Writer {
+    public:
+        Writer();
+        ~Writer();
+
+    //---------------------------- open ------------------------------------
+    // open
+    // creates the named file for the given number of nodes and edges,
+    // whether it is weighted and the length of the text section
+    // returns false if the file cannot be made
+        bool open(const char*, int, long long, bool, long long);
+
+    //--------------------------- append -----------------------------------
+    // append
+    // adds the given bytes to the end of what the section has so far
+    // returns false if they do not fit in it or cannot be written
+        bool append(Section, const void*, size_t);
+
+    //---------------------------- close -----------------------------------
+    // close
+    // writes what is left and the header; returns false if a section is
+    // not full or the file cannot be written
+        bool close();
+
+    private:
+        // where a section goes and how much of it is written
+        struct Part {
+            unsigned long long offset;     // from the start of the file
+            unsigned long long length;     // in bytes
+            unsigned long long written;    // the bytes given so far
+            unsigned long long sum;        // the checksum of whole words
+            char tail[8];                  // the bytes after the last word
+            int tailLength;
+            vector<char> buffer;           // given but not yet written
+        };
+
+        int fd;                            // the file, -1 when closed
+        bool failed;                       // a write went wrong
+        int nodes;
+        long long edges;
+        bool weighted;
+        Part parts[SECTIONS];
+
+        bool flush(Part&);
+
+        Writer(const Writer&);
+        Writer& operator=(const Writer&);
+    };
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class snapshot
+    GraphSnapshot();
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class snapshot
+// unmaps the file
+    ~GraphSnapshot();
+
+//------------------------------- write -------------------------------------
+// write
+// saves the given graph to the named file
+// returns false if the file cannot be written
+    static bool write(const char*, const GraphCSR&);
+
+//-------------------------------- open -------------------------------------
+// open
+// maps the named snapshot file; checks the section checksums and the
+// offsets too if verify is true
+// returns false, leaving the snapshot closed, if it is not valid
+    bool open(const char*, bool = false);
+
+//------------------------------- close -------------------------------------
+// close
+// unmaps the file
+    void close();
+
+//--------------------------- displayGraph ----------------------------------
+// displayGraph
+// display each node information and edge in the graph, like GraphL
+    void displayGraph() const;
+
+//------------------------------ accessors ----------------------------------
+// getSize:        the number of nodes
+// getEdgeCount:   the number of edges
+// degree:         the number of edges leaving the given node
+// edgeBegin:      pointer to the first neighbor of the given node
+// edgeEnd:        pointer past the last neighbor of the given node
+// weightBegin:    pointer to the weight of the first edge of the node,
+//                 NULL when the graph is unweighted
+// getDescription: the description of the given node
+    int getSize() const;
+    long long getEdgeCount() const;
+    int degree(int) const;
+    const int* edgeBegin(int) const;
+    const int* edgeEnd(int) const;
+    const int* weightBegin(int) const;
+    TextSlice getDescription(int) const;
+
+private:
+    const char* data;              // the mapped file
+    size_t length;                 // the length of the file
+    int size;                      // the number of nodes
+    long long edges;               // the number of edges
+    const long long* offsets;      // sections inside the mapping
+    const int* neighbors;
+    const int* weights;
+    const long long* textOffsets;
+    const char* text;
+
+    friend class CSRView;          // reads the sections in place
+
+    // not copyable, it owns the mapping
+    GraphSnapshot(const GraphSnapshot&);
+    GraphSnapshot& operator=(const GraphSnapshot&);
+};
+#endif
@@ -0,0 +1,319 @@
+//---------------------------------------------------------------------------
+// stats.cpp
+// Simple class stats
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// stats class:  counters and timers of the graph algorithms, per thread
+//
+// Each thread has a ThreadStats, made on its first count and put in a
+// registry; when the thread ends its counts are moved into the totals of
+// ended threads.  A counter is written only by its own thread, with a
+// relaxed load and store, and read by snapshot from any thread.
+//
+// Assumptions:
+//   -- counts are taken while the threads run; a snapshot taken during a
+//      search may miss the part of it not yet added
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "stats.h"
+
+namespace {
+
+const size_t MAX_EVENTS = 1 << 20;     // trace events kept per thread
+
+// a timer kept for the trace
+struct TraceEvent {
+    Stats::Phase phase;
+    long long start;                   // nanoseconds of the steady clock
+    long long duration;
+};
+
+// the counts of one thread
+struct ThreadStats {
+    atomic<long long> counter[Stats::COUNTERS];
+    atomic<long long> calls[Stats::PHASES];
+    atomic<long long> nanoseconds[Stats::PHASES];
+    int id;                            // the tid of the trace
+    long long timers;                  // timers started, for sampling
+    mutex eventLock;                   // guards events
+    vector<TraceEvent> events;
+};
+
+void clear(Stats::Snapshot& s) {
+    fill(s.counter, s.counter + Stats::COUNTERS, 0LL);
+    fill(s.calls, s.calls + Stats::PHASES, 0LL);
+    fill(s.nanoseconds, s.nanoseconds + Stats::PHASES, 0LL);
+}
+
+// the counters of ended threads, and the registry of the running ones
+struct Registry {
+    Registry() : nextId(0), sampleEvery(0), traceStart(0) {
+        clear(ended);
+    }
+
+    mutex lock;
+    vector<ThreadStats*> threads;
+    Stats::Snapshot ended;
+    vector<pair<int, TraceEvent> > endedEvents;
+    int nextId;
+    atomic<int> sampleEvery;
+    long long traceStart;
+};
+
+Registry& registry() {
+    static Registry r;                 // made before any ThreadStats
+    return r;
+}
+
+long long now() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool isMax(int c) {
+    return c == Stats::DFS_MAX_DEPTH;
+}
+
+// adds the counts of one thread to a snapshot
+void combine(Stats::Snapshot& total, ThreadStats& t) {
+    for (int c = 0; c < Stats::COUNTERS; c++) {
+        long long value = t.counter[c].load(memory_order_relaxed);
+        total.counter[c] = isMax(c) ? max(total.counter[c], value)
+                                    : total.counter[c] + value;
+    }
+    for (int p = 0; p < Stats::PHASES; p++) {
+        total.calls[p] += t.calls[p].load(memory_order_relaxed);
+        total.nanoseconds[p] += t.nanoseconds[p].load(memory_order_relaxed);
+    }
+}
+
+void clear(ThreadStats& t) {
+    for (int c = 0; c < Stats::COUNTERS; c++) t.counter[c] = 0;
+    for (int p = 0; p < Stats::PHASES; p++) {
+        t.calls[p] = 0;
+        t.nanoseconds[p] = 0;
+    }
+}
+
+// the ThreadStats of a thread, registered while the thread runs
+struct LocalStats {
+    ThreadStats stats;
+
+    LocalStats() {
+        clear(stats);
+        stats.timers = 0;
+        Registry& r = registry();
+        lock_guard<mutex> hold(r.lock);
+        stats.id = ++r.nextId;
+        r.threads.push_back(&stats);
+    }
+
+    ~LocalStats() {
+        Registry& r = registry();
+        lock_guard<mutex> hold(r.lock);
+        combine(r.ended, stats);
+        for (size_t e = 0; e < stats.events.size(); e++) {
+            r.endedEvents.push_back(make_pair(stats.id, stats.events[e]));
+        }
+        r.threads.erase(find(r.threads.begin(), r.threads.end(), &stats));
+    }
+};
+
+ThreadStats& local() {
+    static thread_local LocalStats l;
+    return l.stats;
+}
+
+// writes nanoseconds as microseconds with three decimals
+void putMicroseconds(ResultWriter& out, long long ns) {
+    out.putInt(ns / 1000);
+    out.put('.');
+    int fraction = (int)(ns % 1000);
+    if (fraction < 100) out.put('0');
+    if (fraction < 10) out.put('0');
+    out.putInt(fraction);
+}
+
+// writes one event, unless it began before the trace; returns whether
+// the next event is still the first
+bool putEvent(ResultWriter& out, int id, const TraceEvent& e, long long base,
+              bool first) {
+    if (e.start < base) return first;
+    out.put(first ? "\n" : ",\n");
+    out.put("{\"name\":\"");
+    out.put(Stats::phaseName(e.phase));
+    out.put("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+    out.putInt(id);
+    out.put(",\"ts\":");
+    putMicroseconds(out, e.start - base);
+    out.put(",\"dur\":");
+    putMicroseconds(out, e.duration);
+    out.put('}');
+    return false;
+}
+
+} // namespace
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class timer
+// decides whether this timer is one of the sampled trace events
+Stats::Timer::Timer(Phase p) : phase(p), traced(false) {
+    int every = registry().sampleEvery.load(memory_order_relaxed);
+    if (every > 0 && ++local().timers % every == 0) traced = true;
+    start = now();
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class timer
+// adds the time to the phase, and keeps the event if sampled
+Stats::Timer::~Timer() {
+    long long duration = now() - start;
+    ThreadStats& t = local();
+    t.calls[phase].store(t.calls[phase].load(memory_order_relaxed) + 1,
+                         memory_order_relaxed);
+    t.nanoseconds[phase].store(
+        t.nanoseconds[phase].load(memory_order_relaxed) + duration,
+        memory_order_relaxed);
+    if (traced) {
+        lock_guard<mutex> hold(t.eventLock);
+        if (t.events.size() < MAX_EVENTS) {
+            TraceEvent e = { phase, start, duration };
+            t.events.push_back(e);
+        }
+    }
+} // end of Destructor
+
+//-------------------------------- add --------------------------------------
+// add
+// adds to a counter of this thread
+void Stats::add(Counter c, long long n) {
+    atomic<long long>& slot = local().counter[c];
+    slot.store(slot.load(memory_order_relaxed) + n, memory_order_relaxed);
+} // end of add
+
+//------------------------------- raise -------------------------------------
+// raise
+// keeps the largest value of a counter of this thread
+void Stats::raise(Counter c, long long n) {
+    atomic<long long>& slot = local().counter[c];
+    if (n > slot.load(memory_order_relaxed)) {
+        slot.store(n, memory_order_relaxed);
+    }
+} // end of raise
+
+//------------------------------ snapshot -----------------------------------
+// snapshot
+// the counts of the ended threads plus those of the running ones
+Stats::Snapshot Stats::snapshot() {
+    Registry& r = registry();
+    lock_guard<mutex> hold(r.lock);
+    Snapshot total = r.ended;
+    for (size_t k = 0; k < r.threads.size(); k++) {
+        combine(total, *r.threads[k]);
+    }
+    return total;
+} // end of snapshot
+
+//------------------------------- reset -------------------------------------
+// reset
+// sets every count back to 0; a running thread's count taken at the same
+// time may be lost
+void Stats::reset() {
+    Registry& r = registry();
+    lock_guard<mutex> hold(r.lock);
+    clear(r.ended);
+    for (size_t k = 0; k < r.threads.size(); k++) clear(*r.threads[k]);
+} // end of reset
+
+//------------------------------- write -------------------------------------
+// write
+// a snapshot as a JSON object
+void Stats::write(ResultWriter& out) {
+    Snapshot s = snapshot();
+    out.put("{\"counters\": {");
+    for (int c = 0; c < COUNTERS; c++) {
+        out.put(c == 0 ? "\"" : ", \"");
+        out.put(counterName((Counter)c));
+        out.put("\": ");
+        out.putInt(s.counter[c]);
+    }
+    out.put("},\n \"phases\": {");
+    for (int p = 0; p < PHASES; p++) {
+        out.put(p == 0 ? "\"" : ", \"");
+        out.put(phaseName((Phase)p));
+        out.put("\": {\"calls\": ");
+        out.putInt(s.calls[p]);
+        out.put(", \"ns\": ");
+        out.putInt(s.nanoseconds[p]);
+        out.put('}');
+    }
+    out.put("}}\n");
+} // end of write
+
+//---------------------------- startTrace -----------------------------------
+// startTrace
+// keeps every n-th timer of each thread from now on, dropping the events
+// kept so far
+void Stats::startTrace(int every) {
+    Registry& r = registry();
+    lock_guard<mutex> hold(r.lock);
+    r.endedEvents.clear();
+    for (size_t k = 0; k < r.threads.size(); k++) {
+        lock_guard<mutex> holdEvents(r.threads[k]->eventLock);
+        r.threads[k]->events.clear();
+    }
+    r.traceStart = now();
+    r.sampleEvery.store(every < 0 ? 0 : every, memory_order_relaxed);
+} // end of startTrace
+
+//---------------------------- writeTrace -----------------------------------
+// writeTrace
+// the events as complete ("X") events of one process, one tid per
+// thread, times in microseconds from startTrace
+void Stats::writeTrace(ResultWriter& out) {
+    Registry& r = registry();
+    lock_guard<mutex> hold(r.lock);
+    bool first = true;
+    out.put("{\"traceEvents\": [");
+    for (size_t e = 0; e < r.endedEvents.size(); e++) {
+        first = putEvent(out, r.endedEvents[e].first,
+                         r.endedEvents[e].second, r.traceStart, first);
+    }
+    for (size_t k = 0; k < r.threads.size(); k++) {
+        ThreadStats& t = *r.threads[k];
+        lock_guard<mutex> holdEvents(t.eventLock);
+        for (size_t e = 0; e < t.events.size(); e++) {
+            first = putEvent(out, t.id, t.events[e], r.traceStart, first);
+        }
+    }
+    out.put("\n], \"displayTimeUnit\": \"ms\"}\n");
+} // end of writeTrace
+
+//------------------------------ accessors ----------------------------------
+bool Stats::isEnabled() {
+#ifdef GRAPH_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* Stats::counterName(Counter c) {
+    static const char* names[COUNTERS] = {
+        "nodes_scanned", "edges_relaxed", "sources_searched", "dfs_nodes",
+        "dfs_max_depth", "bytes_allocated", "bytes_parsed", "edges_parsed"
+    };
+    return names[c];
+}
+
+const char* Stats::phaseName(Phase p) {
+    static const char* names[PHASES] = {
+        "load_file", "build_graph", "shortest_path", "source_search",
+        "depth_first", "display"
+    };
+    return names[p];
+}
@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+// stats.h
+// Simple class stats
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// stats class:  counters and timers of the graph algorithms, per thread
+//
+// The algorithms count their work with STATS_ADD and STATS_MAX and time
+// their phases with STATS_TIMER.  The macros do nothing unless the tree
+// is compiled with -DGRAPH_STATS, so without it there is no cost at all.
+// With it, every thread adds into counters of its own, never shared with
+// another thread, so counting takes no lock and no atomic add; the hot
+// loops keep their counts in locals and add them once per search.
+// snapshot sums the counters of all the threads, including those that
+// have ended, and write gives them as JSON.
+//
+// A Timer adds its time and one call to its phase when it goes out of
+// scope.  After startTrace(n), every n-th timer of each thread is also
+// kept as a trace event, and writeTrace gives the events in the Chrome
+// trace format (load the file in chrome://tracing or Perfetto).
+//
+// Assumptions:
+//   -- counts are taken while the threads run; a snapshot taken during a
+//      search may miss the part of it not yet added
+//---------------------------------------------------------------------------
+#ifndef STATS_H
+#define STATS_H
+#include "resultwriter.h"
+
+#ifdef GRAPH_STATS
+#define STATS_CONCAT2(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT2(a, b)
+#define STATS_ADD(counter, n) Stats::add(Stats::counter, (n))
+#define STATS_MAX(counter, n) Stats::raise(Stats::counter, (n))
+#define STATS_TIMER(phase) \
+    Stats::Timer STATS_CONCAT(statsTimer, __LINE__)(Stats::phase)
+#else
+#define STATS_ADD(counter, n) ((void)0)
+#define STATS_MAX(counter, n) ((void)0)
+#define STATS_TIMER(phase) ((void)0)
+#endif
+
+
+class Stats {
+public:
+    enum Counter {
+        NODES_SCANNED,      // nodes taken from the heap by Dijkstra
+        EDGES_RELAXED,      // edges looked at by Dijkstra
+        SOURCES_SEARCHED,   // single-source searches by Dijkstra
+        DFS_NODES,          // nodes reached by depth-first searches
+        DFS_MAX_DEPTH,      // the deepest stack of a depth-first search
+        BYTES_ALLOCATED,    // memory held by the graphs built
+        BYTES_PARSED,       // bytes of data files read by GraphLoader
+        EDGES_PARSED,       // edges read by GraphLoader
+        COUNTERS
+    };
+
+    enum Phase {
+        LOAD_FILE,          // GraphLoader::load
+        BUILD_GRAPH,        // the buildGraph functions
+        SHORTEST_PATH,      // the all-pairs findShortestPath functions
+        SOURCE_SEARCH,      // one source of Dijkstra
+        DEPTH_FIRST,        // a depth-first search
+        DISPLAY,            // the display and write functions
+        PHASES
+    };
+
+    // the counters and the phase times of every thread together
+    struct Snapshot {
+        long long counter[COUNTERS];
+        long long calls[PHASES];
+        long long nanoseconds[PHASES];
+    };
+
+//------------------------------- Timer -------------------------------------
+// Timer
+// adds the time from its construction to its destruction to a phase
+    class Timer {
+    public:
+        explicit Timer(Phase);
+        ~Timer();
+    private:
+        Phase phase;
+        long long start;               // nanoseconds of the steady clock
+        bool traced;                   // kept as a trace event
+        Timer(const Timer&);
+        Timer& operator=(const Timer&);
+    };
+
+//-------------------------------- add --------------------------------------
+// add
+// adds to a counter of this thread
+    static void add(Counter, long long);
+
+//------------------------------- raise -------------------------------------
+// raise
+// sets a counter of this thread to the given value if that is larger;
+// snapshot takes the largest over the threads, not the sum
+    static void raise(Counter, long long);
+
+//------------------------------ snapshot -----------------------------------
+// snapshot
+// the counters and phases of every thread, summed
+    static Snapshot snapshot();
+
+//------------------------------- reset -------------------------------------
+// reset
+// sets every counter and phase of every thread back to 0
+    static void reset();
+
+//------------------------------- write -------------------------------------
+// write
+// a snapshot as a JSON object:
+//   {"counters": {"nodes_scanned": n, ...},
+//    "phases": {"load_file": {"calls": n, "ns": n}, ...}}
+    static void write(ResultWriter&);
+
+//---------------------------- startTrace -----------------------------------
+// startTrace
+// keeps every n-th timer of each thread as a trace event, from now on;
+// 0 stops tracing; the events kept so far are dropped
+    static void startTrace(int);
+
+//---------------------------- writeTrace -----------------------------------
+// writeTrace
+// the trace events kept since startTrace in the Chrome trace format
+    static void writeTrace(ResultWriter&);
+
+//------------------------------ accessors ----------------------------------
+// isEnabled:   whether the tree was compiled with GRAPH_STATS
+// counterName: the name of a counter in the JSON, e.g. "nodes_scanned"
+// phaseName:   the name of a phase in the JSON, e.g. "load_file"
+    static bool isEnabled();
+    static const char* counterName(Counter);
+    static const char* phaseName(Phase);
+};
+#endif
@@ -0,0 +1,554 @@
+//---------------------------------------------------------------------------
+// streamloader.cpp
+// Simple class streamloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// streamloader class:  reads a graph data file in pieces and writes it as
+//   a snapshot file, in a given amount of memory however large the graph
+//
+// Assumptions:
+//   -- the budget is at least MIN_BUDGET bytes (a smaller one is raised)
+//   -- the temporary directory has room for the edges
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "streamloader.h"
+#include "stats.h"
+
+const size_t StreamLoader::MIN_BUDGET;
+
+static const size_t IO_BLOCK = 1 << 20;    // bytes of each file buffer
+static const size_t LOAD_BLOCKS = 4;       // input, text, offsets, run
+static const size_t MERGE_BLOCKS = 8;      // the snapshot sections, a run
+static const size_t MAX_NUMBER = 24;       // longest number scanned
+
+//---------------------------------------------------------------------------
+// Reading the input a block at a time.
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r'
+        || c == '\v' || c == '\f';
+}
+
+namespace {
+
+// the bytes of a file descriptor, read a block at a time; the bytes of
+// the block not used yet are [begin, end)
+class Input {
+public:
+    explicit Input(int descriptor)
+        : fd(descriptor), buffer(IO_BLOCK), begin(0), end(0), done(false),
+          failed(false), bytes(0) {}
+
+    // makes at least n bytes available, fewer only at the end of the input
+    void need(size_t n) {
+        if (end - begin >= n || done) return;
+        memmove(&buffer[0], &buffer[begin], end - begin);
+        end -= begin;
+        begin = 0;
+        while (end < n && !done) {
+            ssize_t got = ::read(fd, &buffer[end], buffer.size() - end);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) failed = true;
+            if (got <= 0) {
+                done = true;
+            }
+            else {
+                end += got;
+                bytes += got;
+            }
+        }
+    }
+
+    // skips white space, then reads an integer into value, like the
+    // scanInt of GraphLoader
+    // returns 1 if read, 0 at the end of the input, -1 if not a number
+    int scanInt(int& value) {
+        for (;;) {
+            while (begin < end && isSpace(buffer[begin])) begin++;
+            if (begin < end) break;
+            need(1);
+            if (begin == end) return 0;
+        }
+        need(MAX_NUMBER);
+        const char* p = &buffer[begin];
+        const char* stop = &buffer[0] + end;
+
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = *p == '-';
+            p++;
+        }
+        const char* digits = p;
+        long long n = 0;
+        while (p < stop && *p >= '0' && *p <= '9') {
+            n = n * 10 + (*p - '0');
+            if (n > (long long)INT_MAX + 1) return -1;
+            p++;
+        }
+        if (p == digits || (p < stop && !isSpace(*p))) return -1;
+        if (negative) n = -n;
+        if (n > INT_MAX || n < INT_MIN) return -1;
+        value = (int)n;
+        begin = p - &buffer[0];
+        return 1;
+    }
+
+    // gives the rest of the line, without its '\n', in pieces to take
+    template<class Take>
+    bool line(Take take) {
+        for (;;) {
+            need(1);
+            if (begin == end) return true;
+            const char* p = &buffer[begin];
+            const char* newline = (const char*)memchr(p, '\n', end - begin);
+            size_t n = newline ? newline - p : end - begin;
+            if (!take(p, n)) return false;
+            begin += newline ? n + 1 : n;
+            if (newline) return true;
+        }
+    }
+
+    bool isFailed() const { return failed; }
+    long long getBytes() const { return bytes; }
+
+private:
+    int fd;
+    vector<char> buffer;
+    size_t begin, end;
+    bool done;                         // the end of the input was read
+    bool failed;                       // a read went wrong
+    long long bytes;                   // the bytes read
+};
+
+} // namespace
+//---------------------------------------------------------------------------
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class streamloader
+// the edge buffer gets the budget less the file blocks of load
+StreamLoader::StreamLoader(size_t bytes, const char* where)
+    : budget(max(bytes, MIN_BUDGET)), size(0), edgeCount(0),
+      weighted(false), runCount(0), mergePasses(0) {
+    if (where == NULL) where = getenv("TMPDIR");
+    directory = where != NULL && *where != '\0' ? where : "/tmp";
+    bufferLimit = (budget - LOAD_BLOCKS * IO_BLOCK) / sizeof(Edge);
+    bufferLimit = min(bufferLimit, (size_t)UINT_MAX);
+    text.fd = textOffsets.fd = -1;
+    text.length = textOffsets.length = 0;
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class streamloader
+// closes the temporary files
+StreamLoader::~StreamLoader() {
+    close();
+} // end of Destructor
+
+//------------------------------- load --------------------------------------
+// load
+// reads the named file; weighted is true for the GraphM format
+bool StreamLoader::load(const char* filename, bool isWeighted) {
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        close();
+        return false;
+    }
+    bool loaded = load(fd, isWeighted);
+    ::close(fd);
+    return loaded;
+} // end of load
+
+//------------------------------- load --------------------------------------
+// load
+// the number of nodes and the descriptions go to the temporary files,
+// the text offsets as long longs like the snapshot keeps them; each edge
+// kept goes in the buffer, which is spilled as a run when full; the
+// buffer is reserved whole, so it never moves, and takes memory only as
+// the edges fill it
+bool StreamLoader::load(int fd, bool isWeighted) {
+    STATS_TIMER(LOAD_FILE);
+    close();
+    weighted = isWeighted;
+    if (!open(text) || !open(textOffsets)) {
+        close();
+        return false;
+    }
+    Input in(fd);
+    edges.reserve(bufferLimit);
+
+    // the number of nodes, then the rest of its line
+    bool ok = in.scanInt(size) == 1 && size >= 0;
+    if (!ok) size = 0;
+    ok = ok && in.line([](const char*, size_t) { return true; });
+
+    // the description lines
+    long long start = 0;
+    ok = ok && add(textOffsets, &start, sizeof(start));
+    for (int i = 1; ok && i <= size; i++) {
+        start = text.length;
+        ok = add(textOffsets, &start, sizeof(start))
+            && in.line([this](const char* p, size_t n) {
+                   return add(text, p, n);
+               });
+    }
+    start = text.length;
+    ok = ok && add(textOffsets, &start, sizeof(start));
+
+    // the edges, up to the all-zero edge or the end, which must come
+    // between two edges and not inside one
+    int width = weighted ? 3 : 2;
+    while (ok) {
+        int value[3] = { 0, 0, 0 };
+        int found = 1;
+        int k = 0;
+        for (; found == 1 && k < width; k++) {
+            found = in.scanInt(value[k]);
+        }
+        if (found == -1 || (found == 0 && k > 1)) ok = false;
+        if (found != 1) break;
+        if (value[0] == 0 && value[1] == 0 && value[2] == 0) break;
+        if (value[0] < 1 || value[0] > size || value[1] < 1
+                || value[1] > size || (weighted && value[2] <= 0)) {
+            continue;
+        }
+
+        if (edges.size() == bufferLimit) ok = spill();
+        Edge e = { value[0], value[1], value[2], (unsigned)edges.size() };
+        edges.push_back(e);
+        edgeCount++;
+    }
+    ok = ok && !in.isFailed() && finish(text) && finish(textOffsets);
+    STATS_ADD(BYTES_PARSED, in.getBytes());
+    STATS_ADD(EDGES_PARSED, edgeCount);
+    if (!ok) close();
+    return ok;
+} // end of load
+
+//--------------------------- writeSnapshot ---------------------------------
+// writeSnapshot
+// the edges come from the buffer, sorted, if there are no runs, or else
+// from merging the runs: while there are more runs than the budget can
+// give a read block each, groups of runs are merged into longer runs;
+// the offsets follow the edges, node by node, and the descriptions are
+// copied from their temporary files
+bool StreamLoader::writeSnapshot(const char* filename) {
+    STATS_TIMER(BUILD_GRAPH);
+    mergePasses = 0;
+    if (text.fd < 0) return false;
+    GraphSnapshot::Writer out;
+    if (!out.open(filename, size, edgeCount, weighted, text.length)) {
+        return false;
+    }
+
+    // the edges, a block of each section at a time
+    const size_t batch = IO_BLOCK / sizeof(long long);
+    vector<long long> offsets;
+    vector<int> neighbors, weights;
+    long long placed = 0;                  // the edges written so far
+    int next = 0;                          // the next node of the offsets
+    bool ok = true;
+    function<bool(const int*)> put = [&](const int* e) {
+        while (next <= e[0]) {
+            offsets.push_back(placed);
+            next++;
+            if (offsets.size() == batch) {
+                if (!out.append(GraphSnapshot::OFFSETS, offsets.data(),
+                                offsets.size() * sizeof(long long))) {
+                    return false;
+                }
+                offsets.clear();
+            }
+        }
+        neighbors.push_back(e[1]);
+        if (weighted) weights.push_back(e[2]);
+        placed++;
+        if (neighbors.size() == batch) {
+            if (!out.append(GraphSnapshot::NEIGHBORS, neighbors.data(),
+                            neighbors.size() * sizeof(int))
+                    || !out.append(GraphSnapshot::WEIGHTS, weights.data(),
+                                   weights.size() * sizeof(int))) {
+                return false;
+            }
+            neighbors.clear();
+            weights.clear();
+        }
+        return true;
+    };
+
+    if (runs.empty()) {
+        sortEdges();
+        for (size_t k = 0; ok && k < edges.size(); k++) {
+            int e[3] = { edges[k].from, edges[k].to, edges[k].weight };
+            ok = put(e);
+        }
+    }
+    else {
+        ok = spill();
+        vector<Edge>().swap(edges);
+        size_t fanIn = max((size_t)2, budget / IO_BLOCK - MERGE_BLOCKS);
+        int width = weighted ? 3 : 2;
+        while (ok && runs.size() > fanIn) {
+            vector<TempFile> merged;
+            for (size_t first = 0; ok && first < runs.size(); first += fanIn) {
+                size_t last = min(first + fanIn, runs.size());
+                merged.push_back(TempFile());
+                TempFile& run = merged.back();
+                ok = open(run)
+                    && merge(first, last, [&run, width](const int* e) {
+                           return add(run, e, width * sizeof(int));
+                       })
+                    && finish(run);
+                for (size_t r = first; r < last; r++) close(runs[r]);
+            }
+            for (size_t r = 0; r < runs.size(); r++) close(runs[r]);
+            runs.swap(merged);
+            mergePasses++;
+        }
+        ok = ok && merge(0, runs.size(), put);
+        mergePasses++;
+    }
+
+    // the offsets of the nodes after the last edge, and what is pending
+    for (; ok && next <= size + 1; next++) {
+        offsets.push_back(placed);
+        if (offsets.size() == batch) {
+            ok = out.append(GraphSnapshot::OFFSETS, offsets.data(),
+                            offsets.size() * sizeof(long long));
+            offsets.clear();
+        }
+    }
+    ok = ok && out.append(GraphSnapshot::OFFSETS, offsets.data(),
+                          offsets.size() * sizeof(long long))
+         && out.append(GraphSnapshot::NEIGHBORS, neighbors.data(),
+                       neighbors.size() * sizeof(int))
+         && out.append(GraphSnapshot::WEIGHTS, weights.data(),
+                       weights.size() * sizeof(int));
+
+    // the descriptions
+    vector<char> block(IO_BLOCK);
+    TempFile* copies[2] = { &textOffsets, &text };
+    GraphSnapshot::Section sections[2] = { GraphSnapshot::TEXT_OFFSETS,
+                                           GraphSnapshot::TEXT };
+    for (int c = 0; c < 2; c++) {
+        for (long long at = 0; ok && at < copies[c]->length; at += IO_BLOCK) {
+            size_t n = (size_t)min((long long)IO_BLOCK,
+                                   copies[c]->length - at);
+            ok = read(*copies[c], at, block.data(), n)
+                && out.append(sections[c], block.data(), n);
+        }
+    }
+    return out.close() && ok;
+} // end of writeSnapshot
+
+//------------------------------- close -------------------------------------
+// close
+// forgets the graph and closes the temporary files
+void StreamLoader::close() {
+    close(text);
+    close(textOffsets);
+    for (size_t r = 0; r < runs.size(); r++) close(runs[r]);
+    runs.clear();
+    vector<Edge>().swap(edges);
+    size = 0;
+    edgeCount = 0;
+    runCount = 0;
+    mergePasses = 0;
+} // end of close
+
+//------------------------------ accessors ----------------------------------
+int StreamLoader::getSize() const {
+    return size;
+}
+
+long long StreamLoader::getEdgeCount() const {
+    return edgeCount;
+}
+
+int StreamLoader::getRunCount() const {
+    return runCount;
+}
+
+int StreamLoader::getMergePasses() const {
+    return mergePasses;
+}
+
+size_t StreamLoader::getBudget() const {
+    return budget;
+}
+
+//------------------------------- spill -------------------------------------
+// spill
+// sorts the buffer and writes it as a run, 2 or 3 ints an edge
+bool StreamLoader::spill() {
+    if (edges.empty()) return true;
+    sortEdges();
+    runs.push_back(TempFile());
+    TempFile& run = runs.back();
+    runCount++;
+    int width = weighted ? 3 : 2;
+    bool ok = open(run);
+    for (size_t k = 0; ok && k < edges.size(); k++) {
+        int e[3] = { edges[k].from, edges[k].to, edges[k].weight };
+        ok = add(run, e, width * sizeof(int));
+    }
+    edges.clear();
+    return ok && finish(run);
+} // end of spill
+
+//----------------------------- sortEdges -----------------------------------
+// sortEdges
+// sorts the buffer by the node each edge leaves, and the edges of one
+// node from the last read to the first
+void StreamLoader::sortEdges() {
+    sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return a.from != b.from ? a.from < b.from : a.order > b.order;
+    });
+} // end of sortEdges
+
+//------------------------------- merge -------------------------------------
+// merge
+// each run gets an equal share of the budget as a read block; a heap
+// holds the next edge of each run by (node, -run), so of the edges of
+// one node the later runs, which were read later, come first
+bool StreamLoader::merge(size_t first, size_t last,
+                         const function<bool(const int*)>& emit) {
+    int width = weighted ? 3 : 2;
+    size_t count = last - first;
+    size_t share = (budget - MERGE_BLOCKS * IO_BLOCK) / count;
+    long long blockBytes =
+        (long long)(max(IO_BLOCK, share) / (width * sizeof(int)))
+        * width * sizeof(int);
+
+    // the block of a run being merged and the place in both
+    struct Reader {
+        const TempFile* file;
+        long long at;                  // the next byte of the run to read
+        vector<int> block;
+        size_t next;                   // the next int of the block
+    };
+    vector<Reader> readers(count);
+    auto fill = [blockBytes](Reader& r) {
+        long long n = min(blockBytes, r.file->length - r.at);
+        r.block.resize(n / sizeof(int));
+        r.next = 0;
+        if (!read(*r.file, r.at, r.block.data(), n)) return false;
+        r.at += n;
+        return true;
+    };
+
+    greater<pair<int, int> > later;
+    vector<pair<int, int> > heap;
+    for (size_t k = 0; k < count; k++) {
+        readers[k].file = &runs[first + k];
+        readers[k].at = 0;
+        if (!fill(readers[k])) return false;
+        if (!readers[k].block.empty()) {
+            heap.push_back(make_pair(readers[k].block[0], -(int)k));
+        }
+    }
+    make_heap(heap.begin(), heap.end(), later);
+
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), later);
+        int k = -heap.back().second;
+        heap.pop_back();
+        Reader& r = readers[k];
+        if (!emit(&r.block[r.next])) return false;
+        r.next += width;
+        if (r.next == r.block.size() && !fill(r)) return false;
+        if (r.next < r.block.size()) {
+            heap.push_back(make_pair(r.block[r.next], -k));
+            push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+    return true;
+} // end of merge
+
+//------------------------------- open --------------------------------------
+// open
+// makes a temporary file in the directory and removes its name, so the
+// file goes away when it is closed
+bool StreamLoader::open(TempFile& file) {
+    file.length = 0;
+    file.pending.clear();
+    string path = directory + "/graphrunXXXXXX";
+    vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    file.fd = mkstemp(name.data());
+    if (file.fd < 0) return false;
+    unlink(name.data());
+    return true;
+} // end of open
+
+//-------------------------------- add --------------------------------------
+// add
+// adds bytes, at most a block, to the end of a file, writing the pending
+// ones first if the block would overflow
+bool StreamLoader::add(TempFile& file, const void* data, size_t n) {
+    const char* p = (const char*)data;
+    if (file.pending.size() + n > IO_BLOCK && !flush(file)) return false;
+    file.pending.reserve(IO_BLOCK);
+    file.pending.insert(file.pending.end(), p, p + n);
+    file.length += n;
+    return true;
+} // end of add
+
+//------------------------------- flush -------------------------------------
+// flush
+// writes the bytes still pending
+bool StreamLoader::flush(TempFile& file) {
+    if (file.fd < 0) return false;
+    size_t done = 0;
+    while (done < file.pending.size()) {
+        ssize_t n = ::write(file.fd, file.pending.data() + done,
+                            file.pending.size() - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += n;
+    }
+    file.pending.clear();
+    return true;
+} // end of flush
+
+//------------------------------- finish ------------------------------------
+// finish
+// writes the bytes still pending and frees the block they were kept in,
+// once nothing more is added to the file
+bool StreamLoader::finish(TempFile& file) {
+    bool ok = flush(file);
+    vector<char>().swap(file.pending);
+    return ok;
+} // end of finish
+
+//-------------------------------- read -------------------------------------
+// read
+// reads bytes back from the given place of a file
+bool StreamLoader::read(const TempFile& file, long long at, void* data,
+                        size_t n) {
+    char* p = (char*)data;
+    while (n > 0) {
+        ssize_t got = pread(file.fd, p, n, at);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        n -= got;
+        at += got;
+    }
+    return true;
+} // end of read
+
+//------------------------------- close -------------------------------------
+// close
+// closes a file, which removes it
+void StreamLoader::close(TempFile& file) {
+    if (file.fd >= 0) ::close(file.fd);
+    file.fd = -1;
+    file.length = 0;
+    vector<char>().swap(file.pending);
+} // end of close
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------
+// streamloader.h
+// Simple class streamloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// streamloader class:  reads a graph data file in pieces and writes it as
+//   a snapshot file, in a given amount of memory however large the graph
+//
+// load reads the file, or a pipe, a block at a time.  The descriptions go
+// straight to a temporary file.  The edges fill a buffer; each time it is
+// full it is sorted by the node the edges leave and written to a
+// temporary file as a run.  writeSnapshot merges the runs, in one pass
+// when the budget gives each run a large enough read buffer and in more
+// passes when not, and writes the merged edges and the descriptions as a
+// GraphSnapshot file, which GraphSnapshot::open then maps in place.
+// A graph whose edges fit in one buffer is never written to a run.
+//
+// The memory used is the budget given to the constructor: the edge
+// buffer takes what the blocks of the files leave of it.  The temporary
+// files are removed as soon as they are made, so they are gone when the
+// loader is, even if it ends early; they need about as much disk as the
+// edges take in the data file.
+//
+// The format is the one read by GraphL::buildGraph (two numbers per
+// edge) and GraphM::buildGraph (three numbers per edge).  The snapshot
+// has the edges GraphCSR::buildGraph would keep, in the same order: an
+// edge with an end outside 1 .. size, or of weight 0 or less in the
+// GraphM format, is left out, and the edges of one node are in reverse
+// file order.
+//
+// Assumptions:
+//   -- the budget is at least MIN_BUDGET bytes (a smaller one is raised)
+//   -- the temporary directory has room for the edges
+//---------------------------------------------------------------------------
+#ifndef STREAMLOADER_H
+#define STREAMLOADER_H
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "snapshot.h"
+
+
+class StreamLoader {
+public:
+    static const size_t MIN_BUDGET = 16 << 20;
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class streamloader
+// the bytes of memory to use, and the directory of the temporary files,
+// NULL for $TMPDIR or else /tmp
+    explicit StreamLoader(size_t = 256 << 20, const char* = NULL);
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class streamloader
+// closes the temporary files
+    ~StreamLoader();
+
+//------------------------------- load --------------------------------------
+// load
+// reads the named file; weighted is true for the GraphM format
+// returns false if the file cannot be read, is not in the format, ends
+// inside an edge or a temporary file cannot be written
+    bool load(const char*, bool);
+
+//------------------------------- load --------------------------------------
+// load
+// reads from an open file descriptor, e.g. 0 for standard input, up to
+// the all-zero edge or the end; the descriptor is left open
+    bool load(int, bool);
+
+//--------------------------- writeSnapshot ---------------------------------
+// writeSnapshot
+// merges the runs into the named snapshot file; load must be run first
+// returns false if a file cannot be read or written
+    bool writeSnapshot(const char*);
+
+//------------------------------- close -------------------------------------
+// close
+// forgets the graph and closes the temporary files
+    void close();
+
+//------------------------------ accessors ----------------------------------
+// getSize:        the number of nodes
+// getEdgeCount:   the number of edges kept
+// getRunCount:    the number of runs written by load
+// getMergePasses: the passes over the runs of the last writeSnapshot,
+//                 0 if the edges were never written to a run
+// getBudget:      the bytes of memory the loader uses
+    int getSize() const;
+    long long getEdgeCount() const;
+    int getRunCount() const;
+    int getMergePasses() const;
+    size_t getBudget() const;
+
+private:
+    // an edge in the buffer; order is its place in the run, so that the
+    // edges of one node can be put in reverse file order
+    struct Edge {
+        int from;
+        int to;
+        int weight;
+        unsigned order;
+    };
+
+    // a temporary file, removed from the directory once opened
+    struct TempFile {
+        int fd;                        // -1 when closed
+        long long length;              // the bytes written
+        vector<char> pending;          // written but not yet in the file
+    };
+
+    size_t budget;                     // the bytes of memory to use
+    string directory;                  // of the temporary files
+    int size;                          // the number of nodes
+    long long edgeCount;               // the edges kept
+    bool weighted;                     // the GraphM format
+    size_t bufferLimit;                // the most edges in the buffer
+    vector<Edge> edges;                // the edges of the next run
+    TempFile text;                     // the descriptions, back to back
+    TempFile textOffsets;              // where each description starts
+    vector<TempFile> runs;             // the runs, in file order
+    int runCount;                      // the runs written by load
+    int mergePasses;                   // the passes of writeSnapshot
+
+//------------------------------- spill -------------------------------------
+// spill
+// sorts the buffer and writes it as a run
+    bool spill();
+
+//----------------------------- sortEdges -----------------------------------
+// sortEdges
+// sorts the buffer by the node each edge leaves, in reverse file order
+// for each node
+    void sortEdges();
+
+//------------------------------- merge -------------------------------------
+// merge
+// gives the edges of the runs first .. last-1 to emit, merged in order of
+// the node they leave, 2 or 3 ints each; stops if emit returns false
+    bool merge(size_t, size_t, const function<bool(const int*)>&);
+
+//--------------------------- temporary files -------------------------------
+// open:   makes a temporary file in the directory and removes its name
+// add:    adds bytes to the end of a file
+// flush:  writes the bytes still pending
+// finish: writes them and frees the block they were kept in
+// read:   reads bytes back from the given place
+// close:  closes a file
+    bool open(TempFile&);
+    static bool add(TempFile&, const void*, size_t);
+    static bool flush(TempFile&);
+    static bool finish(TempFile&);
+    static bool read(const TempFile&, long long, void*, size_t);
+    static void close(TempFile&);
+
+    // not copyable, it owns the temporary files
+    StreamLoader(const StreamLoader&);
+    StreamLoader& operator=(const StreamLoader&);
+};
+#endif
@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------
+// stringpool.cpp
+// Simple class stringpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// stringpool class:  strings stored once each, back to back in one array
+//
+// Assumptions:
+//   -- a string is read with get until the next intern or clear
+//---------------------------------------------------------------------------
+#include <cstring>
+#include "stringpool.h"
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class stringpool
+StringPool::StringPool() : offsets(1, 0), epoch(1) {
+    rehash(64);
+} // end of Constructor
+
+//------------------------------ intern -------------------------------------
+// intern
+// the number of the given text, adding it if it is not in the pool
+// the table is probed from the hash until the text or an empty slot
+// is found; it is kept at most half full
+int StringPool::intern(const char* s, int length) {
+    unsigned h = hash(s, length);
+    size_t mask = table.size() - 1;
+    for (size_t slot = h & mask; ; slot = (slot + 1) & mask) {
+        Slot& at = table[slot];
+        if (at.stamp != epoch) {
+            int k = (int)hashes.size();
+            text.insert(text.end(), s, s + length);
+            offsets.push_back(text.size());
+            hashes.push_back(h);
+            at.number = k;
+            at.stamp = epoch;
+            if (hashes.size() * 2 > table.size()) rehash(table.size() * 2);
+            return k;
+        }
+        int k = at.number;
+        if (hashes[k] == h && (int)(offsets[k + 1] - offsets[k]) == length
+            && memcmp(text.data() + offsets[k], s, length) == 0) {
+            return k;
+        }
+    }
+} // end of intern
+
+int StringPool::intern(const string& s) {
+    return intern(s.data(), (int)s.size());
+}
+
+//-------------------------------- get --------------------------------------
+// get
+// the text of the given number
+TextSlice StringPool::get(int k) const {
+    TextSlice slice;
+    slice.text = text.data() + offsets[k];
+    slice.length = (int)(offsets[k + 1] - offsets[k]);
+    return slice;
+} // end of get
+
+string StringPool::getString(int k) const {
+    return string(text.data() + offsets[k], offsets[k + 1] - offsets[k]);
+}
+
+//------------------------------- clear -------------------------------------
+// clear
+// forgets every string, keeping the memory for reuse
+// the slots of the table are emptied by moving to the next epoch; they
+// are only cleared when the epoch wraps
+void StringPool::clear() {
+    text.clear();
+    offsets.resize(1);
+    hashes.clear();
+    if (++epoch == 0) rehash(table.size());
+} // end of clear
+
+//------------------------------- hash --------------------------------------
+// hash
+// FNV-1a of the given text
+unsigned StringPool::hash(const char* s, int length) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        h = (h ^ (unsigned char)s[i]) * 16777619u;
+    }
+    return h;
+} // end of hash
+
+//------------------------------ rehash -------------------------------------
+// rehash
+// makes the table the given size and places every string again
+// the new slots are stamped 0, so the epoch starts again at 1
+void StringPool::rehash(size_t size) {
+    Slot empty = { 0, 0 };
+    table.assign(size, empty);
+    epoch = 1;
+    size_t mask = size - 1;
+    for (size_t k = 0; k < hashes.size(); k++) {
+        size_t slot = hashes[k] & mask;
+        while (table[slot].stamp == epoch) slot = (slot + 1) & mask;
+        table[slot].number = (int)k;
+        table[slot].stamp = epoch;
+    }
+} // end of rehash
+
+//------------------------------ accessors ----------------------------------
+int StringPool::getCount() const {
+    return (int)hashes.size();
+}
+
+size_t StringPool::getBytes() const {
+    return text.size();
+}
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------
+// stringpool.h
+// Simple class stringpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// stringpool class:  strings stored once each, back to back in one array
+//
+// intern gives each distinct string a number, the same number every time
+// the same text is interned, and keeps its characters in one growing
+// array, so a thousand strings cost a handful of allocations instead of
+// a thousand.  The numbers are found with an open-addressing hash table
+// of string numbers.  A slot of the table is in use only when its stamp
+// equals the current epoch, so clear forgets every string by moving to
+// the next epoch, in constant time, and keeps the arrays.
+//
+// Assumptions:
+//   -- a string is read with get until the next intern or clear
+//---------------------------------------------------------------------------
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+#include <string>
+#include <vector>
+#include "graphloader.h"
+
+
+class StringPool {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Default constructor for class stringpool
+    StringPool();
+
+//------------------------------ intern -------------------------------------
+// intern
+// the number of the given text, adding it if it is not in the pool
+    int intern(const char*, int);
+    int intern(const string&);
+
+//-------------------------------- get --------------------------------------
+// get
+// the text of the given number
+    TextSlice get(int) const;
+    string getString(int) const;
+
+//------------------------------- clear -------------------------------------
+// clear
+// forgets every string, keeping the memory for reuse
+// does not touch the table, except once every 2^32 clears
+    void clear();
+
+//------------------------------ accessors ----------------------------------
+// getCount: the number of distinct strings
+// getBytes: the number of characters of all of them
+    int getCount() const;
+    size_t getBytes() const;
+
+private:
+    vector<char> text;                 // every string, back to back
+    vector<size_t> offsets;            // string k is text[offsets[k]] ..
+    vector<unsigned> hashes;           // the hash of each string
+
+    // a slot of the hash table, empty unless stamp == epoch
+    struct Slot {
+        int number;                    // the string number
+        unsigned stamp;                // the epoch the slot was filled in
+    };
+    vector<Slot> table;                // the hash table, a power of 2 long
+    unsigned epoch;                    // the stamp of the slots in use
+
+//------------------------------- hash --------------------------------------
+// hash
+// the hash of the given text
+    static unsigned hash(const char*, int);
+
+//------------------------------ rehash -------------------------------------
+// rehash
+// makes the table the given size and places every string again
+    void rehash(size_t);
+};
+#endif
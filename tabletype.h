@@ -0,0 +1,21 @@
+//---------------------------------------------------------------------------
+// tabletype.h
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// TableType:  one entry of a shortest path table, used by GraphM for
+//   T[source][node] and by Dijkstra and PathCache for a row of it
+//---------------------------------------------------------------------------
+#ifndef TABLETYPE_H
+#define TABLETYPE_H
+
+#include"limits.h"
+
+// the struct to keep the current shortest distance 
+// and associated path info known at any point in the algorithm
+struct TableType {
+    bool visited = false; // whether node has been visited
+    int dist = INT_MAX;   // the shortest distance from source known so far
+    int path = 0;         // previous node in path of min dist
+};
+
+#endif
@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------
+// test_components.cpp
+// Tests of components
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks Components on small random graphs against the transitive closure
+// of the graph, found by Warshall's algorithm: two nodes are in the same
+// component when each reaches the other, every edge goes forward in the
+// numbering of the components, condense has one edge per pair of joined
+// components, and the graph has a topological order exactly when it has
+// no cycle.  Some graphs get a self loop and some keep only the edges
+// going up, which makes them acyclic.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "components.h"
+#include "graphgen.h"
+#include "testing.h"
+
+//------------------------------ hasEdge ------------------------------------
+// hasEdge
+// whether the graph has an edge from a to b
+static bool hasEdge(const GraphCSR& g, int a, int b) {
+    for (const int* e = g.edgeBegin(a); e != g.edgeEnd(a); e++) {
+        if (*e == b) return true;
+    }
+    return false;
+} // end of hasEdge
+
+//------------------------------ checkGraph ---------------------------------
+// checkGraph
+// checks every result of Components on one graph
+static void checkGraph(int n, const vector<int>& from, const vector<int>& to) {
+    GraphCSR g;
+    g.assign(n, from, to);
+
+    // reach[i][j]: j can be reached from i
+    vector<vector<char> > reach(n + 1, vector<char>(n + 1, 0));
+    for (int i = 1; i <= n; i++) reach[i][i] = 1;
+    for (size_t e = 0; e < from.size(); e++) reach[from[e]][to[e]] = 1;
+    for (int k = 1; k <= n; k++) {
+        for (int i = 1; i <= n; i++) {
+            if (!reach[i][k]) continue;
+            for (int j = 1; j <= n; j++) {
+                if (reach[k][j]) reach[i][j] = 1;
+            }
+        }
+    }
+
+    Components c(g);
+    int count = c.findStrong();
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= n; j++) {
+            bool same = reach[i][j] && reach[j][i];
+            CHECK(same == (c.getComponent(i) == c.getComponent(j)));
+        }
+    }
+    for (size_t e = 0; e < from.size(); e++) {
+        CHECK(c.getComponent(from[e]) <= c.getComponent(to[e]));
+    }
+    int total = 0;
+    for (int k = 1; k <= count; k++) total += (int)c.getNodes(k).size();
+    CHECK(total == n);
+
+    GraphCSR dag;
+    c.condense(dag);
+    CHECK(dag.getSize() == count);
+    vector<vector<char> > joined(count + 1, vector<char>(count + 1, 0));
+    long long pairs = 0;
+    for (size_t e = 0; e < from.size(); e++) {
+        int a = c.getComponent(from[e]), b = c.getComponent(to[e]);
+        if (a != b && !joined[a][b]) {
+            joined[a][b] = 1;
+            pairs++;
+        }
+    }
+    CHECK(dag.getEdgeCount() == pairs);
+    for (int u = 1; u <= count; u++) {
+        for (const int* e = dag.edgeBegin(u); e != dag.edgeEnd(u); e++) {
+            CHECK(*e > u && joined[u][*e]);
+        }
+    }
+
+    bool cyclic = false;
+    for (size_t e = 0; e < from.size(); e++) {
+        if (reach[to[e]][from[e]]) cyclic = true;
+    }
+    vector<int> order;
+    CHECK(c.topologicalOrder(order) == !cyclic);
+    if (!cyclic) {
+        CHECK((int)order.size() == n);
+        vector<int> position(n + 1, 0);
+        for (int k = 0; k < (int)order.size(); k++) position[order[k]] = k;
+        for (size_t e = 0; e < from.size(); e++) {
+            CHECK(position[from[e]] < position[to[e]]);
+        }
+    }
+    vector<int> cycle = c.findCycle();
+    CHECK(cycle.empty() == !cyclic);
+    for (size_t k = 0; k < cycle.size(); k++) {
+        CHECK(hasEdge(g, cycle[k], cycle[(k + 1) % cycle.size()]));
+    }
+} // end of checkGraph
+
+int main() {
+    for (int round = 0; round < 300; round++) {
+        GraphGen gen(round + 1);
+        int n = 1 + (int)randomBelow(40);
+        long long m = randomBelow(3LL * n + 1);
+        if (round % 3 == 0) gen.rmat(n, m);
+        else gen.erdosRenyi(n, m);
+        vector<int> from = gen.getFrom(), to = gen.getTo();
+        if (round % 5 == 0) {
+            from.push_back(1);
+            to.push_back(1);
+        }
+        if (round % 7 == 0) {
+            vector<int> upFrom, upTo;
+            for (size_t e = 0; e < from.size(); e++) {
+                if (from[e] >= to[e]) continue;
+                upFrom.push_back(from[e]);
+                upTo.push_back(to[e]);
+            }
+            from.swap(upFrom);
+            to.swap(upTo);
+        }
+        checkGraph(n, from, to);
+    }
+
+    // a ring too long for a recursive search
+    int n = 1000000;
+    vector<int> from, to;
+    for (int v = 1; v <= n; v++) {
+        from.push_back(v);
+        to.push_back(v % n + 1);
+    }
+    GraphCSR ring;
+    ring.assign(n, from, to);
+    Components c(ring);
+    CHECK(c.findStrong() == 1);
+    CHECK((int)c.findCycle().size() == n);
+    return finish();
+}
@@ -0,0 +1,188 @@
+//---------------------------------------------------------------------------
+// test_contraction.cpp
+// Tests of contraction
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that the queries of a ContractionHierarchy find the distances
+// Dijkstra finds, and paths along edges of the graph that add up to them,
+// on graphs with unreachable pairs, zero weights, parallel edges and
+// loops, built with one thread and with several.  A hierarchy saved and
+// loaded again answers the same, and load refuses a file cut short, a
+// rank out of range or repeated, an arc down in rank and a shortcut
+// through a node that is not below both of its ends.
+//---------------------------------------------------------------------------
+#include <climits>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "contraction.h"
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "testing.h"
+
+// where save puts the ranks and the up arcs of a hierarchy of n nodes
+static const int RANKS_AT = 36;
+static long long upArcsAt(int n) {
+    return RANKS_AT + 4LL * (n + 1) + 8LL * (n + 2);
+}
+
+//----------------------------- edgeWeight ----------------------------------
+// edgeWeight
+// the lightest edge from -> to of the graph, -1 if there is none
+static int edgeWeight(const GraphCSR& g, int from, int to) {
+    int best = -1;
+    const int* cost = g.weightBegin(from);
+    for (int e = 0; e < g.degree(from); e++) {
+        int w = cost ? cost[e] : 1;
+        if (g.edgeBegin(from)[e] == to && (best < 0 || w < best)) best = w;
+    }
+    return best;
+} // end of edgeWeight
+
+//----------------------------- checkQueries --------------------------------
+// checkQueries
+// compares the queries from a few sources to every node with Dijkstra
+static void checkQueries(const GraphCSR& g, ContractionHierarchy& ch) {
+    int n = g.getSize();
+    Dijkstra dijkstra(g);
+    vector<TableType> row(n + 1);
+    for (int s = 0; s < 8; s++) {
+        int source = 1 + (s * 7919) % n;
+        dijkstra.findShortestPath(source, row.data());
+        for (int v = 1; v <= n; v++) {
+            vector<int> path = ch.shortestPath(source, v);
+            CHECK(ch.getDist() == row[v].dist);
+            if (row[v].dist == INT_MAX) {
+                CHECK(path.empty());
+                continue;
+            }
+            CHECK(!path.empty() && path.front() == source
+                  && path.back() == v);
+            long long length = 0;
+            for (size_t i = 1; i < path.size(); i++) {
+                int w = edgeWeight(g, path[i - 1], path[i]);
+                CHECK(w >= 0);
+                length += w;
+            }
+            CHECK(length == row[v].dist);
+        }
+    }
+    CHECK(ch.shortestPath(0, 1).empty() && ch.getDist() == INT_MAX);
+    CHECK(ch.shortestPath(1, n + 1).empty());
+} // end of checkQueries
+
+//----------------------------- checkGraph ----------------------------------
+// checkGraph
+// builds the hierarchy of the graph and checks it before and after a
+// save and load
+static void checkGraph(const GraphCSR& g, int threads) {
+    ContractionHierarchy ch;
+    ch.build(g, threads);
+    CHECK(ch.getSize() == g.getSize());
+    checkQueries(g, ch);
+
+    stringstream file;
+    CHECK(ch.save(file));
+    ContractionHierarchy loaded;
+    CHECK(loaded.load(file));
+    CHECK(loaded.getSize() == ch.getSize()
+          && loaded.getShortcutCount() == ch.getShortcutCount());
+    for (int v = 1; v <= g.getSize(); v++) {
+        CHECK(loaded.getRank(v) == ch.getRank(v));
+    }
+    checkQueries(g, loaded);
+} // end of checkGraph
+
+//------------------------------ loadsAfter ---------------------------------
+// loadsAfter
+// whether a hierarchy loads from the saved bytes changed at the given
+// place to the given value
+static bool loadsAfter(const string& saved, long long at, int value) {
+    string bytes = saved;
+    memcpy(&bytes[at], &value, sizeof(value));
+    istringstream in(bytes);
+    ContractionHierarchy ch;
+    bool ok = ch.load(in);
+    CHECK(ok || ch.getSize() == 0);
+    return ok;
+} // end of loadsAfter
+
+//------------------------------ checkLoad ----------------------------------
+// checkLoad
+// load refuses files that do not hold a hierarchy that fits together
+static void checkLoad() {
+    GraphGen gen(5, 20);
+    gen.grid(12, 12);
+    GraphCSR g;
+    g.assign(gen.getSize(), gen.getFrom(), gen.getTo(), gen.getWeight());
+    ContractionHierarchy ch;
+    ch.build(g, 2);
+    CHECK(ch.getShortcutCount() > 0);
+    ostringstream out;
+    ch.save(out);
+    string saved = out.str();
+    int n = g.getSize();
+
+    CHECK(loadsAfter(saved, RANKS_AT + 4, ch.getRank(1)));
+    CHECK(!loadsAfter(saved, RANKS_AT + 4, 0));
+    CHECK(!loadsAfter(saved, RANKS_AT + 4, n + 1));
+    CHECK(!loadsAfter(saved, RANKS_AT + 4, ch.getRank(2)));
+
+    // the arc and the field of the first shortcut among the up arcs
+    long long first = upArcsAt(n);
+    long long count = (long long)(saved.size() - first) / 12;
+    long long shortcut = -1;
+    for (long long e = 0; e < count && shortcut < 0; e++) {
+        int middle;
+        memcpy(&middle, &saved[first + 12 * e + 8], sizeof(middle));
+        if (middle != 0) shortcut = first + 12 * e;
+    }
+    CHECK(shortcut >= 0);
+    if (shortcut >= 0) {
+        int node;
+        memcpy(&node, &saved[shortcut], sizeof(node));
+        CHECK(!loadsAfter(saved, shortcut + 8, node));
+        CHECK(!loadsAfter(saved, shortcut + 8, n + 1));
+        CHECK(!loadsAfter(saved, shortcut + 8, -1));
+    }
+
+    // an arc to the node of lowest rank goes down
+    int lowest = 1;
+    for (int v = 1; v <= n; v++) {
+        if (ch.getRank(v) == 1) lowest = v;
+    }
+    CHECK(!loadsAfter(saved, first, lowest));
+
+    for (size_t cut = 0; cut < saved.size(); cut += saved.size() / 40) {
+        istringstream in(saved.substr(0, cut));
+        ContractionHierarchy part;
+        CHECK(!part.load(in) && part.getSize() == 0);
+    }
+} // end of checkLoad
+
+int main() {
+    for (int kind = 0; kind < 3; kind++) {
+        GraphGen gen(kind + 1, 20);
+        if (kind == 0) gen.erdosRenyi(400, 700);
+        else if (kind == 1) gen.grid(20, 20);
+        else gen.rmat(1 << 9, 4 << 9);
+
+        // some weights of zero, and node 1 with no edges at all
+        vector<int> from = gen.getFrom(), to = gen.getTo();
+        vector<int> weight = gen.getWeight();
+        for (size_t e = 0; e < weight.size(); e++) {
+            if (randomBelow(5) == 0) weight[e] = 0;
+            if (from[e] == 1 || to[e] == 1) from[e] = to[e] = 2;
+        }
+        GraphCSR g;
+        g.assign(gen.getSize(), from, to, weight);
+        checkGraph(g, 1);
+        checkGraph(g, 4);
+        GraphCSR unweighted;
+        unweighted.assign(gen.getSize(), from, to);
+        checkGraph(unweighted, 3);
+    }
+    checkLoad();
+    return finish();
+}
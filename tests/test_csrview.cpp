@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------
+// test_csrview.cpp
+// Tests of csrview
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Saves weighted and unweighted graphs as snapshots, maps them again and
+// runs each search on the mapped file and on the GraphCSR it came from:
+// DepthFirst, BreadthFirst, Dijkstra, DeltaStepping, PathSearch and
+// Components must give the same results on both.  The snapshot file is
+// made in the directory the test runs in and removed at the end.
+//---------------------------------------------------------------------------
+#include <cstdio>
+#include <vector>
+#include "breadthfirst.h"
+#include "components.h"
+#include "deltastepping.h"
+#include "depthfirst.h"
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "pathsearch.h"
+#include "snapshot.h"
+#include "testing.h"
+
+//------------------------------ sameRows -----------------------------------
+// sameRows
+// whether two shortest path rows are equal, the paths too
+static bool sameRows(const vector<TableType>& a, const vector<TableType>& b) {
+    for (size_t v = 0; v < a.size(); v++) {
+        if (a[v].dist != b[v].dist || a[v].path != b[v].path
+                || a[v].visited != b[v].visited) {
+            return false;
+        }
+    }
+    return true;
+} // end of sameRows
+
+//------------------------------ checkGraph ---------------------------------
+// checkGraph
+// runs every search on the graph and on its mapped snapshot
+static void checkGraph(const GraphCSR& g) {
+    const char* name = "test_csrview.snap";
+    CHECK(GraphSnapshot::write(name, g));
+    GraphSnapshot snapshot;
+    CHECK(snapshot.open(name, true));
+    int n = g.getSize();
+
+    CSRView a(g), b(snapshot);
+    CHECK(a.getSize() == b.getSize() && a.getEdgeCount() == b.getEdgeCount()
+          && a.isWeighted() == b.isWeighted());
+
+    DepthFirst depthA(g), depthB(snapshot);
+    CHECK(depthA.preorder() == depthB.preorder());
+    CHECK(depthA.postorder() == depthB.postorder());
+
+    BreadthFirst breadthA(g, 2), breadthB(snapshot, 2);
+    breadthA.search(1);
+    breadthB.search(1);
+    CHECK(breadthA.getReachedCount() == breadthB.getReachedCount());
+    for (int v = 1; v <= n; v++) {
+        CHECK(breadthA.getLevel(v) == breadthB.getLevel(v));
+    }
+
+    Dijkstra dijkstra(g), mapped(snapshot);
+    DeltaStepping stepping(snapshot, 2);
+    vector<TableType> rowA(n + 1), rowB(n + 1), rowC(n + 1);
+    for (int s = 1; s <= n; s += 1 + n / 5) {
+        dijkstra.findShortestPath(s, rowA.data());
+        mapped.findShortestPath(s, rowB.data());
+        stepping.findShortestPath(s, rowC.data());
+        CHECK(sameRows(rowA, rowB) && sameRows(rowA, rowC));
+    }
+
+    PathSearch searchA(g), searchB(snapshot);
+    for (int q = 1; q <= 20; q++) {
+        int s = 1 + (int)randomBelow(n), t = 1 + (int)randomBelow(n);
+        CHECK(searchA.shortestPath(s, t) == searchB.shortestPath(s, t));
+    }
+
+    Components strongA(g), strongB(snapshot);
+    CHECK(strongA.findStrong() == strongB.findStrong());
+    for (int v = 1; v <= n; v++) {
+        CHECK(strongA.getComponent(v) == strongB.getComponent(v));
+    }
+    snapshot.close();
+    remove(name);
+} // end of checkGraph
+
+int main() {
+    GraphGen gen(21, 40);
+    gen.rmat(3000, 15000);
+    GraphCSR weighted, unweighted;
+    weighted.assign(gen.getSize(), gen.getFrom(), gen.getTo(),
+                    gen.getWeight());
+    unweighted.assign(gen.getSize(), gen.getFrom(), gen.getTo());
+    checkGraph(weighted);
+    checkGraph(unweighted);
+    return finish();
+}
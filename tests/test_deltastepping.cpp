@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------
+// test_deltastepping.cpp
+// Tests of deltastepping
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that DeltaStepping fills the same rows as Dijkstra, the paths
+// too, on R-MAT, grid and Erdos-Renyi graphs, weighted and unweighted,
+// for several bucket widths and numbers of threads, and from a source
+// outside the graph.  A graph with weights far above MAX_SLOTS buckets
+// checks the nodes kept in overflow: its node 6 was once never reached.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "deltastepping.h"
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "testing.h"
+
+//------------------------------ checkRows ----------------------------------
+// checkRows
+// compares the rows of both searches from a few sources
+static void checkRows(const GraphCSR& g, int threads, int delta) {
+    int n = g.getSize();
+    Dijkstra dijkstra(g);
+    DeltaStepping stepping(g, threads, delta);
+    vector<TableType> a(n + 1), b(n + 1);
+    for (int s = 0; s <= 6; s++) {
+        int source = s == 0 ? 0 : 1 + (s * 7919) % n;
+        dijkstra.findShortestPath(source, a.data());
+        stepping.findShortestPath(source, b.data());
+        for (int v = 0; v <= n; v++) {
+            CHECK(a[v].dist == b[v].dist && a[v].path == b[v].path
+                  && a[v].visited == b[v].visited);
+        }
+    }
+} // end of checkRows
+
+//----------------------------- checkOverflow -------------------------------
+// checkOverflow
+// node 5 goes to overflow at bucket 2900 while the slots hold buckets up
+// to 3000 along 1, 2, 3, 4; bucket 2900 must be emptied before 3000
+static void checkOverflow() {
+    const int from[] = { 1, 2, 3, 1, 5, 1 };
+    const int to[] = { 2, 3, 4, 5, 6, 7 };
+    const int weight[] = { 1000, 1000, 1000, 2900, 1, 5000 };
+    GraphCSR g;
+    g.assign(7, vector<int>(from, from + 6), vector<int>(to, to + 6),
+             vector<int>(weight, weight + 6));
+    vector<TableType> row(8);
+    DeltaStepping stepping(g, 1, 1);
+    stepping.findShortestPath(1, row.data());
+    CHECK(row[6].dist == 2901 && row[6].path == 5 && row[6].visited);
+    CHECK(row[7].dist == 5000 && row[4].dist == 3000);
+    checkRows(g, 1, 1);
+    checkRows(g, 2, 7);
+
+    // many nodes in overflow at once
+    GraphGen gen(9, 100000);
+    gen.erdosRenyi(2000, 16000);
+    GraphCSR wide;
+    wide.assign(gen.getSize(), gen.getFrom(), gen.getTo(), gen.getWeight());
+    checkRows(wide, 1, 1);
+    checkRows(wide, 4, 30);
+} // end of checkOverflow
+
+int main() {
+    checkOverflow();
+    const int deltas[] = { 0, 1, 3, 20, 1000000 };
+    for (int kind = 0; kind < 3; kind++) {
+        GraphGen gen(kind + 1, kind == 2 ? 1000 : 20);
+        if (kind == 0) gen.rmat(1 << 12, 8 << 12);
+        else if (kind == 1) gen.grid(60, 60);
+        else gen.erdosRenyi(3000, 24000);
+        GraphCSR g;
+        g.assign(gen.getSize(), gen.getFrom(), gen.getTo(), gen.getWeight());
+        for (int d = 0; d < 5; d++) {
+            checkRows(g, 1, deltas[d]);
+            checkRows(g, 4, deltas[d]);
+        }
+        GraphCSR unweighted;
+        unweighted.assign(gen.getSize(), gen.getFrom(), gen.getTo());
+        checkRows(unweighted, 4, 0);
+        checkRows(unweighted, 3, 2);
+    }
+    return finish();
+}
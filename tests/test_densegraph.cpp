@@ -0,0 +1,81 @@
+//---------------------------------------------------------------------------
+// test_densegraph.cpp
+// Tests of densegraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Fills DenseGraphs of bool, unsigned char, unsigned short and int
+// weights, at sizes that give their planes entries of 1, 2 and 4 bytes,
+// and checks every row against Dijkstra: the same distances, visited
+// exactly where a distance is known, and each previous node on an edge
+// that is tight.  On 100 nodes, bool and unsigned char weights must take
+// at most a quarter of the 16 bytes a cell costs in GraphM's C and T.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "densegraph.h"
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "testing.h"
+
+//------------------------------ checkDense ---------------------------------
+// checkDense
+// builds the DenseGraph of an Erdos-Renyi graph and checks its rows
+template <class Weight>
+static void checkDense(int n, int maxWeight, bool small) {
+    GraphGen gen(n, maxWeight);
+    gen.erdosRenyi(n, (long long)n * 4);
+    GraphCSR g;
+    if (maxWeight > 1) {
+        g.assign(n, gen.getFrom(), gen.getTo(), gen.getWeight());
+    }
+    else {
+        g.assign(n, gen.getFrom(), gen.getTo());
+    }
+    DenseGraph<Weight> dense;
+    CHECK(dense.assign(g));
+    dense.findShortestPath();
+
+    // of two edges between the same nodes the matrix keeps the last
+    vector<int> from, to, weight;
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= n; j++) {
+            if (dense.getWeight(i, j) == 0) continue;
+            from.push_back(i);
+            to.push_back(j);
+            weight.push_back(dense.getWeight(i, j));
+        }
+    }
+    GraphCSR kept;
+    kept.assign(n, from, to, weight);
+    Dijkstra dijkstra(kept);
+    vector<TableType> row(n + 1);
+    for (int s = 1; s <= n; s++) {
+        dijkstra.findShortestPath(s, row.data());
+        for (int v = 1; v <= n; v++) {
+            int d = dense.getDist(s, v);
+            CHECK(d == row[v].dist);
+            CHECK(dense.isVisited(s, v) == (d != INT_MAX));
+            if (d == INT_MAX || v == s) continue;
+            int p = dense.getPath(s, v);
+            CHECK(p >= 1 && p <= n && dense.getWeight(p, v) != 0
+                  && dense.getDist(s, p) + dense.getWeight(p, v) == d);
+        }
+    }
+    size_t cells = (size_t)(n + 1) * (n + 1);
+    if (small) CHECK(dense.getBytes() * 4 <= cells * 16);
+} // end of checkDense
+
+int main() {
+    checkDense<bool>(100, 1, true);
+    checkDense<unsigned char>(100, 200, true);
+    checkDense<bool>(700, 1, false);
+    checkDense<unsigned char>(300, 250, false);
+    checkDense<unsigned short>(120, 3000, false);
+    checkDense<int>(150, 100000, false);
+
+    // before findShortestPath nothing is reached
+    DenseGraph<unsigned char> empty;
+    empty.resize(5);
+    CHECK(empty.getDist(1, 2) == INT_MAX && empty.getPath(1, 2) == 0
+          && !empty.isVisited(1, 2));
+    return finish();
+}
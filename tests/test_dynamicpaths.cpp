@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------
+// test_dynamicpaths.cpp
+// Tests of dynamicpaths
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Changes the edges of a DynamicGraph at random, one edge or a batch at a
+// time, repairs the shortest path tree of every source with DynamicPaths
+// and checks each row against a full Dijkstra on the changed graph: the
+// distances are the same and each previous node is on an edge that is
+// tight, so the path it gives is a shortest one.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "dijkstra.h"
+#include "dynamicpaths.h"
+#include "graphgen.h"
+#include "testing.h"
+
+static const int NODES = 60;
+static const int ROUNDS = 400;
+
+//------------------------------- toCSR -------------------------------------
+// toCSR
+// the edges of a DynamicGraph as a weighted GraphCSR
+static void toCSR(const DynamicGraph& dynamic, GraphCSR& g) {
+    vector<int> from, to, weight;
+    for (int v = 1; v <= dynamic.getSize(); v++) {
+        const vector<pair<int, int> >& out = dynamic.outgoing(v);
+        for (size_t e = 0; e < out.size(); e++) {
+            from.push_back(v);
+            to.push_back(out[e].first);
+            weight.push_back(out[e].second);
+        }
+    }
+    g.assign(dynamic.getSize(), from, to, weight);
+} // end of toCSR
+
+int main() {
+    GraphGen gen(12, 20);
+    gen.erdosRenyi(NODES, NODES * 3);
+    GraphCSR start;
+    start.assign(NODES, gen.getFrom(), gen.getTo(), gen.getWeight());
+    DynamicGraph dynamic;
+    dynamic.assign(start);
+    DynamicPaths paths(dynamic);
+
+    vector<vector<TableType> > rows(NODES + 1,
+                                    vector<TableType>(NODES + 1));
+    {
+        Dijkstra dijkstra(start);
+        for (int s = 1; s <= NODES; s++) {
+            dijkstra.findShortestPath(s, rows[s].data());
+        }
+    }
+
+    vector<TableType> row(NODES + 1);
+    for (int round = 0; round < ROUNDS; round++) {
+        // one change, or a batch of up to 30 every third round; a change
+        // adds an edge, makes one lighter or heavier, or removes it
+        int count = round % 3 == 0 ? 1 + (int)randomBelow(30) : 1;
+        vector<EdgeChange> batch;
+        for (int k = 0; k < count; k++) {
+            int a = 1 + (int)randomBelow(NODES);
+            int b = 1 + (int)randomBelow(NODES);
+            int old = dynamic.getWeight(a, b);
+            int weight = 1 + (int)randomBelow(20);
+            if (old != 0 && randomBelow(2) == 0) {
+                weight = randomBelow(2) == 0 ? 0
+                         : max(1, old + (int)randomBelow(7) - 3);
+            }
+            EdgeChange change = { a, b, weight, 0 };
+            change.oldWeight = dynamic.setWeight(a, b, weight);
+            batch.push_back(change);
+        }
+
+        GraphCSR current;
+        toCSR(dynamic, current);
+        Dijkstra dijkstra(current);
+        for (int s = 1; s <= NODES; s++) {
+            paths.update(s, rows[s].data(), batch);
+            dijkstra.findShortestPath(s, row.data());
+            for (int v = 1; v <= NODES; v++) {
+                const TableType& kept = rows[s][v];
+                CHECK(kept.dist == row[v].dist);
+                if (kept.dist != row[v].dist || kept.dist == INT_MAX
+                        || v == s) {
+                    continue;
+                }
+                int p = kept.path;
+                CHECK(p >= 1 && p <= NODES && dynamic.getWeight(p, v) != 0
+                      && rows[s][p].dist + dynamic.getWeight(p, v)
+                             == kept.dist);
+            }
+        }
+    }
+    return finish();
+}
@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------
+// test_floyd.cpp
+// Tests of floyd
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Runs FloydWarshall with each min-plus loop the processor has, forced by
+// setKernel, on sizes that are not multiples of BLOCK, with one thread
+// and with several.  GraphM::findShortestPathFloyd must write the same
+// distances as findShortestPath, and FloydWarshall on larger graphs the
+// same as Dijkstra; a path may differ on a tie, so each previous node is
+// checked to end a shortest path instead.
+//---------------------------------------------------------------------------
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "dijkstra.h"
+#include "floyd.h"
+#include "graphgen.h"
+#include "graphm.h"
+#include "resultwriter.h"
+#include "testing.h"
+
+//------------------------------ makeCost -----------------------------------
+// makeCost
+// the adjacency matrix of a random graph of n nodes, row i at i * (n+1),
+// the last of parallel edges kept as GraphM keeps it
+static vector<int> makeCost(int n, int seed) {
+    GraphGen gen(seed, 50);
+    gen.erdosRenyi(n, n * 3);
+    vector<int> cost((size_t)(n + 1) * (n + 1), 0);
+    for (size_t e = 0; e < gen.getFrom().size(); e++) {
+        cost[(size_t)gen.getFrom()[e] * (n + 1) + gen.getTo()[e]] =
+            gen.getWeight()[e];
+    }
+    return cost;
+} // end of makeCost
+
+//------------------------------ checkRow -----------------------------------
+// checkRow
+// the distances of a row are the expected ones, and each previous node
+// ends a shortest path
+static void checkRow(const vector<int>& cost, int n, int source,
+                     const int dist[], const int path[],
+                     const int expected[]) {
+    for (int j = 1; j <= n; j++) {
+        CHECK(dist[j] == expected[j]);
+        if (j == source || dist[j] == INT_MAX) {
+            CHECK(path[j] == 0);
+            continue;
+        }
+        int p = path[j];
+        CHECK(p >= 1 && p <= n);
+        if (p < 1 || p > n) continue;
+        int c = cost[(size_t)p * (n + 1) + j];
+        CHECK(c != 0 && dist[p] != INT_MAX && dist[p] + c == dist[j]);
+    }
+} // end of checkRow
+
+//----------------------------- tableOf -------------------------------------
+// tableOf
+// the dist and path columns of every source, from writeAll's BINARY form
+// dist of source i is at [i][1 .. n], path at [i][n+1 .. 2n]
+static vector<vector<int> > tableOf(const GraphM& graph, int n) {
+    ostringstream bytes;
+    {
+        ResultWriter out(bytes);
+        graph.writeAll(out, ResultWriter::BINARY);
+        CHECK(out.close());
+    }
+    string got = bytes.str();
+    vector<vector<int> > table(n + 1, vector<int>(2 * n + 1, 0));
+    CHECK(got.size() == 16 + (size_t)n * (4 + 8 * n));
+    if (got.size() != 16 + (size_t)n * (4 + 8 * n)) return table;
+    for (int i = 1; i <= n; i++) {
+        memcpy(&table[i][1], got.data() + 16 + (size_t)(i - 1) * (4 + 8 * n)
+               + 4, 8 * n);
+    }
+    return table;
+} // end of tableOf
+
+//----------------------------- checkGraphM ---------------------------------
+// checkGraphM
+// findShortestPathFloyd against findShortestPath on one graph of n nodes
+static void checkGraphM(int n, int threads) {
+    vector<int> cost = makeCost(n, n);
+    ostringstream data;
+    data << n << '\n';
+    for (int i = 1; i <= n; i++) data << "node " << i << '\n';
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= n; j++) {
+            int c = cost[(size_t)i * (n + 1) + j];
+            if (c != 0) data << i << ' ' << j << ' ' << c << '\n';
+        }
+    }
+    data << "0 0 0\n";
+    istringstream in(data.str());
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+
+    graph->findShortestPath();
+    vector<vector<int> > dijkstra = tableOf(*graph, n);
+    graph->findShortestPathFloyd(threads);
+    vector<vector<int> > floyd = tableOf(*graph, n);
+    for (int i = 1; i <= n; i++) {
+        checkRow(cost, n, i, floyd[i].data(), &floyd[i][n],
+                 dijkstra[i].data());
+    }
+} // end of checkGraphM
+
+//----------------------------- checkLarge ----------------------------------
+// checkLarge
+// FloydWarshall itself against Dijkstra on a graph of n nodes, n past
+// MAXNODES and not a multiple of BLOCK
+static void checkLarge(int n, int threads) {
+    vector<int> cost = makeCost(n, n + 1);
+    vector<int> from, to, weight;
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= n; j++) {
+            int c = cost[(size_t)i * (n + 1) + j];
+            if (c == 0) continue;
+            from.push_back(i);
+            to.push_back(j);
+            weight.push_back(c);
+        }
+    }
+    GraphCSR g;
+    g.assign(n, from, to, weight);
+    Dijkstra dijkstra(g);
+    FloydWarshall floyd(threads);
+    floyd.findShortestPath(n, cost.data(), n + 1);
+    CHECK(floyd.getSize() == n);
+
+    vector<TableType> expected(n + 1), row(n + 1);
+    vector<int> want(n + 1), dist(n + 1), path(n + 1);
+    for (int s = 1; s <= n; s += 7) {
+        dijkstra.findShortestPath(s, expected.data());
+        floyd.fillRow(s, row.data());
+        for (int j = 1; j <= n; j++) {
+            want[j] = expected[j].dist;
+            dist[j] = row[j].dist;
+            path[j] = row[j].path;
+            CHECK(row[j].visited == (row[j].dist != INT_MAX));
+        }
+        checkRow(cost, n, s, dist.data(), path.data(), want.data());
+    }
+} // end of checkLarge
+
+int main() {
+    const char* start = FloydWarshall::getKernelName();
+    const char* kernels[] = { "scalar", "avx2", "avx512" };
+    const int sizes[] = { 2, 63, 65, 100 };
+    for (int k = 0; k < 3; k++) {
+        if (!FloydWarshall::setKernel(kernels[k])) {
+            printf("%s is not supported here, skipped\n", kernels[k]);
+            CHECK(k > 0);
+            continue;
+        }
+        CHECK(strcmp(FloydWarshall::getKernelName(), kernels[k]) == 0);
+        for (int s = 0; s < 4; s++) {
+            checkGraphM(sizes[s], 1);
+            checkGraphM(sizes[s], 4);
+        }
+        checkLarge(130, 1);
+        checkLarge(200, 3);
+    }
+    CHECK(!FloydWarshall::setKernel("sse"));
+    CHECK(FloydWarshall::setKernel(start));
+    CHECK(strcmp(FloydWarshall::getKernelName(), start) == 0);
+    return finish();
+}
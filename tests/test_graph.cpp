@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------
+// test_graph.cpp
+// Tests of graph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that Graph finds GraphM's shortest paths with each layout:
+// ListStorage the same distances, MatrixStorage and FixedStorage the
+// same previous nodes too, on directed and undirected graphs with
+// unreachable nodes, and with weights of one byte.  Also checks the
+// refused edges and sizes, the node information, removeEdge, and, with
+// C++14, a distance worked out by the compiler in a static_assert.
+//---------------------------------------------------------------------------
+#include <climits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "graphgen.h"
+#include "graphm.h"
+#include "testing.h"
+
+#if __cplusplus >= 201402L
+//---------------------------- fixedDistance --------------------------------
+// fixedDistance
+// the distance from 1 to 4 of a small graph with a shorter way round
+constexpr int fixedDistance() {
+    Graph<FixedStorage<4> > g;
+    g.resize(4);
+    g.insertEdge(1, 2, 5);
+    g.insertEdge(2, 4, 5);
+    g.insertEdge(1, 3, 2);
+    g.insertEdge(3, 2, 1);
+    int dist[5] = {};
+    int path[5] = {};
+    g.findShortestPath(1, dist, path);
+    return dist[4] * 10 + path[2];
+}
+static_assert(fixedDistance() == 83, "constexpr search on FixedStorage");
+#endif
+
+//----------------------------- fillGraph -----------------------------------
+// fillGraph
+// inserts the edges of the generator, weights cut to fit in the type
+template <class G>
+static void fillGraph(G& g, const GraphGen& gen) {
+    CHECK(g.resize(gen.getSize()));
+    for (size_t e = 0; e < gen.getFrom().size(); e++) {
+        CHECK(g.insertEdge(gen.getFrom()[e], gen.getTo()[e],
+                           gen.getWeight()[e]));
+    }
+} // end of fillGraph
+
+//---------------------------- buildGraphM ----------------------------------
+// buildGraphM
+// reads the edges of g, both ways of an undirected edge, into an empty
+// GraphM; buildGraph does not clear the edges of an earlier graph
+template <class G>
+static void buildGraphM(GraphM& m, const G& g) {
+    ostringstream data;
+    data << g.getSize() << '\n';
+    for (int i = 1; i <= g.getSize(); i++) data << "node " << i << '\n';
+    for (int i = 1; i <= g.getSize(); i++) {
+        g.forEachEdge(i, [&](int j, int weight) {
+            data << i << ' ' << j << ' ' << weight << '\n';
+        });
+    }
+    data << "0 0 0\n";
+    istringstream in(data.str());
+    m.buildGraph(in);
+} // end of buildGraphM
+
+//---------------------------- checkSearch ----------------------------------
+// checkSearch
+// compares the search from every source with GraphM's, the previous
+// nodes too if samePath
+template <class G>
+static void checkSearch(const G& g, bool samePath) {
+    unique_ptr<GraphM> m(new GraphM);
+    buildGraphM(*m, g);
+    int n = g.getSize();
+    vector<typename G::Distance> dist(n + 1);
+    vector<int> path(n + 1);
+    for (int s = 1; s <= n; s++) {
+        g.findShortestPath(s, dist.data(), path.data());
+        const TableType* row = m->findShortestPathFrom(s);
+        for (int v = 1; v <= n; v++) {
+            bool unreachable = dist[v] == G::infinity();
+            CHECK(unreachable == (row[v].dist == INT_MAX));
+            if (unreachable) {
+                CHECK(path[v] == 0);
+                continue;
+            }
+            CHECK(dist[v] == row[v].dist);
+            if (samePath) CHECK(path[v] == row[v].path);
+        }
+    }
+} // end of checkSearch
+
+//----------------------------- checkLayouts --------------------------------
+// checkLayouts
+// every layout on the same generated graph, directed and undirected
+static void checkLayouts(const GraphGen& gen) {
+    Graph<ListStorage> list;
+    Graph<MatrixStorage> matrix;
+    static Graph<FixedStorage<100> > fixed;
+    fillGraph(list, gen);
+    fillGraph(matrix, gen);
+    fillGraph(fixed, gen);
+    checkSearch(list, false);
+    checkSearch(matrix, true);
+    checkSearch(fixed, true);
+
+    Graph<ListStorage, int, false> listBoth;
+    Graph<MatrixStorage, int, false> matrixBoth;
+    static Graph<FixedStorage<100>, int, false> fixedBoth;
+    fillGraph(listBoth, gen);
+    fillGraph(matrixBoth, gen);
+    fillGraph(fixedBoth, gen);
+    for (int i = 1; i <= gen.getSize(); i++) {
+        for (int j = 1; j <= gen.getSize(); j++) {
+            CHECK(listBoth.getWeight(i, j) == listBoth.getWeight(j, i));
+            CHECK(matrixBoth.getWeight(i, j) == listBoth.getWeight(i, j));
+        }
+    }
+    checkSearch(listBoth, false);
+    checkSearch(matrixBoth, true);
+    checkSearch(fixedBoth, true);
+
+    Graph<MatrixStorage, unsigned char> narrow;
+    fillGraph(narrow, gen);
+    checkSearch(narrow, true);
+} // end of checkLayouts
+
+//------------------------------ checkEdits ---------------------------------
+// checkEdits
+// refused edges and sizes, removeEdge, and the node information
+static void checkEdits() {
+    Graph<FixedStorage<3> > small;
+    CHECK(!small.resize(4) && small.getSize() == 0);
+    CHECK(small.resize(3));
+    CHECK(!small.insertEdge(0, 1, 2) && !small.insertEdge(1, 4, 2));
+    CHECK(!small.insertEdge(1, 2, 0) && !small.insertEdge(1, 2, -3));
+    CHECK(small.insertEdge(1, 2, 4) && small.getWeight(1, 2) == 4);
+    CHECK(small.removeEdge(1, 2) && small.getWeight(1, 2) == 0);
+    CHECK(!small.removeEdge(1, 5));
+
+    Graph<ListStorage, int, false, string> named;
+    named.resize(3);
+    named.setData(2, "second");
+    CHECK(named.getData(2) == "second" && named.getData(1).empty());
+    named.insertEdge(1, 2, 7);
+    named.insertEdge(2, 1, 3);
+    CHECK(named.getWeight(1, 2) == 3 && named.getWeight(2, 1) == 3);
+    named.removeEdge(2, 1);
+    CHECK(named.getWeight(1, 2) == 0 && named.getWeight(2, 1) == 0);
+    CHECK(!named.isDirected() && Graph<ListStorage>::isDirected());
+
+    int dist[4], path[4];
+    named.findShortestPath(0, dist, path);
+    CHECK(dist[1] == Graph<ListStorage>::infinity() && path[1] == 0);
+} // end of checkEdits
+
+int main() {
+    for (int kind = 0; kind < 3; kind++) {
+        GraphGen gen(kind + 1, kind == 2 ? 200 : 20);
+        if (kind == 0) gen.erdosRenyi(100, 300);
+        else if (kind == 1) gen.grid(9, 11, 0.6);
+        else gen.rmat(64, 400);
+        checkLayouts(gen);
+    }
+    checkEdits();
+    return finish();
+}
@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------
+// test_graphl.cpp
+// Tests of graphl
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Builds a GraphL of several thousand nodes, more than the 100 it once
+// held, from a stream and from a GraphLoader, and checks that both give
+// the same displayGraph, that every node and edge is shown, and that
+// depthFirstSearch lists the nodes DepthFirst gives, twice in a row, from
+// two threads at once and again after the graph is built from the other
+// file.
+//---------------------------------------------------------------------------
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "depthfirst.h"
+#include "graphgen.h"
+#include "graphl.h"
+#include "graphloader.h"
+#include "testing.h"
+
+//------------------------------- capture -----------------------------------
+// capture
+// what the given function writes to cout
+template <class Function>
+static string capture(Function function) {
+    ostringstream out;
+    streambuf* old = cout.rdbuf(out.rdbuf());
+    function();
+    cout.rdbuf(old);
+    return out.str();
+} // end of capture
+
+//------------------------------ expected -----------------------------------
+// expected
+// the output of depthFirstSearch for the given graph
+static string expected(const GraphCSR& g) {
+    DepthFirst search(g);
+    const vector<int>& order = search.preorder();
+    ostringstream out;
+    out << "Depth-first ordering:";
+    for (size_t i = 0; i < order.size(); i++) out << "  " << order[i];
+    out << endl << endl;
+    return out.str();
+} // end of expected
+
+int main() {
+    const char* data = "test_graphl.txt";
+    GraphGen gen(3, 1);
+    gen.rmat(5000, 20000);
+    CHECK(gen.write(data, false));
+    GraphGen other(4, 1);
+    other.erdosRenyi(3000, 9000);
+    ostringstream text;
+    other.write(text, false);
+
+    GraphLoader loader;
+    CHECK(loader.load(data, false));
+    GraphCSR g;
+    g.buildGraph(loader);
+    GraphL loaded, streamed;
+    loaded.buildGraph(loader);
+    loader.close();
+    ifstream in(data);
+    streamed.buildGraph(in);
+
+    string shown = capture([&] { loaded.displayGraph(); });
+    CHECK(shown == capture([&] { streamed.displayGraph(); }));
+    CHECK(shown.find("Node5000") != string::npos);
+    size_t edges = 0;
+    for (size_t at = shown.find("  edge "); at != string::npos;
+            at = shown.find("  edge ", at + 1)) {
+        edges++;
+    }
+    CHECK((long long)edges == g.getEdgeCount());
+
+    string order = expected(g);
+    CHECK(capture([&] { loaded.depthFirstSearch(); }) == order);
+    CHECK(capture([&] { loaded.depthFirstSearch(); }) == order);
+
+    // searches from two threads take turns, each printing whole
+    CHECK(capture([&] {
+        thread other([&] { loaded.depthFirstSearch(); });
+        loaded.depthFirstSearch();
+        other.join();
+    }) == order + order);
+
+    // the search graph must follow a new buildGraph
+    istringstream second(text.str());
+    loaded.buildGraph(second);
+    GraphCSR h;
+    h.assign(other.getSize(), other.getFrom(), other.getTo());
+    string shownOther = capture([&] { loaded.displayGraph(); });
+    CHECK(shownOther.find("Node3000") != string::npos);
+    CHECK(shownOther.find("Node3001") == string::npos);
+    CHECK(capture([&] { loaded.depthFirstSearch(); }) == expected(h));
+    remove(data);
+    return finish();
+}
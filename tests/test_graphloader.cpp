@@ -0,0 +1,66 @@
+//---------------------------------------------------------------------------
+// test_graphloader.cpp
+// Tests of graphloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Loads generated data files with one thread and with four, which splits
+// a large file into chunks, and checks the edges against GraphGen.  The
+// same files cut off inside their last edge, with no all-zero edge, must
+// not load, in either format.  The files are made in the directory the
+// test runs in and removed at the end.
+//---------------------------------------------------------------------------
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "graphgen.h"
+#include "graphloader.h"
+#include "testing.h"
+
+//------------------------------ writeFile ----------------------------------
+// writeFile
+// writes the text to the named file
+static void writeFile(const char* name, const string& text) {
+    ofstream out(name, ios::binary);
+    out << text;
+} // end of writeFile
+
+//------------------------------ checkFile ----------------------------------
+// checkFile
+// loads a generated graph whole, then cut inside its last edge
+static void checkFile(int nodes, long long edges, bool weighted) {
+    const char* name = "test_graphloader.txt";
+    GraphGen gen(3, 50);
+    gen.erdosRenyi(nodes, edges);
+    ostringstream out;
+    gen.write(out, weighted);
+    string text = out.str();
+    writeFile(name, text);
+
+    for (int threads = 1; threads <= 4; threads += 3) {
+        GraphLoader loader;
+        CHECK(loader.load(name, weighted, threads));
+        CHECK(loader.getSize() == nodes);
+        CHECK(loader.getFrom() == gen.getFrom());
+        CHECK(loader.getTo() == gen.getTo());
+        if (weighted) CHECK(loader.getWeight() == gen.getWeight());
+    }
+
+    // the text up to the middle of the last edge before the all-zero one
+    size_t zero = text.rfind(weighted ? "0 0 0" : "0 0");
+    size_t lastEdge = text.rfind('\n', zero - 2) + 1;
+    writeFile(name, text.substr(0, lastEdge + 2));
+    for (int threads = 1; threads <= 4; threads += 3) {
+        GraphLoader loader;
+        CHECK(!loader.load(name, weighted, threads));
+    }
+    remove(name);
+} // end of checkFile
+
+int main() {
+    checkFile(100, 400, false);
+    checkFile(100, 400, true);
+    checkFile(50000, 400000, false);
+    checkFile(50000, 400000, true);
+    return finish();
+}
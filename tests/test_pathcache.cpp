@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------
+// test_pathcache.cpp
+// Tests of pathcache
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Runs 3000 random steps of edge insertions, removals, weight changes and
+// queries against a PathCache whose budget holds only a few trees, and a
+// GraphM whose cache is as small.  After every change the trees kept
+// must be exactly those the rules of edgeChanged keep, and every kept
+// tree, like every tree asked for, must equal the one a fresh Dijkstra
+// finds on the graph as it is now.  The memory used stays in the budget.
+//---------------------------------------------------------------------------
+#include <climits>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "dijkstra.h"
+#include "graphm.h"
+#include "pathcache.h"
+#include "testing.h"
+
+static const int NODES = 40;
+static const int STEPS = 3000;
+
+//------------------------------ makeCSR ------------------------------------
+// makeCSR
+// the graph of the weight matrix, edges in order of node as GraphM has
+static void makeCSR(const vector<vector<int> >& weight, GraphCSR& g) {
+    vector<int> from, to, cost;
+    for (int i = 1; i <= NODES; i++) {
+        for (int j = 1; j <= NODES; j++) {
+            if (weight[i][j] == 0) continue;
+            from.push_back(i);
+            to.push_back(j);
+            cost.push_back(weight[i][j]);
+        }
+    }
+    g.assign(NODES, from, to, cost);
+} // end of makeCSR
+
+//------------------------------ sameRow ------------------------------------
+// sameRow
+// whether a tree equals the one a fresh Dijkstra finds
+static bool sameRow(const TableType* row, const GraphCSR& g, int source) {
+    vector<TableType> fresh(NODES + 1);
+    Dijkstra dijkstra(g);
+    dijkstra.findShortestPath(source, fresh.data());
+    for (int v = 0; v <= NODES; v++) {
+        if (row[v].dist != fresh[v].dist || row[v].path != fresh[v].path
+                || row[v].visited != fresh[v].visited) {
+            return false;
+        }
+    }
+    return true;
+} // end of sameRow
+
+//----------------------------- keepsTree -----------------------------------
+// keepsTree
+// whether edgeChanged should keep a tree, by the rules in pathcache.h
+static bool keepsTree(const TableType* row, int from, int to,
+                      int oldWeight, int newWeight) {
+    if (oldWeight == newWeight) return true;
+    bool worse = oldWeight != 0 && (newWeight == 0 || newWeight > oldWeight);
+    bool better = newWeight != 0 && (oldWeight == 0 || newWeight < oldWeight);
+    if (worse && row[to].path == from) return false;
+    return !(better && row[from].dist != INT_MAX
+             && (long long)row[from].dist + newWeight <= row[to].dist);
+} // end of keepsTree
+
+int main() {
+    vector<vector<int> > weight(NODES + 1, vector<int>(NODES + 1, 0));
+    GraphCSR g;
+    makeCSR(weight, g);
+
+    // room for about five trees
+    size_t budget = 5 * ((NODES + 1) * sizeof(TableType) + 96);
+    PathCache cache(budget);
+
+    ostringstream data;
+    data << NODES << '\n';
+    for (int i = 1; i <= NODES; i++) data << "node " << i << '\n';
+    data << "0 0 0\n";
+    istringstream in(data.str());
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    graph->setCacheBudget(budget);
+
+    int kept = 0, dropped = 0, evicted = 0;
+    for (int step = 0; step < STEPS; step++) {
+
+        // a few queries, which fill the cache and evict from it
+        for (int q = 0; q < 3; q++) {
+            int source = 1 + (int)randomBelow(NODES);
+            int before = cache.getTreeCount();
+            CHECK(sameRow(cache.getTree(g, source), g, source));
+            CHECK(sameRow(graph->findShortestPathFrom(source), g, source));
+            CHECK(cache.getMemory() <= budget || cache.getTreeCount() == 1);
+            if (cache.getTreeCount() <= before) evicted++;
+        }
+
+        // an edge inserted, made lighter or heavier, or removed
+        int from = 1 + (int)randomBelow(NODES);
+        int to = 1 + (int)randomBelow(NODES);
+        if (from == to) continue;
+        int oldWeight = weight[from][to];
+        int newWeight = randomBelow(3) == 0 ? 0 : 1 + (int)randomBelow(20);
+
+        vector<vector<TableType> > before(NODES + 1);
+        for (int s = 1; s <= NODES; s++) {
+            if (cache.hasTree(s)) {
+                const TableType* row = cache.getTree(g, s);
+                before[s].assign(row, row + NODES + 1);
+            }
+        }
+        weight[from][to] = newWeight;
+        makeCSR(weight, g);
+        cache.edgeChanged(from, to, oldWeight, newWeight);
+        if (newWeight == 0) graph->removeEdge(from, to);
+        else graph->insertEdge(from, to, newWeight);
+
+        for (int s = 1; s <= NODES; s++) {
+            if (before[s].empty()) {
+                CHECK(!cache.hasTree(s));
+                continue;
+            }
+            bool keep = keepsTree(before[s].data(), from, to, oldWeight,
+                                  newWeight);
+            CHECK(cache.hasTree(s) == keep);
+            if (!cache.hasTree(s)) {
+                dropped++;
+                continue;
+            }
+            kept++;
+            CHECK(sameRow(before[s].data(), g, s));
+        }
+    }
+
+    // every kind of step happened
+    CHECK(kept > 100 && dropped > 100 && evicted > 100);
+    return finish();
+}
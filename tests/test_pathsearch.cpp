@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------
+// test_pathsearch.cpp
+// Tests of pathsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that the bidirectional search, A* with landmarks and A* before
+// buildLandmarks has been run all find Dijkstra's distances, and that a
+// path they give has that length, on R-MAT, grid and Erdos-Renyi graphs.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "pathsearch.h"
+#include "testing.h"
+
+//------------------------------ pathLength ---------------------------------
+// pathLength
+// the sum of the weights along a path, -1 if an edge of it is missing
+static long long pathLength(const GraphCSR& g, const vector<int>& path) {
+    long long length = 0;
+    for (size_t k = 1; k < path.size(); k++) {
+        int best = -1;
+        const int* weight = g.weightBegin(path[k - 1]);
+        for (const int* e = g.edgeBegin(path[k - 1]);
+                e != g.edgeEnd(path[k - 1]); e++) {
+            int w = weight ? weight[e - g.edgeBegin(path[k - 1])] : 1;
+            if (*e == path[k] && (best < 0 || w < best)) best = w;
+        }
+        if (best < 0) return -1;
+        length += best;
+    }
+    return length;
+} // end of pathLength
+
+//------------------------------ checkQuery ---------------------------------
+// checkQuery
+// the distance and path of the last query against Dijkstra's row
+static void checkQuery(const GraphCSR& g, const PathSearch& search,
+                       const vector<int>& path, const TableType& entry) {
+    CHECK(search.getDist() == entry.dist);
+    if (entry.dist == INT_MAX) CHECK(path.empty());
+    else CHECK(pathLength(g, path) == entry.dist);
+} // end of checkQuery
+
+int main() {
+    for (int kind = 0; kind < 3; kind++) {
+        GraphGen gen(kind + 4, 30);
+        if (kind == 0) gen.rmat(1 << 11, 6 << 11);
+        else if (kind == 1) gen.grid(40, 40, 0.7);
+        else gen.erdosRenyi(2000, 6000);
+        GraphCSR g;
+        g.assign(gen.getSize(), gen.getFrom(), gen.getTo(), gen.getWeight());
+        int n = g.getSize();
+
+        Dijkstra dijkstra(g);
+        PathSearch search(g);
+        vector<TableType> row(n + 1);
+        for (int q = 0; q < 40; q++) {
+            int s = 1 + (int)randomBelow(n);
+            int t = 1 + (int)randomBelow(n);
+            dijkstra.findShortestPath(s, row.data());
+            if (q == 20) search.buildLandmarks(4);
+            checkQuery(g, search, search.shortestPath(s, t), row[t]);
+            checkQuery(g, search, search.shortestPathLandmarks(s, t), row[t]);
+        }
+    }
+    return finish();
+}
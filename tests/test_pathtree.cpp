@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+// test_pathtree.cpp
+// Tests of pathtree
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks PathTree against GraphM::display, which prints a path by
+// following T back from the target: for every pair of nodes, the text
+// display prints must be the text made from getPath and getDist, for a
+// target not reached ("----") and for the source itself (a path of one
+// node).  forEachPath must give every reached node but the source once,
+// with the path getPath gives, each path extending its parent's.
+//---------------------------------------------------------------------------
+#include <climits>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "graphgen.h"
+#include "graphm.h"
+#include "pathtree.h"
+#include "testing.h"
+
+//------------------------------- capture -----------------------------------
+// capture
+// what the given function writes to cout
+template <class Function>
+static string capture(Function function) {
+    ostringstream out;
+    streambuf* old = cout.rdbuf(out.rdbuf());
+    function();
+    cout.rdbuf(old);
+    return out.str();
+} // end of capture
+
+//------------------------------ expected -----------------------------------
+// expected
+// the text of display(source, j) made from the tree; node k is named
+// "node k" by the data file
+static string expected(PathTree& tree, int j) {
+    ostringstream out;
+    int i = tree.getSource();
+    if (tree.getDist(j) == INT_MAX) {
+        out << setw(5) << i << setw(10) << j << setw(10) << "----"
+            << "\n\n";
+        return out.str();
+    }
+    PathSlice path = tree.getPath(j);
+    out << setw(5) << i << setw(10) << j << setw(10) << tree.getDist(j);
+    out << setw(13) << path.nodes[0];
+    for (int k = 1; k < path.length; k++) out << " " << path.nodes[k];
+    out << "\n";
+    for (int k = 0; k < path.length - 1; k++) {
+        out << "node " << path.nodes[k] << "\n";
+    }
+    out << "node " << j << "\n\n";
+    return out.str();
+} // end of expected
+
+//----------------------------- checkPaths ----------------------------------
+// checkPaths
+// getPath and forEachPath of the tree of every source of a graph
+static void checkPaths(const GraphGen& gen) {
+    ostringstream data;
+    gen.write(data, true);
+    istringstream in(data.str());
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    graph->findShortestPath();
+    int n = gen.getSize();
+
+    PathTree tree;
+    int unreachable = 0;
+    for (int i = 1; i <= n; i++) {
+        graph->getPathTree(i, tree);
+        CHECK(tree.getSource() == i && tree.getSize() == n);
+        PathSlice self = tree.getPath(i);
+        CHECK(self.length == 1 && self.nodes[0] == i
+              && tree.getDist(i) == 0 && tree.getParent(i) == 0);
+
+        int reached = 0;
+        for (int j = 1; j <= n; j++) {
+            string shown = capture([&]() { graph->display(i, j); });
+            CHECK(shown == expected(tree, j));
+            if (tree.getDist(j) == INT_MAX) {
+                CHECK(tree.getPath(j).length == 0);
+                unreachable++;
+            }
+            else if (j != i) {
+                reached++;
+            }
+        }
+
+        // every path of the pass, as getPath of a second tree gives it
+        PathTree check;
+        graph->getPathTree(i, check);
+        vector<int> seen(n + 1, 0);
+        int visits = 0;
+        tree.forEachPath([&](int v, PathSlice path) {
+            visits++;
+            seen[v]++;
+            PathSlice want = check.getPath(v);
+            bool same = want.length == path.length;
+            for (int k = 0; same && k < path.length; k++) {
+                same = want.nodes[k] == path.nodes[k];
+            }
+            CHECK(same && v != i);
+            CHECK(path.length >= 2
+                  && path.nodes[path.length - 2] == tree.getParent(v));
+        });
+        CHECK(visits == reached);
+        for (int v = 1; v <= n; v++) {
+            CHECK(seen[v] == (v != i && tree.getDist(v) != INT_MAX));
+        }
+    }
+    CHECK(unreachable > 0);
+} // end of checkPaths
+
+int main() {
+    GraphGen sparse(7, 30);
+    sparse.erdosRenyi(70, 110);
+    checkPaths(sparse);
+    GraphGen grid(8, 9);
+    grid.grid(9, 11, 0.6);
+    checkPaths(grid);
+    return finish();
+}
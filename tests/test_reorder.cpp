@@ -0,0 +1,163 @@
+//---------------------------------------------------------------------------
+// test_reorder.cpp
+// Tests of reorder
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// For every method, on R-MAT, grid and Erdos-Renyi graphs, weighted and
+// not, and on graphs of one node and of nodes without edges: checks that
+// the order is a permutation of the nodes and toNew and toOld undo each
+// other; that apply keeps every node's description and edges, in the
+// same order, so the edges are the same multiset in the old numbers; and
+// that Dijkstra on the new graph, with restoreRow, gives the distances
+// of the old graph and previous nodes that end a shortest path.
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <vector>
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "reorder.h"
+#include "testing.h"
+
+// an edge of a graph in the old numbers, to sort and compare
+struct Edge {
+    int from;
+    int to;
+    int weight;
+    bool operator<(const Edge& o) const {
+        if (from != o.from) return from < o.from;
+        if (to != o.to) return to < o.to;
+        return weight < o.weight;
+    }
+    bool operator==(const Edge& o) const {
+        return from == o.from && to == o.to && weight == o.weight;
+    }
+};
+
+//------------------------------ edgesOf ------------------------------------
+// edgesOf
+// the edges of node v of g, numbered back by the given map (or not)
+static vector<Edge> edgesOf(const GraphCSR& g, int v,
+                            const Reorder* back) {
+    vector<Edge> edges;
+    const int* cost = g.weightBegin(v);
+    for (int e = 0; e < g.degree(v); e++) {
+        int w = g.edgeBegin(v)[e];
+        Edge edge = { back ? back->toOld(v) : v, back ? back->toOld(w) : w,
+                      cost ? cost[e] : 1 };
+        edges.push_back(edge);
+    }
+    return edges;
+} // end of edgesOf
+
+//---------------------------- checkMethod ----------------------------------
+// checkMethod
+// one method on one graph
+static void checkMethod(const GraphCSR& g, Reorder::Method method) {
+    int n = g.getSize();
+    Reorder reorder(g);
+    reorder.findOrder(method);
+    CHECK(reorder.getMethod() == method && reorder.getSize() == n);
+
+    // a permutation, and the maps undo each other
+    vector<int> order = reorder.getOrder();
+    CHECK((int)order.size() == n);
+    sort(order.begin(), order.end());
+    for (int i = 1; i <= n && i <= (int)order.size(); i++) {
+        CHECK(order[i - 1] == i);
+        CHECK(reorder.toNew(reorder.toOld(i)) == i);
+        CHECK(reorder.toOld(reorder.toNew(i)) == i);
+        CHECK(reorder.getOrder()[i - 1] == reorder.toOld(i));
+    }
+    if (method == Reorder::ORIGINAL) {
+        for (int i = 1; i <= n; i++) CHECK(reorder.toOld(i) == i);
+    }
+
+    // the same edges, in the same order for each node, and descriptions
+    GraphCSR h;
+    reorder.apply(h);
+    CHECK(h.getSize() == n && h.getEdgeCount() == g.getEdgeCount());
+    CHECK(h.isWeighted() == g.isWeighted());
+    vector<Edge> before, after;
+    for (int i = 1; i <= n; i++) {
+        vector<Edge> mine = edgesOf(h, i, &reorder);
+        CHECK(mine == edgesOf(g, reorder.toOld(i), NULL));
+        CHECK(h.getData(i) == g.getData(reorder.toOld(i)));
+        after.insert(after.end(), mine.begin(), mine.end());
+        vector<Edge> old = edgesOf(g, i, NULL);
+        before.insert(before.end(), old.begin(), old.end());
+    }
+    sort(before.begin(), before.end());
+    sort(after.begin(), after.end());
+    CHECK(before == after);
+
+    // the rows of the new graph, numbered back
+    Dijkstra original(g), reordered(h);
+    vector<TableType> want(n + 1), got(n + 1), row(n + 1);
+    for (int s = 1; s <= n; s += 1 + n / 12) {
+        original.findShortestPath(s, want.data());
+        reordered.findShortestPath(reorder.toNew(s), got.data());
+        reorder.restoreRow(got.data(), row.data());
+        for (int v = 1; v <= n; v++) {
+            CHECK(row[v].dist == want[v].dist);
+            CHECK(row[v].visited == want[v].visited);
+            if (v == s || row[v].dist == INT_MAX) {
+                CHECK(row[v].path == 0);
+                continue;
+            }
+
+            // the previous node has an edge to v that ends the path
+            int p = row[v].path;
+            bool ends = false;
+            vector<Edge> edges = p >= 1 && p <= n
+                ? edgesOf(g, p, NULL) : vector<Edge>();
+            for (size_t e = 0; e < edges.size(); e++) {
+                ends = ends || (edges[e].to == v && want[p].dist != INT_MAX
+                                && want[p].dist + edges[e].weight
+                                   == want[v].dist);
+            }
+            CHECK(ends);
+        }
+    }
+} // end of checkMethod
+
+//----------------------------- checkGraph ----------------------------------
+// checkGraph
+// every method on the graph, with a description per node
+static void checkGraph(GraphCSR& g) {
+    for (int v = 1; v <= g.getSize(); v++) {
+        ostringstream name;
+        name << "node " << v;
+        g.setData(v, NodeData(name.str()));
+    }
+    const Reorder::Method methods[] = { Reorder::ORIGINAL, Reorder::DEGREE,
+                                        Reorder::RCM, Reorder::GORDER };
+    for (int m = 0; m < 4; m++) checkMethod(g, methods[m]);
+} // end of checkGraph
+
+int main() {
+    for (int kind = 0; kind < 3; kind++) {
+        GraphGen gen(kind + 11, 25);
+        if (kind == 0) gen.rmat(1 << 10, 6 << 10);
+        else if (kind == 1) gen.grid(25, 30, 0.7);
+        else gen.erdosRenyi(900, 1200);
+        GraphCSR weighted, unweighted;
+        weighted.assign(gen.getSize(), gen.getFrom(), gen.getTo(),
+                        gen.getWeight());
+        unweighted.assign(gen.getSize(), gen.getFrom(), gen.getTo());
+        checkGraph(weighted);
+        checkGraph(unweighted);
+    }
+
+    // one node, and nodes with no edges but a loop and a parallel pair
+    GraphCSR single;
+    single.assign(1, vector<int>(), vector<int>());
+    checkGraph(single);
+    const int from[] = { 3, 5, 5 };
+    const int to[] = { 3, 2, 2 };
+    GraphCSR sparse;
+    sparse.assign(8, vector<int>(from, from + 3), vector<int>(to, to + 3));
+    checkGraph(sparse);
+    return finish();
+}
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+// test_resultwriter.cpp
+// Tests of resultwriter
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Writes the same output through each place a ResultWriter can write to,
+// an ostream, a file descriptor and a mapped file, and checks that the
+// bytes are the same: a mix of text and numbers that spills the buffer
+// several times, GraphM::writeAll in every format, and raw bytes past
+// the first window of a mapped file.  The BINARY format of writeAll is
+// read back field by field against the layout given in graphm.h.  The
+// files are made in the directory the test runs in and removed at the
+// end.
+//---------------------------------------------------------------------------
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "graphgen.h"
+#include "graphm.h"
+#include "resultwriter.h"
+#include "testing.h"
+
+static const char* FD_FILE = "test_resultwriter_fd.out";
+static const char* OPEN_FILE = "test_resultwriter_open.out";
+static const char* MAP_FILE = "test_resultwriter_map.out";
+
+//----------------------------- readFile ------------------------------------
+// readFile
+// the bytes of a file, empty if it cannot be read
+static string readFile(const char* name) {
+    ifstream in(name, ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+} // end of readFile
+
+//---------------------------- writeEvery -----------------------------------
+// writeEvery
+// gives the function a writer on each place in turn and returns what
+// the stream got; the three files are checked against it
+template <class Function>
+static string writeEvery(Function function) {
+    ostringstream text;
+    {
+        ResultWriter out(text);
+        function(out);
+        CHECK(out.close());
+    }
+    int fd = ::open(FD_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    CHECK(fd >= 0);
+    {
+        ResultWriter out(fd);
+        function(out);
+        CHECK(out.close());
+    }
+    ::close(fd);
+    for (int mapped = 0; mapped < 2; mapped++) {
+        ResultWriter out;
+        CHECK(out.open(mapped ? MAP_FILE : OPEN_FILE, mapped == 1));
+        function(out);
+        CHECK(out.getBytesWritten() == (long long)text.str().size());
+        CHECK(out.close());
+    }
+    CHECK(readFile(FD_FILE) == text.str());
+    CHECK(readFile(OPEN_FILE) == text.str());
+    CHECK(readFile(MAP_FILE) == text.str());
+    return text.str();
+} // end of writeEvery
+
+//--------------------------- checkNumbers ----------------------------------
+// checkNumbers
+// numbers and widths against what the stream library gives
+static void checkNumbers() {
+    const long long values[] = { 0, 7, -7, 99, 100, -100, 123456789,
+                                 -2147483648LL, 2147483647LL,
+                                 -9223372036854775807LL };
+    ostringstream expected;
+    for (int round = 0; round < 30000; round++) {
+        for (int k = 0; k < 10; k++) {
+            expected << values[k] << ' ' << setw(12) << values[k]
+                     << setw(6) << "--" << '\n';
+        }
+    }
+    string got = writeEvery([&](ResultWriter& out) {
+        for (int round = 0; round < 30000; round++) {
+            for (int k = 0; k < 10; k++) {
+                out.putInt(values[k]);
+                out.put(' ');
+                out.putInt(values[k], 12);
+                out.putText("--", 6);
+                out.put('\n');
+            }
+        }
+    });
+    CHECK(got.size() > (1 << 20) * 3 && got == expected.str());
+} // end of checkNumbers
+
+//--------------------------- checkWriteAll ---------------------------------
+// checkWriteAll
+// every format of writeAll on each place, and the BINARY layout
+static void checkWriteAll() {
+    GraphGen gen(17, 30);
+    gen.erdosRenyi(80, 120);
+    ostringstream data;
+    gen.write(data, true);
+    istringstream in(data.str());
+    GraphM graph;
+    graph.buildGraph(in);
+    graph.findShortestPath();
+    const int n = 80;
+
+    string csv = writeEvery([&](ResultWriter& out) {
+        graph.writeAll(out, ResultWriter::CSV);
+    });
+    CHECK(csv.compare(0, 18, "from,to,dist,path\n") == 0);
+    writeEvery([&](ResultWriter& out) {
+        graph.writeAll(out, ResultWriter::TEXT);
+    });
+    string binary = writeEvery([&](ResultWriter& out) {
+        graph.writeAll(out, ResultWriter::BINARY);
+    });
+
+    // "GRAPHRES", version 1, the number of nodes, then for each source
+    // its number, n dist and n previous nodes
+    CHECK(binary.size() == 16 + (size_t)n * (4 + 8 * n));
+    if (binary.size() != 16 + (size_t)n * (4 + 8 * n)) return;
+    CHECK(binary.compare(0, 8, "GRAPHRES") == 0);
+    int header[2];
+    memcpy(header, binary.data() + 8, sizeof(header));
+    CHECK(header[0] == 1 && header[1] == n);
+    const char* at = binary.data() + 16;
+    int unreachable = 0;
+    for (int i = 1; i <= n; i++) {
+        const TableType* row = graph.findShortestPathFrom(i);
+        int source;
+        memcpy(&source, at, 4);
+        CHECK(source == i);
+        vector<int> dist(n), path(n);
+        memcpy(dist.data(), at + 4, 4 * n);
+        memcpy(path.data(), at + 4 + 4 * n, 4 * n);
+        for (int j = 1; j <= n; j++) {
+            CHECK(dist[j - 1] == row[j].dist && path[j - 1] == row[j].path);
+            if (dist[j - 1] == INT_MAX) {
+                CHECK(path[j - 1] == 0);
+                unreachable++;
+            }
+        }
+        at += 4 + 8 * n;
+    }
+    CHECK(unreachable > 0);
+
+    // a CSV row for every pair of different nodes, dist empty if none
+    istringstream lines(csv);
+    string line;
+    getline(lines, line);
+    long long rows = 0;
+    while (getline(lines, line)) {
+        int i = 0, j = 0;
+        char rest[16] = "";
+        sscanf(line.c_str(), "%d,%d,%15[^,]", &i, &j, rest);
+        const TableType* row = graph.findShortestPathFrom(i);
+        if (row[j].dist == INT_MAX) CHECK(line.size() == line.find(",,") + 2);
+        else CHECK(atoi(rest) == row[j].dist);
+        rows++;
+    }
+    CHECK(rows == (long long)n * (n - 1));
+} // end of checkWriteAll
+
+//---------------------------- checkWindows ---------------------------------
+// checkWindows
+// raw bytes across the 64 MiB windows of a mapped file
+static void checkWindows() {
+    vector<char> block(1 << 20);
+    for (size_t k = 0; k < block.size(); k++) block[k] = (char)(k * 131);
+    const int blocks = 66;
+    ResultWriter mapped;
+    CHECK(mapped.open(MAP_FILE, true));
+    ResultWriter plain;
+    CHECK(plain.open(OPEN_FILE));
+    for (int b = 0; b < blocks; b++) {
+        block[0] = (char)b;
+        mapped.put(block.data(), block.size());
+        plain.put(block.data(), block.size());
+    }
+    mapped.put("end");
+    plain.put("end");
+    CHECK(mapped.close() && plain.close());
+    string a = readFile(MAP_FILE);
+    CHECK(a.size() == (size_t)blocks * block.size() + 3);
+    CHECK(a == readFile(OPEN_FILE));
+} // end of checkWindows
+
+int main() {
+    checkNumbers();
+    checkWriteAll();
+    checkWindows();
+    remove(FD_FILE);
+    remove(OPEN_FILE);
+    remove(MAP_FILE);
+    return finish();
+}
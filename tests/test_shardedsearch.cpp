@@ -0,0 +1,58 @@
+//---------------------------------------------------------------------------
+// test_shardedsearch.cpp
+// Tests of partition and shardedsearch
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Splits grid, R-MAT and Erdos-Renyi graphs into 1 to 8 parts and checks
+// that every part has nodes, no part is much larger than its share, and
+// that ShardedSearch gives the same rows as Dijkstra, the paths too, and
+// the same point-to-point distances.
+//---------------------------------------------------------------------------
+#include <vector>
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "partition.h"
+#include "shardedsearch.h"
+#include "testing.h"
+
+int main() {
+    for (int seed = 1; seed <= 40; seed++) {
+        GraphGen gen(seed, seed % 3 == 0 ? 3 : 100);
+        int n = 30 + seed * 37;
+        if (seed % 4 == 0) gen.grid(20, n / 20 + 1, 0.8);
+        else if (seed % 4 == 1) gen.rmat(n, n * 4);
+        else gen.erdosRenyi(n, n * 3);
+        GraphCSR g;
+        g.assign(gen.getSize(), gen.getFrom(), gen.getTo(), gen.getWeight());
+        int size = g.getSize();
+
+        Partition partition(g);
+        partition.split(1 + seed % 8);
+        vector<int> sizes(partition.getCount(), 0);
+        for (int v = 1; v <= size; v++) sizes[partition.getPart(v)]++;
+        int share = (size + partition.getCount() - 1) / partition.getCount();
+        for (size_t p = 0; p < sizes.size(); p++) {
+            CHECK(sizes[p] > 0);
+            CHECK(sizes[p] <= share * 1.03 + 1);
+        }
+
+        ShardedSearch sharded;
+        CHECK(sharded.start(partition));
+        if (!sharded.isRunning()) continue;
+        Dijkstra dijkstra(g);
+        vector<TableType> a(size + 1), b(size + 1);
+        for (int s = 1; s <= size; s += 1 + size / 7) {
+            dijkstra.findShortestPath(s, a.data());
+            CHECK(sharded.findShortestPath(s, b.data()));
+            for (int v = 1; v <= size; v++) {
+                CHECK(a[v].dist == b[v].dist && a[v].path == b[v].path
+                      && a[v].visited == b[v].visited);
+            }
+        }
+        sharded.shortestPath(1, size);
+        dijkstra.findShortestPath(1, a.data());
+        CHECK(sharded.getDist() == a[size].dist);
+        sharded.stop();
+    }
+    return finish();
+}
@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------
+// test_sharedgraph.cpp
+// Tests of sharedgraph
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that insertEdge and removeEdge publish a version each, that in
+// a batch they wait for its end, flush or MAX_PENDING changes, and that
+// readers on several threads, while a writer keeps changing the graph,
+// some changes in batches, find the distances Dijkstra finds on the
+// version they have pinned.
+//---------------------------------------------------------------------------
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "dijkstra.h"
+#include "graphgen.h"
+#include "sharedgraph.h"
+#include "testing.h"
+
+static const int READERS = 4;
+
+//------------------------------ hasEdge ------------------------------------
+// hasEdge
+// whether the current version has the edge from -> to
+static bool hasEdge(SharedGraph& shared, int from, int to) {
+    SharedGraph::Reader reader(shared);
+    SharedGraph::Pin hold(reader);
+    const int* e = hold.graph().edgeBegin(from);
+    bool found = false;
+    for (; e != hold.graph().edgeEnd(from); e++) found = found || *e == to;
+    return found;
+} // end of hasEdge
+
+//------------------------------ checkPublish -------------------------------
+// checkPublish
+// single edge changes are published one at a time, unless in a batch
+static void checkPublish(SharedGraph& shared, int n) {
+    long long first = shared.getVersion();
+    shared.insertEdge(1, n, 1);
+    CHECK(shared.getVersion() == first + 1 && shared.getPendingCount() == 0);
+    CHECK(hasEdge(shared, 1, n));
+    shared.removeEdge(1, n);
+    CHECK(shared.getVersion() == first + 2 && !hasEdge(shared, 1, n));
+    shared.flush();
+    CHECK(shared.getVersion() == first + 2);
+} // end of checkPublish
+
+//------------------------------ checkBatch ---------------------------------
+// checkBatch
+// the changes of a batch are published together
+static void checkBatch(SharedGraph& shared, int n) {
+    long long first = shared.getVersion();
+    shared.beginBatch();
+    shared.insertEdge(1, n, 1);
+    shared.removeEdge(1, n);
+    shared.insertEdge(2, n, 1);
+    CHECK(shared.getVersion() == first && shared.getPendingCount() == 3);
+    CHECK(!hasEdge(shared, 2, n));
+
+    // an inner batch does not publish; flush does, and the batch goes on
+    shared.beginBatch();
+    shared.insertEdge(4, n, 2);
+    shared.endBatch();
+    CHECK(shared.getVersion() == first && shared.getPendingCount() == 4);
+    shared.flush();
+    CHECK(shared.getVersion() == first + 1 && shared.getPendingCount() == 0);
+    CHECK(hasEdge(shared, 2, n) && hasEdge(shared, 4, n));
+    shared.insertEdge(5, n, 2);
+    CHECK(shared.getVersion() == first + 1 && shared.getPendingCount() == 1);
+    shared.endBatch();
+    CHECK(shared.getVersion() == first + 2 && shared.getPendingCount() == 0);
+    CHECK(hasEdge(shared, 5, n));
+
+    // an empty batch publishes nothing; a full one does not wait
+    {
+        SharedGraph::Batch batch(shared);
+    }
+    CHECK(shared.getVersion() == first + 2);
+    {
+        SharedGraph::Batch batch(shared);
+        for (int k = 0; k < SharedGraph::MAX_PENDING; k++) {
+            shared.insertEdge(3, 1 + k % n, 5);
+        }
+        CHECK(shared.getVersion() == first + 3);
+        CHECK(shared.getPendingCount() == 0);
+        shared.removeEdge(3, 1);
+        CHECK(shared.getVersion() == first + 3);
+    }
+    CHECK(shared.getVersion() == first + 4 && !hasEdge(shared, 3, 1));
+
+    // updateEdges publishes at once, with the changes of the batch
+    shared.beginBatch();
+    shared.insertEdge(6, n, 3);
+    EdgeChange change = { 7, n, 3, 0 };
+    shared.updateEdges(vector<EdgeChange>(1, change));
+    CHECK(shared.getVersion() == first + 5 && shared.getPendingCount() == 0);
+    CHECK(hasEdge(shared, 6, n) && hasEdge(shared, 7, n));
+    shared.endBatch();
+    CHECK(shared.getVersion() == first + 5);
+    shared.insertEdge(8, n, 3);
+    CHECK(shared.getVersion() == first + 6);
+} // end of checkBatch
+
+//------------------------------ readPaths ----------------------------------
+// readPaths
+// queries until told to stop, each against Dijkstra on the same version
+static void readPaths(SharedGraph& shared, int n, const atomic<bool>& done,
+                      atomic<int>& wrong, atomic<long long>& queries) {
+    SharedGraph::Reader reader(shared);
+    vector<TableType> row(n + 1);
+    unsigned seed = 12345;
+    while (!done.load()) {
+        seed = seed * 1103515245u + 12345u;
+        int s = 1 + (int)(seed >> 8) % n;
+        int t = 1 + (int)(seed >> 4) % n;
+        SharedGraph::Pin hold(reader);
+        reader.shortestPath(s, t);
+        Dijkstra dijkstra(hold.graph());
+        dijkstra.findShortestPath(s, row.data());
+        if (reader.getDist() != row[t].dist) wrong++;
+        queries++;
+    }
+} // end of readPaths
+
+int main() {
+    const int n = 400;
+    GraphGen gen(31, 20);
+    gen.erdosRenyi(n, n * 4);
+    GraphCSR g;
+    g.assign(n, gen.getFrom(), gen.getTo(), gen.getWeight());
+    SharedGraph shared;
+    shared.assign(g);
+    checkPublish(shared, n);
+    checkBatch(shared, n);
+
+    atomic<bool> done(false);
+    atomic<int> wrong(0);
+    atomic<long long> queries(0);
+    vector<thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.push_back(thread(readPaths, ref(shared), n, cref(done),
+                                 ref(wrong), ref(queries)));
+    }
+    for (int round = 0; round < 300; round++) {
+        int a = 1 + (int)randomBelow(n), b = 1 + (int)randomBelow(n);
+        if (round % 3 == 0) {
+            vector<EdgeChange> batch;
+            for (int k = 0; k < 10; k++) {
+                EdgeChange change = { 1 + (int)randomBelow(n),
+                                      1 + (int)randomBelow(n),
+                                      (int)randomBelow(20), 0 };
+                batch.push_back(change);
+            }
+            shared.updateEdges(batch);
+        }
+        else if (round % 3 == 1) {
+            shared.insertEdge(a, b, 1 + (int)randomBelow(20));
+        }
+        else {
+            shared.removeEdge(a, b);
+        }
+        if (round % 50 == 10) shared.beginBatch();
+        if (round % 50 == 40) shared.endBatch();
+        if (round % 7 == 0) shared.flush();
+    }
+    while (queries.load() < 200) this_thread::yield();
+    done = true;
+    for (size_t r = 0; r < readers.size(); r++) readers[r].join();
+    CHECK(wrong.load() == 0);
+    CHECK(shared.reclaim() == 0);
+    return finish();
+}
@@ -0,0 +1,277 @@
+//---------------------------------------------------------------------------
+// test_stats.cpp
+// Tests of stats
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that snapshot sums the counters of many threads, those that have
+// ended and those still running, keeps the largest of a STATS_MAX counter
+// and counts the calls of each phase; that reset clears them; and that
+// write and writeTrace give JSON that parses, with every counter and
+// phase of the snapshot, and one complete event per sampled timer.  With
+// -DGRAPH_STATS (cmake -DGRAPH_STATS=ON) it also checks the counts the
+// searches of GraphM and GraphCSR make.
+//---------------------------------------------------------------------------
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "depthfirst.h"
+#include "graphgen.h"
+#include "graphm.h"
+#include "stats.h"
+#include "testing.h"
+
+//---------------------------------------------------------------------------
+// A JSON value and a parser of the subset write and writeTrace use:
+// objects, arrays, strings without escapes and numbers.
+
+struct Json {
+    enum Type { NONE, NUMBER, STRING, ARRAY, OBJECT } type;
+    double number;
+    string text;
+    vector<Json> items;
+    map<string, Json> fields;
+    Json() : type(NONE), number(0) {}
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const string& s) : text(s), at(0), failed(false) {}
+
+    // the value of the whole text; NONE if it is not valid
+    Json parse() {
+        Json value = parseValue();
+        skipSpace();
+        if (failed || at != text.size()) return Json();
+        return value;
+    }
+
+private:
+    const string& text;
+    size_t at;
+    bool failed;
+
+    void skipSpace() {
+        while (at < text.size() && isspace((unsigned char)text[at])) at++;
+    }
+
+    bool take(char c) {
+        skipSpace();
+        if (at < text.size() && text[at] == c) {
+            at++;
+            return true;
+        }
+        return false;
+    }
+
+    Json parseValue() {
+        Json value;
+        skipSpace();
+        if (at >= text.size()) {
+            failed = true;
+        }
+        else if (take('{')) {
+            value.type = Json::OBJECT;
+            if (take('}')) return value;
+            do {
+                Json key = parseValue();
+                if (key.type != Json::STRING || !take(':')) failed = true;
+                if (failed) return value;
+                value.fields[key.text] = parseValue();
+            } while (take(','));
+            if (!take('}')) failed = true;
+        }
+        else if (take('[')) {
+            value.type = Json::ARRAY;
+            if (take(']')) return value;
+            do {
+                value.items.push_back(parseValue());
+            } while (!failed && take(','));
+            if (!take(']')) failed = true;
+        }
+        else if (take('"')) {
+            value.type = Json::STRING;
+            size_t end = text.find('"', at);
+            if (end == string::npos) {
+                failed = true;
+                return value;
+            }
+            value.text = text.substr(at, end - at);
+            at = end + 1;
+        }
+        else {
+            const char* begin = text.c_str() + at;
+            char* end = NULL;
+            value.type = Json::NUMBER;
+            value.number = strtod(begin, &end);
+            if (end == begin) failed = true;
+            at += end - begin;
+        }
+        return value;
+    }
+};
+//---------------------------------------------------------------------------
+
+//------------------------------- render ------------------------------------
+// render
+// what a function of Stats writes
+static string render(void (*function)(ResultWriter&)) {
+    ostringstream text;
+    ResultWriter out(text);
+    function(out);
+    CHECK(out.close());
+    return text.str();
+} // end of render
+
+//----------------------------- checkWrite ----------------------------------
+// checkWrite
+// the JSON of write holds the snapshot, every counter and phase by name
+static void checkWrite() {
+    Stats::Snapshot s = Stats::snapshot();
+    Json json = JsonParser(render(Stats::write)).parse();
+    CHECK(json.type == Json::OBJECT && json.fields.size() == 2);
+    const Json& counters = json.fields["counters"];
+    const Json& phases = json.fields["phases"];
+    CHECK(counters.fields.size() == Stats::COUNTERS);
+    CHECK(phases.fields.size() == Stats::PHASES);
+    for (int c = 0; c < Stats::COUNTERS; c++) {
+        map<string, Json>::const_iterator it =
+            counters.fields.find(Stats::counterName((Stats::Counter)c));
+        CHECK(it != counters.fields.end()
+              && it->second.number == (double)s.counter[c]);
+    }
+    for (int p = 0; p < Stats::PHASES; p++) {
+        map<string, Json>::const_iterator it =
+            phases.fields.find(Stats::phaseName((Stats::Phase)p));
+        CHECK(it != phases.fields.end());
+        if (it == phases.fields.end()) continue;
+        map<string, Json> phase = it->second.fields;
+        CHECK(phase.size() == 2 && phase["calls"].number == s.calls[p]);
+        CHECK(phase["ns"].type == Json::NUMBER && phase["ns"].number >= 0);
+    }
+} // end of checkWrite
+
+//----------------------------- checkThreads --------------------------------
+// checkThreads
+// counts of threads that end before the snapshot and of threads that
+// wait for it, each thread counting on its own counters
+static void checkThreads() {
+    const int THREADS = 8, ROUNDS = 20000;
+    Stats::reset();
+    Stats::startTrace(1);
+    atomic<int> counted(0);
+    atomic<bool> release(false);
+    vector<thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.push_back(thread([&, t]() {
+            for (int r = 0; r < ROUNDS; r++) {
+                Stats::add(Stats::NODES_SCANNED, 1);
+                Stats::add(Stats::EDGES_RELAXED, t);
+            }
+            Stats::raise(Stats::DFS_MAX_DEPTH, 100 + t);
+            Stats::raise(Stats::DFS_MAX_DEPTH, 5);
+            for (int k = 0; k <= t; k++) {
+                Stats::Timer timer(Stats::DEPTH_FIRST);
+            }
+            counted++;
+
+            // the odd threads are still running at the snapshot
+            if (t % 2 == 1) {
+                while (!release) this_thread::yield();
+            }
+        }));
+    }
+    while (counted < THREADS) this_thread::yield();
+    for (int t = 0; t < THREADS; t += 2) threads[t].join();
+
+    Stats::Snapshot s = Stats::snapshot();
+    CHECK(s.counter[Stats::NODES_SCANNED] == (long long)THREADS * ROUNDS);
+    CHECK(s.counter[Stats::EDGES_RELAXED]
+          == (long long)ROUNDS * THREADS * (THREADS - 1) / 2);
+    CHECK(s.counter[Stats::DFS_MAX_DEPTH] == 100 + THREADS - 1);
+    CHECK(s.calls[Stats::DEPTH_FIRST] == THREADS * (THREADS + 1) / 2);
+    CHECK(s.nanoseconds[Stats::DEPTH_FIRST] >= 0);
+    checkWrite();
+
+    // one event per timer, each thread's on a tid of its own
+    Json trace = JsonParser(render(Stats::writeTrace)).parse();
+    CHECK(trace.type == Json::OBJECT
+          && trace.fields["displayTimeUnit"].text == "ms");
+    const vector<Json>& events = trace.fields["traceEvents"].items;
+    CHECK((int)events.size() == THREADS * (THREADS + 1) / 2);
+    map<double, int> perThread;
+    for (size_t e = 0; e < events.size(); e++) {
+        map<string, Json> event = events[e].fields;
+        CHECK(event["name"].text == "depth_first" && event["ph"].text == "X");
+        CHECK(event["pid"].number == 1 && event["tid"].number >= 1);
+        CHECK(event["ts"].type == Json::NUMBER && event["ts"].number >= 0);
+        CHECK(event["dur"].type == Json::NUMBER && event["dur"].number >= 0);
+        perThread[event["tid"].number]++;
+    }
+    CHECK((int)perThread.size() == THREADS);
+
+    release = true;
+    for (int t = 1; t < THREADS; t += 2) threads[t].join();
+    CHECK(Stats::snapshot().counter[Stats::NODES_SCANNED]
+          == (long long)THREADS * ROUNDS);
+
+    // reset clears the ended threads too; no trace keeps no events
+    Stats::reset();
+    Stats::startTrace(0);
+    s = Stats::snapshot();
+    for (int c = 0; c < Stats::COUNTERS; c++) CHECK(s.counter[c] == 0);
+    for (int p = 0; p < Stats::PHASES; p++) CHECK(s.calls[p] == 0);
+    {
+        Stats::Timer timer(Stats::DISPLAY);
+    }
+    CHECK(Stats::snapshot().calls[Stats::DISPLAY] == 1);
+    trace = JsonParser(render(Stats::writeTrace)).parse();
+    CHECK(trace.type == Json::OBJECT
+          && trace.fields["traceEvents"].type == Json::ARRAY
+          && trace.fields["traceEvents"].items.empty());
+    checkWrite();
+} // end of checkThreads
+
+//---------------------------- checkSearches --------------------------------
+// checkSearches
+// with GRAPH_STATS, the counts of the searches themselves
+static void checkSearches() {
+    GraphGen gen(2, 20);
+    gen.erdosRenyi(90, 400);
+    ostringstream data;
+    gen.write(data, true);
+    istringstream in(data.str());
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+
+    Stats::reset();
+    graph->findShortestPathParallel(4);
+    Stats::Snapshot s = Stats::snapshot();
+    CHECK(s.counter[Stats::SOURCES_SEARCHED] == 90);
+    CHECK(s.calls[Stats::SOURCE_SEARCH] == 90);
+    CHECK(s.calls[Stats::SHORTEST_PATH] == 1);
+    CHECK(s.counter[Stats::NODES_SCANNED] >= 90);
+    CHECK(s.counter[Stats::EDGES_RELAXED] > 0);
+
+    GraphCSR g;
+    g.assign(gen.getSize(), gen.getFrom(), gen.getTo());
+    Stats::reset();
+    DepthFirst search(g);
+    CHECK(search.preorder().size() == 90);
+    s = Stats::snapshot();
+    CHECK(s.calls[Stats::DEPTH_FIRST] == 1);
+    CHECK(s.counter[Stats::DFS_NODES] == 90);
+    CHECK(s.counter[Stats::DFS_MAX_DEPTH] >= 1);
+} // end of checkSearches
+
+int main() {
+    checkThreads();
+    if (Stats::isEnabled()) checkSearches();
+    else printf("built without GRAPH_STATS, the searches are not counted\n");
+    return finish();
+}
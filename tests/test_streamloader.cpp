@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------
+// test_streamloader.cpp
+// Tests of streamloader
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Writes data files with GraphGen, in both formats, and checks that the
+// snapshot StreamLoader writes is byte for byte the one GraphSnapshot
+// writes from GraphCSR::buildGraph, for a graph that fits in the edge
+// buffer and for one that needs several runs and more than one merge
+// pass at the smallest budget.  A file cut off inside an edge must not
+// load, as it does not for GraphLoader; one cut off between two edges
+// loads the edges before the cut.  The files are made in the directory
+// the test runs in and removed at the end.
+//---------------------------------------------------------------------------
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "graphgen.h"
+#include "graphloader.h"
+#include "snapshot.h"
+#include "streamloader.h"
+#include "testing.h"
+
+//----------------------------- readFile ------------------------------------
+// readFile
+// the bytes of a file, empty if it cannot be read
+static string readFile(const char* name) {
+    ifstream in(name, ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+} // end of readFile
+
+//------------------------------ checkFile ----------------------------------
+// checkFile
+// loads a generated graph both ways and compares the snapshots
+static void checkFile(int nodes, long long edges, bool weighted,
+                      bool runs) {
+    const char* data = "test_streamloader.txt";
+    const char* expected = "test_streamloader_a.snap";
+    const char* streamed = "test_streamloader_b.snap";
+    GraphGen gen(7, 50);
+    gen.erdosRenyi(nodes, edges);
+    CHECK(gen.write(data, weighted));
+
+    GraphLoader loader;
+    CHECK(loader.load(data, weighted));
+    GraphCSR g;
+    g.buildGraph(loader);
+    loader.close();
+    CHECK(GraphSnapshot::write(expected, g));
+
+    StreamLoader stream(StreamLoader::MIN_BUDGET, ".");
+    CHECK(stream.load(data, weighted));
+    CHECK(stream.writeSnapshot(streamed));
+    CHECK(stream.getSize() == g.getSize());
+    CHECK(stream.getEdgeCount() == g.getEdgeCount());
+    if (runs) CHECK(stream.getRunCount() > 1 && stream.getMergePasses() > 0);
+    else CHECK(stream.getRunCount() == 0);
+
+    string a = readFile(expected);
+    CHECK(!a.empty() && a == readFile(streamed));
+    GraphSnapshot snapshot;
+    CHECK(snapshot.open(streamed, true));
+    snapshot.close();
+    remove(data);
+    remove(expected);
+    remove(streamed);
+} // end of checkFile
+
+//---------------------------- checkTruncated -------------------------------
+// checkTruncated
+// a generated file cut inside its last edge, between its numbers, and
+// after it
+static void checkTruncated(bool weighted) {
+    const char* data = "test_streamloader.txt";
+    GraphGen gen(9, 50);
+    gen.erdosRenyi(300, 2000);
+    CHECK(gen.write(data, weighted));
+    string text = readFile(data);
+    size_t zero = text.rfind(weighted ? "\n0 0 0" : "\n0 0");
+    size_t lastEdge = text.rfind('\n', zero - 1) + 1;
+    string edge = text.substr(lastEdge, zero - lastEdge);
+
+    // before and after the space that ends each number but the last
+    size_t cuts[4] = { edge.find(' '), edge.find(' ') + 1, edge.rfind(' '),
+                       edge.rfind(' ') + 1 };
+    for (int c = 0; c < (weighted ? 4 : 2); c++) {
+        ofstream(data, ios::binary) << text.substr(0, lastEdge + cuts[c]);
+        StreamLoader stream(StreamLoader::MIN_BUDGET, ".");
+        CHECK(!stream.load(data, weighted));
+        GraphLoader loader;
+        CHECK(!loader.load(data, weighted));
+    }
+
+    // without the all-zero edge, but after a whole edge
+    ofstream(data, ios::binary) << text.substr(0, zero + 1);
+    StreamLoader stream(StreamLoader::MIN_BUDGET, ".");
+    CHECK(stream.load(data, weighted));
+    CHECK(stream.getEdgeCount() == (long long)gen.getFrom().size());
+    remove(data);
+} // end of checkTruncated
+
+int main() {
+    checkTruncated(true);
+    checkTruncated(false);
+    checkFile(500, 3000, true, false);
+    checkFile(500, 3000, false, false);
+    checkFile(200000, 3000000, true, true);
+    checkFile(200000, 3000000, false, true);
+    return finish();
+}
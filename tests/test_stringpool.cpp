@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------
+// test_stringpool.cpp
+// Tests of stringpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Interns rounds of random strings, each round after a clear, and checks
+// against a map that every distinct text gets the next number once, that
+// get returns its text, and that the strings of earlier rounds are
+// forgotten, as the table grows and when it stays the same size.
+//---------------------------------------------------------------------------
+#include <map>
+#include <string>
+#include "stringpool.h"
+#include "testing.h"
+
+//------------------------------ randomText ---------------------------------
+// randomText
+// a short string of a few letters, so many of them repeat
+static string randomText() {
+    string s(1 + (size_t)randomBelow(4), 'a');
+    for (size_t i = 0; i < s.size(); i++) s[i] = 'a' + randomBelow(6);
+    return s;
+} // end of randomText
+
+//------------------------------ checkRound ---------------------------------
+// checkRound
+// interns the given number of strings into an empty pool
+static void checkRound(StringPool& pool, int strings) {
+    map<string, int> numbers;
+    size_t bytes = 0;
+    bool right = pool.getCount() == 0 && pool.getBytes() == 0;
+    for (int i = 0; i < strings; i++) {
+        string s = randomText();
+        int k = pool.intern(s);
+        if (numbers.count(s) == 0) {
+            right = right && k == (int)numbers.size();
+            numbers[s] = k;
+            bytes += s.size();
+        }
+        right = right && k == numbers[s] && pool.getString(k) == s;
+    }
+    CHECK(right);
+    CHECK(pool.getCount() == (int)numbers.size());
+    CHECK(pool.getBytes() == bytes);
+    map<string, int>::const_iterator it = numbers.begin();
+    for (; it != numbers.end(); it++) {
+        TextSlice slice = pool.get(it->second);
+        right = right && string(slice.text, slice.length) == it->first;
+    }
+    CHECK(right);
+} // end of checkRound
+
+int main() {
+    StringPool pool;
+    checkRound(pool, 10);
+    for (int round = 0; round < 20; round++) {
+        pool.clear();
+        checkRound(pool, round % 2 == 0 ? 50 : 2000);
+    }
+
+    // a cleared pool forgets the text it had
+    pool.clear();
+    CHECK(pool.intern("xyz", 3) == 0);
+    pool.clear();
+    CHECK(pool.intern("abc", 3) == 0 && pool.intern("xyz", 3) == 1);
+    CHECK(pool.getString(0) == "abc" && pool.getCount() == 2);
+    return finish();
+}
@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------
+// test_threadpool.cpp
+// Tests of threadpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// Checks that parallelFor calls the body once for every index with a
+// valid thread number, for ranges shorter and longer than the pool and
+// for uneven work that makes the threads steal; that a body may start
+// loops of its own, on the same pool and on another one, which are done
+// when they return; and that GraphM::findShortestPathParallel writes the
+// same CSV through writeAll as findShortestPath, for 1, 2 and one thread
+// per core.
+//---------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graphgen.h"
+#include "graphm.h"
+#include "resultwriter.h"
+#include "threadpool.h"
+#include "testing.h"
+
+//------------------------------ checkLoop ----------------------------------
+// checkLoop
+// every index of [begin, end) is done once, slower ones near the front
+static void checkLoop(ThreadPool& pool, int begin, int end, int grain) {
+    int n = end > begin ? end - begin : 0;
+    vector<atomic<int> > calls(n);
+    for (int i = 0; i < n; i++) calls[i] = 0;
+    atomic<int> badThread(0);
+    pool.parallelFor(begin, end, [&](int i, int t) {
+        if (t < 0 || t >= pool.getThreadCount()) badThread++;
+        if (i - begin < n / 8) {
+            this_thread::sleep_for(chrono::microseconds(50));
+        }
+        calls[i - begin]++;
+    }, grain);
+    CHECK(badThread == 0);
+    for (int i = 0; i < n; i++) CHECK(calls[i] == 1);
+} // end of checkLoop
+
+//----------------------------- checkNested ---------------------------------
+// checkNested
+// bodies that start loops on their own pool and on another pool; each
+// inner loop is finished when its parallelFor returns
+// the other pool is called by one body at a time, as it requires
+static void checkNested(ThreadPool& pool, ThreadPool& other) {
+    const int OUTER = 40, INNER = 30;
+    vector<atomic<int> > calls(OUTER * INNER * 2);
+    for (size_t k = 0; k < calls.size(); k++) calls[k] = 0;
+    atomic<int> unfinished(0), badThread(0);
+    mutex otherLock;
+    pool.parallelFor(0, OUTER, [&](int i, int t) {
+        atomic<int> done(0);
+        pool.parallelFor(0, INNER, [&](int j, int inner) {
+            if (inner != t) badThread++;
+            calls[i * INNER + j]++;
+            done++;
+        });
+        if (done != INNER) unfinished++;
+
+        atomic<int> otherDone(0);
+        lock_guard<mutex> guard(otherLock);
+        other.parallelFor(0, INNER, [&](int j, int inner) {
+            if (inner < 0 || inner >= other.getThreadCount()) badThread++;
+            calls[(OUTER + i) * INNER + j]++;
+            otherDone++;
+        }, 4);
+        if (otherDone != INNER) unfinished++;
+    });
+    CHECK(unfinished == 0 && badThread == 0);
+    for (size_t k = 0; k < calls.size(); k++) CHECK(calls[k] == 1);
+
+    // the pool still runs plain loops after the nested ones
+    checkLoop(pool, 0, 1000, 3);
+} // end of checkNested
+
+//----------------------------- csvOf ---------------------------------------
+// csvOf
+// every shortest path of T in CSV form
+static string csvOf(const GraphM& graph) {
+    ostringstream text;
+    ResultWriter out(text);
+    graph.writeAll(out, ResultWriter::CSV);
+    CHECK(out.close());
+    return text.str();
+} // end of csvOf
+
+//---------------------------- checkParallel --------------------------------
+// checkParallel
+// the CSV of findShortestPathParallel is the serial one, byte for byte
+static void checkParallel(const GraphGen& gen) {
+    ostringstream data;
+    gen.write(data, true);
+    istringstream in(data.str());
+    unique_ptr<GraphM> graph(new GraphM);
+    graph->buildGraph(in);
+    graph->findShortestPath();
+    string serial = csvOf(*graph);
+    CHECK(serial.size() > 1000);
+
+    const int threads[] = { 1, 2, 0 };
+    for (int k = 0; k < 3; k++) {
+        unique_ptr<GraphM> other(new GraphM);
+        istringstream again(data.str());
+        other->buildGraph(again);
+        other->findShortestPathParallel(threads[k]);
+        CHECK(csvOf(*other) == serial);
+    }
+} // end of checkParallel
+
+int main() {
+    const int sizes[] = { 1, 2, 0, 5 };
+    for (int k = 0; k < 4; k++) {
+        ThreadPool pool(sizes[k]);
+        CHECK(pool.getThreadCount() >= 1);
+        checkLoop(pool, 0, 0, 1);
+        checkLoop(pool, 3, 4, 1);
+        checkLoop(pool, -5, 2, 1);
+        checkLoop(pool, 0, 10000, 1);
+        checkLoop(pool, 7, 5000, 64);
+        ThreadPool other(3);
+        checkNested(pool, other);
+    }
+
+    GraphGen sparse(3, 40);
+    sparse.erdosRenyi(100, 160);
+    checkParallel(sparse);
+    GraphGen grid(4, 9);
+    grid.grid(10, 10);
+    checkParallel(grid);
+    return finish();
+}
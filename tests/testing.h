@@ -0,0 +1,52 @@
+//---------------------------------------------------------------------------
+// testing.h
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// The checks of the tests, which are plain programs run by ctest:
+// CHECK reports a condition that is false, with its file and line, and
+// counts it; main ends with "return finish();", which prints the number
+// of checks and fails the test if any of them failed.  Only the first
+// MAX_REPORTS failures are printed.  randomBelow gives the same numbers
+// on every run, so a failure can be run again.
+//---------------------------------------------------------------------------
+#ifndef TESTING_H
+#define TESTING_H
+#include <cstdio>
+
+namespace testing {
+    static const long long MAX_REPORTS = 20;
+    static long long checks = 0;       // the checks done
+    static long long failures = 0;     // the checks that failed
+    static unsigned long long state = 1;  // of randomBelow
+
+    inline void check(bool ok, const char* what, const char* file,
+                      int line) {
+        checks++;
+        if (ok) return;
+        if (failures++ < MAX_REPORTS) {
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+        }
+    }
+}
+
+#define CHECK(condition) \
+    testing::check((condition), #condition, __FILE__, __LINE__)
+
+//----------------------------- randomBelow ---------------------------------
+// randomBelow
+// a number in 0 .. n-1, by a linear congruential generator
+inline long long randomBelow(long long n) {
+    testing::state = testing::state * 6364136223846793005ULL
+                     + 1442695040888963407ULL;
+    return (long long)((testing::state >> 33) % (unsigned long long)n);
+}
+
+//------------------------------- finish ------------------------------------
+// finish
+// prints the counts; the exit status of the test
+inline int finish() {
+    printf("%lld checks, %lld failed\n", testing::checks, testing::failures);
+    return testing::failures == 0 ? 0 : 1;
+}
+
+#endif
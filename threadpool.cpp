@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------
+// threadpool.cpp
+// Simple class threadpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// threadpool class:  a fixed set of worker threads for parallel loops
+//
+// Assumptions:
+//   -- parallelFor is called by one thread at a time, apart from the
+//      loop bodies of the same pool
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include "threadpool.h"
+
+// the pool whose loop body the thread is running, NULL if none, and the
+// thread number it runs the body as
+static thread_local const ThreadPool* runningPool = NULL;
+static thread_local int runningThread = 0;
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class threadpool
+// the number of threads, 0 uses one thread per core of the machine
+ThreadPool::ThreadPool(int threads) : threadCount(threads) {
+    if (threadCount <= 0) {
+        threadCount = (int)thread::hardware_concurrency();
+    }
+    if (threadCount <= 0) threadCount = 1;
+
+    vector<Range>(threadCount).swap(ranges);
+    for (int t = 1; t < threadCount; t++) {
+        workers.push_back(thread(&ThreadPool::work, this, t));
+    }
+} // end of Constructor
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class threadpool
+// stops and joins the worker threads
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+} // end of Destructor
+
+//---------------------------- parallelFor ----------------------------------
+// parallelFor
+// calls body(i, thread) once for every i in [begin, end)
+void ThreadPool::parallelFor(int begin, int end,
+                             const function<void(int, int)>& f, int chunk) {
+    if (begin >= end) return;
+
+    // called from a body of this pool, whose threads are all in the loop
+    if (runningPool == this) {
+        for (int i = begin; i < end; i++) f(i, runningThread);
+        return;
+    }
+
+    // give each thread an even share of the range
+    long long count = (long long)end - begin;
+    for (int t = 0; t < threadCount; t++) {
+        lock_guard<mutex> guard(ranges[t].lock);
+        ranges[t].next = (int)(begin + count * t / threadCount);
+        ranges[t].end = (int)(begin + count * (t + 1) / threadCount);
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        body = &f;
+        grain = chunk > 0 ? chunk : 1;
+        busy = threadCount - 1;
+        generation++;
+    }
+    wake.notify_all();
+
+    runRanges(0);
+
+    // wait for the workers to finish their part
+    unique_lock<mutex> guard(lock);
+    while (busy > 0) done.wait(guard);
+    body = NULL;
+} // end of parallelFor
+
+//-------------------------- getThreadCount ---------------------------------
+// getThreadCount
+// the number of threads, including the calling thread
+int ThreadPool::getThreadCount() const {
+    return threadCount;
+} // end of getThreadCount
+
+//------------------------------- work --------------------------------------
+// work
+// the loop of a worker thread: wait for a parallelFor, run it, repeat
+void ThreadPool::work(int t) {
+    long long seen = 0;
+    for (;;) {
+        {
+            unique_lock<mutex> guard(lock);
+            while (!stopping && generation == seen) wake.wait(guard);
+            if (stopping) return;
+            seen = generation;
+        }
+
+        runRanges(t);
+
+        lock_guard<mutex> guard(lock);
+        if (--busy == 0) done.notify_one();
+    }
+} // end of work
+
+//---------------------------- runRanges ------------------------------------
+// runRanges
+// runs chunks of the thread's own range, then steals until none is left
+void ThreadPool::runRanges(int t) {
+    Range& mine = ranges[t];
+    const ThreadPool* outerPool = runningPool;
+    int outerThread = runningThread;
+    runningPool = this;
+    runningThread = t;
+    for (;;) {
+        int lo, hi;
+        {
+            lock_guard<mutex> guard(mine.lock);
+            lo = mine.next;
+            hi = min(mine.end, lo + grain);
+            mine.next = hi;
+        }
+        if (lo >= hi) {
+            if (!steal(t)) break;
+            continue;
+        }
+        for (int i = lo; i < hi; i++) {
+            (*body)(i, t);
+        }
+    }
+    runningPool = outerPool;
+    runningThread = outerThread;
+} // end of runRanges
+
+//------------------------------- steal -------------------------------------
+// steal
+// moves the back half of another thread's range into the thread's range
+// returns false when every range is empty
+bool ThreadPool::steal(int t) {
+    for (int k = 1; k < threadCount; k++) {
+        Range& victim = ranges[(t + k) % threadCount];
+        int lo, hi;
+        {
+            lock_guard<mutex> guard(victim.lock);
+            int left = victim.end - victim.next;
+            if (left <= 0) continue;
+            lo = victim.end - (left + 1) / 2;
+            hi = victim.end;
+            victim.end = lo;
+        }
+        lock_guard<mutex> guard(ranges[t].lock);
+        ranges[t].next = lo;
+        ranges[t].end = hi;
+        return true;
+    }
+    return false;
+} // end of steal
@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------
+// threadpool.h
+// Simple class threadpool
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// threadpool class:  a fixed set of worker threads for parallel loops
+//
+// parallelFor splits the index range evenly between the threads.  Each
+// thread takes small chunks from the front of its own range; a thread
+// whose range is used up steals the back half of another thread's range,
+// so uneven work (e.g. sources that reach more of the graph) still keeps
+// every thread busy.  The calling thread works as thread 0.  A loop body
+// may call parallelFor of the same pool: that inner loop runs on the
+// thread of the body, with its thread number, and returns when done.
+//
+// Assumptions:
+//   -- parallelFor is called by one thread at a time, apart from the
+//      loop bodies of the same pool
+//   -- build with -pthread
+//---------------------------------------------------------------------------
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+class ThreadPool {
+public:
+
+//-------------------------- Constructor ------------------------------------
+// Constructor for class threadpool
+// the number of threads, 0 uses one thread per core of the machine
+    explicit ThreadPool(int = 0);
+
+//---------------------------- Destructor -----------------------------------
+// Destructor for class threadpool
+// stops and joins the worker threads
+    ~ThreadPool();
+
+//---------------------------- parallelFor ----------------------------------
+// parallelFor
+// calls body(i, thread) once for every i in [begin, end) and returns
+// when all calls are done; thread is 0 .. getThreadCount()-1 and can index
+// per-thread scratch state; grain is the number of indexes taken at once
+    void parallelFor(int, int, const function<void(int, int)>&, int = 1);
+
+//-------------------------- getThreadCount ---------------------------------
+// getThreadCount
+// the number of threads, including the calling thread
+    int getThreadCount() const;
+
+private:
+    // the part of the index range still to be done by one thread
+    struct Range {
+        mutex lock;
+        int next = 0;
+        int end = 0;
+    };
+
+    int threadCount;                        // the number of threads
+    vector<thread> workers;                 // threads 1 .. threadCount-1
+    vector<Range> ranges;                   // one range per thread
+
+    mutex lock;                             // guards the fields below
+    condition_variable wake;                // a new loop or stopping
+    condition_variable done;                // a worker finished the loop
+    const function<void(int, int)>* body = NULL;
+    int grain = 1;
+    long long generation = 0;               // counts the loops started
+    int busy = 0;                           // workers still in the loop
+    bool stopping = false;
+
+//------------------------------- work --------------------------------------
+// work
+// the loop of a worker thread: wait for a parallelFor, run it, repeat
+    void work(int);
+
+//---------------------------- runRanges ------------------------------------
+// runRanges
+// runs chunks of the thread's own range, then steals until none is left
+    void runRanges(int);
+
+//------------------------------- steal -------------------------------------
+// steal
+// moves the back half of another thread's range into the thread's range
+// returns false when every range is empty
+    bool steal(int);
+};
+#endif
@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------
+// weightmatrix.h
+// Simple class weightmatrix
+// Authors: Hoi Yan Wu
+//---------------------------------------------------------------------------
+// weightmatrix class:  an adjacency matrix whose cells are the given
+//   weight type, so a graph with small weights takes less memory
+//
+// WeightMatrix<unsigned char> and WeightMatrix<unsigned short> keep one
+// byte or two per cell instead of the four of GraphM's int C, and
+// WeightMatrix<bool> keeps one bit per cell for an unweighted graph,
+// where every edge has weight 1.  A weight of 0 means no edge.
+// forEachEdge calls f(node, weight) for the edges of a row in order of
+// node; the bit matrix finds them a word of 64 cells at a time.
+// lowerRow is the relaxation step of Dijkstra's algorithm over one row.
+//
+// Assumptions:
+//   -- nodes are numbered 1 .. size
+//   -- a weight is stored only if fits(weight) is true
+//---------------------------------------------------------------------------
+#ifndef WEIGHTMATRIX_H
+#define WEIGHTMATRIX_H
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <vector>
+using namespace std;
+
+
+template <class Weight>
+class WeightMatrix {
+public:
+    WeightMatrix() : size(0), stride(0) {}
+
+    // no edges between size nodes
+    void resize(int n) {
+        size = n;
+        stride = n + 1;
+        cells.assign(stride * stride, 0);
+    }
+
+    // whether a weight can be stored
+    static bool fits(long long weight) {
+        return weight >= 0
+            && (unsigned long long)weight <= numeric_limits<Weight>::max();
+    }
+
+    Weight get(int i, int j) const {
+        return cells[i * stride + j];
+    }
+
+    void set(int i, int j, long long weight) {
+        cells[i * stride + j] = (Weight)weight;
+    }
+
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        const Weight* row = cells.data() + i * stride;
+        for (int j = 1; j <= size; j++) {
+            if (row[j] != 0) f(j, (int)row[j]);
+        }
+    }
+
+    // for every edge i -> j with base + weight < dist[j], sets dist[j]
+    // and key[j] to it and path[j] to i; a loop without branches, as a
+    // cell of 0 gives INT_MAX, which never lowers anything
+    void lowerRow(int i, int base, int dist[], int key[], int path[]) const {
+        const Weight* row = cells.data() + i * stride;
+        for (int j = 1; j <= size; j++) {
+            long long through = row[j] != 0 ? (long long)base + row[j]
+                                             : (long long)INT_MAX;
+            bool lower = through < dist[j];
+            dist[j] = lower ? (int)through : dist[j];
+            key[j] = lower ? (int)through : key[j];
+            path[j] = lower ? i : path[j];
+        }
+    }
+
+    size_t getBytes() const {
+        return cells.size() * sizeof(Weight);
+    }
+
+private:
+    int size;                          // the number of nodes
+    size_t stride;                     // cells per row
+    vector<Weight> cells;              // row i is cells[i * stride] ..
+};
+
+
+template <>
+class WeightMatrix<bool> {
+public:
+    WeightMatrix() : size(0), words(0) {}
+
+    // no edges between size nodes
+    void resize(int n) {
+        size = n;
+        words = (n + 1) / 64 + 1;
+        bits.assign(words * (n + 1), 0);
+    }
+
+    // any weight is stored as an edge of weight 1
+    static bool fits(long long weight) {
+        return weight >= 0;
+    }
+
+    bool get(int i, int j) const {
+        return (bits[i * words + j / 64] >> (j % 64)) & 1;
+    }
+
+    void set(int i, int j, long long weight) {
+        unsigned long long bit = 1ULL << (j % 64);
+        if (weight != 0) bits[i * words + j / 64] |= bit;
+        else bits[i * words + j / 64] &= ~bit;
+    }
+
+    template <class F>
+    void forEachEdge(int i, F f) const {
+        const unsigned long long* row = bits.data() + i * words;
+        for (size_t w = 0; w < words; w++) {
+            unsigned long long word = row[w];
+            while (word != 0) {
+                f((int)(w * 64) + __builtin_ctzll(word), 1);
+                word &= word - 1;
+            }
+        }
+    }
+
+    // as lowerRow above, every edge lowering to base + 1
+    void lowerRow(int i, int base, int dist[], int key[], int path[]) const {
+        forEachEdge(i, [&](int j, int) {
+            if (base + 1 < dist[j]) {
+                dist[j] = key[j] = base + 1;
+                path[j] = i;
+            }
+        });
+    }
+
+    size_t getBytes() const {
+        return bits.size() * sizeof(unsigned long long);
+    }
+
+private:
+    int size;                          // the number of nodes
+    size_t words;                      // 64-bit words per row
+    vector<unsigned long long> bits;   // row i is bits[i * words] ..
+};
+#endif